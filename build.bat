@@ -16,6 +16,9 @@ if [%toolset%]  == [] set toolset=clang
 if [%CRT%]      == [] set CRT=static
 if [%optimize%] == [] set optimize=release
 if [%arch%]     == [] set arch=64
+if [%simd%]     == [] set simd=sse2
+if [%benchmark%] == [] set benchmark=false
+if [%pack%]     == [] set pack=true
 
 set root=%cd%
 set code=%root%/code
@@ -95,6 +98,11 @@ goto :eof
 	if "%optimize%" == "release" set CC=%CC% -O2    -DBUILD_OPTIMIZE=BUILD_OPTIMIZE_RELEASE -DBUILD_TARGET=BUILD_TARGET_GRAPHICAL
 	if "%arch%" == "32" set CC=%CC% -m32
 	if "%arch%" == "64" set CC=%CC% -m64
+	if "%simd%" == "none" set CC=%CC% -DBUILD_SIMD=BUILD_SIMD_NONE
+	rem @note `sse2` is the x64 baseline, `sse4` and `avx2` narrow the machines the binary runs on
+	if "%simd%" == "sse2" set CC=%CC% -msse2
+	if "%simd%" == "sse4" set CC=%CC% -msse4.1
+	if "%simd%" == "avx2" set CC=%CC% -mavx2 -mf16c
 
 	rem resource compiler flags
 	set RESC=start /d "temp" /b llvm-rc
@@ -119,6 +127,8 @@ goto :eof
 		%CC% "%code%/os_windows.c" -o "os_windows.o"
 		%CC% "%code%/rhi_vulkan.c" -o "rhi_vulkan.o"
 		%CC% "%code%/unknown.c"    -o "unknown.o"
+		if "%benchmark%" == "true" %CC% "%code%/_experiments/benchmark/benchmark.c" -o "benchmark.o"
+		if "%pack%"      == "true" %CC% "%code%/_experiments/packer/packer.c"       -o "packer.o"
 
 		%RESC% "%project%/windows_main.rc" -fo "windows_main.res"
 
@@ -134,5 +144,33 @@ goto :eof
 		"%temp%/rhi_vulkan.o" "%VULKAN_SDK%/Lib/vulkan-1.lib" ^
 		-out:"unknown.exe"
 
+	if "%benchmark%" == "true" call :link_benchmark
+	if "%pack%"      == "true" call :link_packer
+
 	echo.[    complete    ] %time%
 goto :eof
+
+:link_benchmark
+	rem @note reports into the terminal regardless of `optimize`
+	echo.[link  benchmark ] %time%
+	%LD% -subsystem:console ^
+		"%temp%/benchmark.o"  "%temp%/base.o" ^
+		"%temp%/os_windows.o" "%temp%/windows_main.res" ^
+		"%VULKAN_SDK%/Lib/vulkan-1.lib" ^
+		-out:"benchmark.exe"
+goto :eof
+
+:link_packer
+	rem @note bundles the data into "build/data.pack", loose files serve otherwise
+	echo.[link   packer   ] %time%
+	%LD% -subsystem:console ^
+		"%temp%/packer.o"     "%temp%/base.o" ^
+		"%temp%/os_windows.o" "%temp%/windows_main.res" ^
+		"%VULKAN_SDK%/Lib/vulkan-1.lib" ^
+		-out:"packer.exe"
+
+	echo.[ pack data.pack ] %time%
+	start /d "build" /b /wait packer.exe "data.pack" ^
+		"data/shader.vert.spv"    "data/shader.frag.spv" ^
+		"%data%/viking_room.obj"  "%data%/viking_room.png"
+goto :eof
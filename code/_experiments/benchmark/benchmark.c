@@ -0,0 +1,896 @@
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+#include "os.h"
+
+/*
+@note a standalone executable, build with `build.bat benchmark`,
+run from the `build` directory so that `../data` resolves
+*/
+
+// ---- ---- ---- ----
+// utilities
+// ---- ---- ---- ----
+
+#define BENCHMARK_REPEATS 16
+
+AttrFileLocal()
+void benchmark_report(char const * name, u64 nanos, size_t count) {
+	fmt_print(
+		"- %-16s %8.3f ms, %7.2f ns/op\n", name,
+		(f64)nanos / (f64)SecondsToNanos(1.0 / 1000.0),
+		(f64)nanos / (f64)max_size(count, 1)
+	);
+}
+
+// ---- ---- ---- ----
+// parse
+// ---- ---- ---- ----
+
+AttrFileLocal()
+void benchmark_parse(void) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+
+	arr8 const file = base_file_read(scratch, "../data/viking_room.obj");
+	if (file.count == 0) {
+		fmt_print("[benchmark] parse: can't read the model\n");
+		memory_arena_set_position(scratch, scratch_position);
+		return;
+	}
+
+	// -- collect float runs, `v` and `vn` lines go first to be parsed as `vec3` too
+	AttrFuncLocal() char const * const tags[] = {"v ", "vn ", "vt "};
+	size_t lines_count = 0, vec3_lines_count = 0;
+	str8 * lines = MemoryArenaPushArray(scratch, str8, file.count / 4);
+	for (size_t tag_i = 0; tag_i < ArrayCount(tags); tag_i++) {
+		str8 const tag = {.count = strlen(tags[tag_i]), .buffer = (u8 *)tags[tag_i]};
+		for (str8 cursor = {.count = file.count, .buffer = file.buffer}; cursor.count > 0;) {
+			str8 const line = str8_next_line(&cursor);
+			if (line.count < tag.count || !mem_equals(line.buffer, tag.buffer, tag.count)) continue;
+			lines[lines_count++] = (str8){
+				.count  = line.count  - tag.count,
+				.buffer = line.buffer + tag.count,
+			};
+		}
+		if (tag_i == 1) vec3_lines_count = lines_count;
+	}
+
+	size_t const floats_capacity = file.count / 2;
+	f32 * reference = MemoryArenaPushArray(scratch, f32, floats_capacity);
+	f32 * result    = MemoryArenaPushArray(scratch, f32, floats_capacity);
+	vec3 * vectors  = MemoryArenaPushArray(scratch, vec3, vec3_lines_count);
+
+	// -- `strtof` relies on the next line's `\n` or the file's `\0`
+	size_t floats_count = 0;
+	u64 nanos_strtof = UINT64_MAX;
+	for (u32 repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {
+		u64 const nanos_start = os_timer_get_nanos();
+		floats_count = 0;
+		for (size_t i = 0; i < lines_count; i++) {
+			char * it = (char *)lines[i].buffer;
+			char * const end = it + lines[i].count;
+			while (it < end) {
+				char * next;
+				f32 const value = strtof(it, &next);
+				if (next == it) break;
+				reference[floats_count++] = value;
+				it = next;
+			}
+		}
+		nanos_strtof = min_u64(nanos_strtof, os_timer_get_nanos() - nanos_start);
+	}
+
+	size_t result_count = 0;
+	u64 nanos_parse = UINT64_MAX;
+	for (u32 repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {
+		u64 const nanos_start = os_timer_get_nanos();
+		result_count = 0;
+		for (size_t i = 0; i < lines_count; i++) {
+			str8 it = lines[i];
+			for (;;) {
+				it = str8_skip_space(it);
+				if (!str8_parse_f32(&it, result + result_count)) break;
+				result_count++;
+			}
+		}
+		nanos_parse = min_u64(nanos_parse, os_timer_get_nanos() - nanos_start);
+	}
+
+	u64 nanos_vec3 = UINT64_MAX;
+	for (u32 repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {
+		u64 const nanos_start = os_timer_get_nanos();
+		for (size_t i = 0; i < vec3_lines_count; i++) {
+			str8 it = lines[i];
+			str8_parse_vec3(&it, vectors + i, 1);
+		}
+		nanos_vec3 = min_u64(nanos_vec3, os_timer_get_nanos() - nanos_start);
+	}
+
+	// -- results should be bit-identical
+	size_t mismatches = (floats_count != result_count);
+	for (size_t i = 0; i < min_size(floats_count, result_count); i++)
+		mismatches += !mem_equals(reference + i, result + i, sizeof(f32));
+	for (size_t i = 0; i < vec3_lines_count && i * 3 + 2 < floats_count; i++)
+		mismatches += !mem_equals(reference + i * 3, vectors + i, sizeof(vec3));
+
+	fmt_print("[benchmark] parse: %zu floats, %zu mismatches, best of %u\n", floats_count, mismatches, BENCHMARK_REPEATS);
+	benchmark_report("strtof",         nanos_strtof, floats_count);
+	benchmark_report("str8_parse_f32", nanos_parse,  result_count);
+	benchmark_report("str8_parse_vec3", nanos_vec3,  vec3_lines_count * 3);
+
+	memory_arena_set_position(scratch, scratch_position);
+}
+
+// ---- ---- ---- ----
+// math
+// ---- ---- ---- ----
+
+/*
+@note scalar references mirror `base.c` without SIMD,
+vectorized kernels are expected to match them bit for bit
+*/
+
+#define BENCHMARK_MATH_COUNT 4096
+
+AttrFileLocal()
+vec4 reference_mat4_mul_vec(mat4 const * l, vec4 r) { return (vec4){
+	l->x.x * r.x + l->y.x * r.y + l->z.x * r.z + l->w.x * r.w,
+	l->x.y * r.x + l->y.y * r.y + l->z.y * r.z + l->w.y * r.w,
+	l->x.z * r.x + l->y.z * r.y + l->z.z * r.z + l->w.z * r.w,
+	l->x.w * r.x + l->y.w * r.y + l->z.w * r.z + l->w.w * r.w,
+}; }
+
+AttrFileLocal()
+mat4 reference_mat4_mul_mat(mat4 const * l, mat4 const * r) { return (mat4){
+	reference_mat4_mul_vec(l, r->x),
+	reference_mat4_mul_vec(l, r->y),
+	reference_mat4_mul_vec(l, r->z),
+	reference_mat4_mul_vec(l, r->w),
+}; }
+
+AttrFileLocal()
+quat reference_quat_mul(quat l, quat r) { return (quat){
+	 l.x * r.w + l.y * r.z - l.z * r.y + l.w * r.x,
+	-l.x * r.z + l.y * r.w + l.z * r.x + l.w * r.y,
+	 l.x * r.y - l.y * r.x + l.z * r.w + l.w * r.z,
+	-l.x * r.x - l.y * r.y - l.z * r.z + l.w * r.w,
+}; }
+
+AttrFileLocal()
+vec3 reference_quat_transform(quat q, vec3 v) {
+	vec3 const cr = {
+		q.y * v.z - q.z * v.y,
+		q.z * v.x - q.x * v.z,
+		q.x * v.y - q.y * v.x,
+	};
+	return (vec3){
+		v.x + (q.y * cr.z - q.z * cr.y + q.w * cr.x) * 2,
+		v.y + (q.z * cr.x - q.x * cr.z + q.w * cr.y) * 2,
+		v.z + (q.x * cr.y - q.y * cr.x + q.w * cr.z) * 2,
+	};
+}
+
+AttrFileLocal()
+vec3 reference_mat4_transform(mat4 const * m, vec3 v, f32 w) {
+	vec4 const ret = reference_mat4_mul_vec(m, (vec4){v.x, v.y, v.z, w});
+	return (vec3){ret.x, ret.y, ret.z};
+}
+
+AttrFileLocal()
+mat4 reference_mat4_normal(mat4 const * m) {
+	vec3 const a = {m->x.x, m->x.y, m->x.z};
+	vec3 const b = {m->y.x, m->y.y, m->y.z};
+	vec3 const c = {m->z.x, m->z.y, m->z.z};
+	vec3 const bc = vec3_crs(b, c), ca = vec3_crs(c, a), ab = vec3_crs(a, b);
+	f32 const determinant = vec3_dot(a, bc);
+	f32 const scale = determinant != 0 ? 1 / determinant : 1;
+	return (mat4){
+		{bc.x * scale, bc.y * scale, bc.z * scale, 0},
+		{ca.x * scale, ca.y * scale, ca.z * scale, 0},
+		{ab.x * scale, ab.y * scale, ab.z * scale, 0},
+		{0, 0, 0, 1},
+	};
+}
+
+AttrFileLocal()
+vec3 reference_mat4_transform_normal(mat4 const * normal, vec3 v) {
+	vec3 const ret = reference_mat4_transform(normal, v, 0);
+	f32 const length = max_f32(FLT_MIN, sqrt32(ret.x * ret.x + ret.y * ret.y + ret.z * ret.z));
+	return (vec3){ret.x / length, ret.y / length, ret.z / length};
+}
+
+AttrFileLocal()
+mat4 reference_mat4_inverse(mat4 const * m) {
+	vec3 const a = {m->x.x, m->x.y, m->x.z}; f32 const x = m->x.w;
+	vec3 const b = {m->y.x, m->y.y, m->y.z}; f32 const y = m->y.w;
+	vec3 const c = {m->z.x, m->z.y, m->z.z}; f32 const z = m->z.w;
+	vec3 const d = {m->w.x, m->w.y, m->w.z}; f32 const w = m->w.w;
+	vec3 s = vec3_crs(a, b);
+	vec3 t = vec3_crs(c, d);
+	vec3 u = vec3_sub(vec3_muls(a, y), vec3_muls(b, x));
+	vec3 v = vec3_sub(vec3_muls(c, w), vec3_muls(d, z));
+	f32 const determinant = vec3_dot(s, v) + vec3_dot(t, u);
+	f32 const scale = determinant != 0 ? 1 / determinant : 0;
+	s = vec3_muls(s, scale); t = vec3_muls(t, scale);
+	u = vec3_muls(u, scale); v = vec3_muls(v, scale);
+	vec3 const r0 = vec3_add(vec3_crs(b, v), vec3_muls(t, y));
+	vec3 const r1 = vec3_sub(vec3_crs(v, a), vec3_muls(t, x));
+	vec3 const r2 = vec3_add(vec3_crs(d, u), vec3_muls(s, w));
+	vec3 const r3 = vec3_sub(vec3_crs(u, c), vec3_muls(s, z));
+	return (mat4){
+		{r0.x, r1.x, r2.x, r3.x},
+		{r0.y, r1.y, r2.y, r3.y},
+		{r0.z, r1.z, r2.z, r3.z},
+		{-vec3_dot(b, t), vec3_dot(a, t), -vec3_dot(d, s), vec3_dot(c, s)},
+	};
+}
+
+AttrFileLocal()
+mat4 reference_mat4_inverse_affine(mat4 const * m) {
+	vec3 const a = {m->x.x, m->x.y, m->x.z};
+	vec3 const b = {m->y.x, m->y.y, m->y.z};
+	vec3 const c = {m->z.x, m->z.y, m->z.z};
+	vec3 const d = {m->w.x, m->w.y, m->w.z};
+	vec3 r0 = vec3_crs(b, c), r1 = vec3_crs(c, a), r2 = vec3_crs(a, b);
+	f32 const determinant = vec3_dot(a, r0);
+	f32 const scale = determinant != 0 ? 1 / determinant : 0;
+	r0 = vec3_muls(r0, scale); r1 = vec3_muls(r1, scale); r2 = vec3_muls(r2, scale);
+	return (mat4){
+		{r0.x, r1.x, r2.x, 0},
+		{r0.y, r1.y, r2.y, 0},
+		{r0.z, r1.z, r2.z, 0},
+		{-vec3_dot(r0, d), -vec3_dot(r1, d), -vec3_dot(r2, d), 1},
+	};
+}
+
+AttrFileLocal()
+f32 benchmark_random_f32(u32 * state) {
+	// @note xorshift, uniform in `[-1 .. 1)`
+	*state ^= *state << 13; *state ^= *state >> 17; *state ^= *state << 5;
+	return (f32)(*state >> 8) / (f32)(1u << 23) - 1;
+}
+
+// @note runs `statement` for each `i` in `[0 .. count)`, keeps the best of repeats
+#define BENCHMARK_TIME(result, statement)                             \
+/**/do {                                                              \
+/**/    result = UINT64_MAX;                                          \
+/**/    for (u32 repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {  \
+/**/        u64 const nanos_start = os_timer_get_nanos();             \
+/**/        for (u32 i = 0; i < count; i++) { statement; }            \
+/**/        result = min_u64(result, os_timer_get_nanos() - nanos_start); \
+/**/    }                                                             \
+/**/} while (0)                                                       \
+
+// @note runs `statement` once, keeps the best of repeats
+#define BENCHMARK_TIME_BATCH(result, statement)                       \
+/**/do {                                                              \
+/**/    result = UINT64_MAX;                                          \
+/**/    for (u32 repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {  \
+/**/        u64 const nanos_start = os_timer_get_nanos();             \
+/**/        statement;                                                \
+/**/        result = min_u64(result, os_timer_get_nanos() - nanos_start); \
+/**/    }                                                             \
+/**/} while (0)                                                       \
+
+AttrFileLocal()
+void benchmark_math(void) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+
+	u32 const count = BENCHMARK_MATH_COUNT;
+	mat4 * matrices = memory_arena_push(scratch, sizeof(mat4) * count, ALIGN_MAT4);
+	mat4 * affines  = memory_arena_push(scratch, sizeof(mat4) * count, ALIGN_MAT4);
+	quat * quats    = memory_arena_push(scratch, sizeof(quat) * count, ALIGN_VEC4);
+	vec4 * vectors  = memory_arena_push(scratch, sizeof(vec4) * count, ALIGN_VEC4);
+	vec3 * points   = MemoryArenaPushArray(scratch, vec3, count);
+	mat4 * out_mat4 = memory_arena_push(scratch, sizeof(mat4) * count * 2, ALIGN_MAT4);
+	vec4 * out_vec4 = memory_arena_push(scratch, sizeof(vec4) * count * 2, ALIGN_VEC4);
+	vec3 * out_vec3 = MemoryArenaPushArray(scratch, vec3, count * 2);
+	f32  * soa      = MemoryArenaPushArray(scratch, f32,  count * 6);
+	vec3_soa const soa_source = {soa,             soa + count,     soa + count * 2};
+	vec3_soa const soa_target = {soa + count * 3, soa + count * 4, soa + count * 5};
+
+	u32 state = 0x9e3779b9;
+	for (u32 i = 0; i < count * 16; i++)
+		(&matrices->x.x)[i] = benchmark_random_f32(&state);
+	for (u32 i = 0; i < count; i++) {
+		quats[i] = quat_rotation((vec3){
+			benchmark_random_f32(&state) * PI32,
+			benchmark_random_f32(&state) * PI32,
+			benchmark_random_f32(&state) * PI32,
+		});
+		vectors[i] = (vec4){
+			benchmark_random_f32(&state), benchmark_random_f32(&state),
+			benchmark_random_f32(&state), benchmark_random_f32(&state),
+		};
+		points[i] = (vec3){vectors[i].x, vectors[i].y, vectors[i].z};
+		soa_source.x[i] = points[i].x; soa_source.y[i] = points[i].y; soa_source.z[i] = points[i].z;
+		affines[i] = mat4_transformation(points[i], quats[i], (vec3){
+			1.25f + benchmark_random_f32(&state),
+			1.25f + benchmark_random_f32(&state),
+			1.25f + benchmark_random_f32(&state),
+		});
+	}
+
+	u64 nanos_mul_mat[2], nanos_mul_vec[2], nanos_quat_mul[2], nanos_quat_transform[2];
+	u64 nanos_points[3], nanos_directions[3], nanos_normals[3], nanos_inverse[3], nanos_inverse_affine[3];
+	u32 const j = count - 1;
+	size_t mismatches = 0;
+
+	// -- results should be bit-identical
+	BENCHMARK_TIME(nanos_mul_mat[0], out_mat4[i]         = reference_mat4_mul_mat(matrices + i, matrices + (j - i)));
+	BENCHMARK_TIME(nanos_mul_mat[1], out_mat4[count + i] = mat4_mul_mat(matrices[i], matrices[j - i]));
+	mismatches += !mem_equals(out_mat4, out_mat4 + count, sizeof(*out_mat4) * count);
+
+	BENCHMARK_TIME(nanos_mul_vec[0], out_vec4[i]         = reference_mat4_mul_vec(matrices + i, vectors[i]));
+	BENCHMARK_TIME(nanos_mul_vec[1], out_vec4[count + i] = mat4_mul_vec(matrices[i], vectors[i]));
+	mismatches += !mem_equals(out_vec4, out_vec4 + count, sizeof(*out_vec4) * count);
+
+	BENCHMARK_TIME(nanos_quat_mul[0], out_vec4[i]         = reference_quat_mul(quats[i], quats[j - i]));
+	BENCHMARK_TIME(nanos_quat_mul[1], out_vec4[count + i] = quat_mul(quats[i], quats[j - i]));
+	mismatches += !mem_equals(out_vec4, out_vec4 + count, sizeof(*out_vec4) * count);
+
+	BENCHMARK_TIME(nanos_quat_transform[0], out_vec3[i]         = reference_quat_transform(quats[i], points[i]));
+	BENCHMARK_TIME(nanos_quat_transform[1], out_vec3[count + i] = quat_transform(quats[i], points[i]));
+	mismatches += !mem_equals(out_vec3, out_vec3 + count, sizeof(*out_vec3) * count);
+
+	// -- batches should be bit-identical to scalar references
+	mat4 const transform = affines[0];
+	mat4 const normal = reference_mat4_normal(matrices);
+	BENCHMARK_TIME(nanos_points[0], out_vec3[i] = reference_mat4_transform(&transform, points[i], 1));
+	BENCHMARK_TIME_BATCH(nanos_points[1], mat4_transform_points(transform, count, points, sizeof(*points), out_vec3 + count, sizeof(*out_vec3)));
+	BENCHMARK_TIME_BATCH(nanos_points[2], mat4_transform_points_soa(transform, count, soa_source, soa_target));
+	mismatches += !mem_equals(out_vec3, out_vec3 + count, sizeof(*out_vec3) * count);
+	for (u32 i = 0; i < count; i++) mismatches += !mem_equals(out_vec3 + i, (vec3[]){{soa_target.x[i], soa_target.y[i], soa_target.z[i]}}, sizeof(vec3));
+
+	BENCHMARK_TIME(nanos_directions[0], out_vec3[i] = reference_mat4_transform(&transform, points[i], 0));
+	BENCHMARK_TIME_BATCH(nanos_directions[1], mat4_transform_directions(transform, count, points, sizeof(*points), out_vec3 + count, sizeof(*out_vec3)));
+	BENCHMARK_TIME_BATCH(nanos_directions[2], mat4_transform_directions_soa(transform, count, soa_source, soa_target));
+	mismatches += !mem_equals(out_vec3, out_vec3 + count, sizeof(*out_vec3) * count);
+	for (u32 i = 0; i < count; i++) mismatches += !mem_equals(out_vec3 + i, (vec3[]){{soa_target.x[i], soa_target.y[i], soa_target.z[i]}}, sizeof(vec3));
+
+	BENCHMARK_TIME(nanos_normals[0], out_vec3[i] = reference_mat4_transform_normal(&normal, points[i]));
+	BENCHMARK_TIME_BATCH(nanos_normals[1], mat4_transform_normals(matrices[0], count, points, sizeof(*points), out_vec3 + count, sizeof(*out_vec3)));
+	BENCHMARK_TIME_BATCH(nanos_normals[2], mat4_transform_normals_soa(matrices[0], count, soa_source, soa_target));
+	mismatches += !mem_equals(out_vec3, out_vec3 + count, sizeof(*out_vec3) * count);
+	for (u32 i = 0; i < count; i++) mismatches += !mem_equals(out_vec3 + i, (vec3[]){{soa_target.x[i], soa_target.y[i], soa_target.z[i]}}, sizeof(vec3));
+
+	BENCHMARK_TIME(nanos_inverse[0], out_mat4[i]         = reference_mat4_inverse(matrices + i));
+	BENCHMARK_TIME(nanos_inverse[1], out_mat4[count + i] = mat4_inverse(matrices[i]));
+	mismatches += !mem_equals(out_mat4, out_mat4 + count, sizeof(*out_mat4) * count);
+	BENCHMARK_TIME_BATCH(nanos_inverse[2], mat4_inverse_batch(count, matrices, out_mat4 + count));
+	mismatches += !mem_equals(out_mat4, out_mat4 + count, sizeof(*out_mat4) * count);
+
+	BENCHMARK_TIME(nanos_inverse_affine[0], out_mat4[i]         = reference_mat4_inverse_affine(affines + i));
+	BENCHMARK_TIME(nanos_inverse_affine[1], out_mat4[count + i] = mat4_inverse_affine(affines[i]));
+	mismatches += !mem_equals(out_mat4, out_mat4 + count, sizeof(*out_mat4) * count);
+	BENCHMARK_TIME_BATCH(nanos_inverse_affine[2], mat4_inverse_affine_batch(count, affines, out_mat4 + count));
+	mismatches += !mem_equals(out_mat4, out_mat4 + count, sizeof(*out_mat4) * count);
+
+	fmt_print("[benchmark] math: %u ops each, %zu mismatches, best of %u\n", count, mismatches, BENCHMARK_REPEATS);
+	benchmark_report("mat4_mul_mat",   nanos_mul_mat[0],        count);
+	benchmark_report("  simd",         nanos_mul_mat[1],        count);
+	benchmark_report("mat4_mul_vec",   nanos_mul_vec[0],        count);
+	benchmark_report("  simd",         nanos_mul_vec[1],        count);
+	benchmark_report("quat_mul",       nanos_quat_mul[0],       count);
+	benchmark_report("  simd",         nanos_quat_mul[1],       count);
+	benchmark_report("quat_transform", nanos_quat_transform[0], count);
+	benchmark_report("  simd",         nanos_quat_transform[1], count);
+	benchmark_report("points",         nanos_points[0],         count);
+	benchmark_report("  batch",        nanos_points[1],         count);
+	benchmark_report("  batch soa",    nanos_points[2],         count);
+	benchmark_report("directions",     nanos_directions[0],     count);
+	benchmark_report("  batch",        nanos_directions[1],     count);
+	benchmark_report("  batch soa",    nanos_directions[2],     count);
+	benchmark_report("normals",        nanos_normals[0],        count);
+	benchmark_report("  batch",        nanos_normals[1],        count);
+	benchmark_report("  batch soa",    nanos_normals[2],        count);
+	benchmark_report("mat4_inverse",   nanos_inverse[0],        count);
+	benchmark_report("  simd",         nanos_inverse[1],        count);
+	benchmark_report("  batch",        nanos_inverse[2],        count);
+	benchmark_report("inverse_affine", nanos_inverse_affine[0], count);
+	benchmark_report("  simd",         nanos_inverse_affine[1], count);
+	benchmark_report("  batch",        nanos_inverse_affine[2], count);
+
+	memory_arena_set_position(scratch, scratch_position);
+}
+
+// ---- ---- ---- ----
+// transform hierarchy
+// ---- ---- ---- ----
+
+#define BENCHMARK_HIERARCHY_COUNT 65536
+#define BENCHMARK_HIERARCHY_TREES 256
+
+AttrFileLocal()
+void benchmark_hierarchy(void) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+
+	// -- a forest of random trees, interleaved in storage
+	u32 const count = BENCHMARK_HIERARCHY_COUNT;
+	u32 const trees = BENCHMARK_HIERARCHY_TREES;
+	mat4 * reference = memory_arena_push(scratch, sizeof(mat4) * count, ALIGN_MAT4);
+	struct Transform_Hierarchy hierarchy = transform_hierarchy_init();
+	u32 state = 0x9e3779b9;
+	for (u32 i = 0; i < count; i++) {
+		u32 const level = i / trees;
+		u32 const parent = (level > 0)
+			? i - trees * (1 + (state = state * 1664525 + 1013904223) % level)
+			: TRANSFORM_ROOT;
+		vec3 const offset = {benchmark_random_f32(&state), benchmark_random_f32(&state), benchmark_random_f32(&state)};
+		quat const rotation = quat_rotation((vec3){
+			benchmark_random_f32(&state) * PI32,
+			benchmark_random_f32(&state) * PI32,
+			benchmark_random_f32(&state) * PI32,
+		});
+		f32 const scale = 1 + benchmark_random_f32(&state) * 0.125f;
+		transform_hierarchy_push(&hierarchy, parent, offset, rotation, (vec3){scale, scale, scale});
+	}
+
+	u64 nanos_naive, nanos_update, nanos_tree;
+	size_t mismatches = 0;
+
+	// -- results should be bit-identical, dirty roots invalidate whole trees
+	BENCHMARK_TIME(nanos_naive, {
+		u32 const parent = hierarchy.parents[i];
+		mat4 const local = mat4_transformation(hierarchy.offsets[i], hierarchy.rotations[i], hierarchy.scales[i]);
+		reference[i] = (parent != TRANSFORM_ROOT) ? mat4_mul_mat(reference[parent], local) : local;
+	});
+	BENCHMARK_TIME_BATCH(nanos_update, {
+		for (u32 i = 0; i < trees; i++)
+			transform_hierarchy_set(&hierarchy, i, hierarchy.offsets[i], hierarchy.rotations[i], hierarchy.scales[i]);
+		transform_hierarchy_update(&hierarchy);
+	});
+	mismatches += !mem_equals(reference, hierarchy.worlds, sizeof(*reference) * count);
+	BENCHMARK_TIME_BATCH(nanos_tree, {
+		u32 const root = trees - 1;
+		transform_hierarchy_set(&hierarchy, root, hierarchy.offsets[root], hierarchy.rotations[root], hierarchy.scales[root]);
+		transform_hierarchy_update(&hierarchy);
+	});
+	mismatches += !mem_equals(reference, hierarchy.worlds, sizeof(*reference) * count);
+
+	fmt_print("[benchmark] transform hierarchy: %u nodes, %u trees, %u workers, %zu mismatches, best of %u\n",
+		count, trees, workers_get_count(), mismatches, BENCHMARK_REPEATS);
+	benchmark_report("naive",    nanos_naive,  count);
+	benchmark_report("update",   nanos_update, count);
+	benchmark_report("  a tree", nanos_tree,   count / trees);
+
+	transform_hierarchy_free(&hierarchy);
+	memory_arena_set_position(scratch, scratch_position);
+}
+
+// ---- ---- ---- ----
+// fast math
+// ---- ---- ---- ----
+
+#define BENCHMARK_FAST_COUNT 4096
+
+AttrFileLocal()
+f64 benchmark_abs(f64 value) {
+	return value < 0 ? -value : value;
+}
+
+AttrFileLocal()
+void benchmark_fast_math(void) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+
+	u32 const count = BENCHMARK_FAST_COUNT;
+	f32 * angles    = MemoryArenaPushArray(scratch, f32, count);
+	f32 * powers    = MemoryArenaPushArray(scratch, f32, count);
+	f32 * values    = MemoryArenaPushArray(scratch, f32, count);
+	f32 * exponents = MemoryArenaPushArray(scratch, f32, count);
+	f32 * ends      = MemoryArenaPushArray(scratch, f32, count);
+	f32 * factors   = MemoryArenaPushArray(scratch, f32, count);
+	f32 * targets   = MemoryArenaPushArray(scratch, f32, count * 2);
+
+	u32 state = 0x9e3779b9;
+	for (u32 i = 0; i < count; i++) {
+		angles[i] = benchmark_random_f32(&state) * TAU32 * 2;
+		powers[i] = benchmark_random_f32(&state) * 16;
+		values[i] = exp2_32(benchmark_random_f32(&state) * 16);
+		exponents[i] = benchmark_random_f32(&state) * 2;
+		ends[i]    = exp2_32(benchmark_random_f32(&state) * 16);
+		factors[i] = benchmark_random_f32(&state);
+	}
+
+	u64 nanos_sin[3], nanos_exp2[3], nanos_log2[3], nanos_pow[3], nanos_eerp[3];
+	f64 error_sin = 0, error_exp2 = 0, error_log2 = 0, error_pow = 0, error_eerp = 0;
+	size_t mismatches = 0;
+
+	// -- batches should be bit-identical to scalar approximations
+	BENCHMARK_TIME(nanos_sin[0], targets[i] = sin32(angles[i]));
+	BENCHMARK_TIME(nanos_sin[1], targets[i] = sin32_fast(angles[i]));
+	BENCHMARK_TIME_BATCH(nanos_sin[2], sin32_fast_batch(count, angles, targets + count));
+	mismatches += !mem_equals(targets, targets + count, sizeof(*targets) * count);
+	for (u32 i = 0; i < count; i++) error_sin = max_f64(error_sin, benchmark_abs((f64)targets[i] - sin64(angles[i])));
+
+	BENCHMARK_TIME(nanos_exp2[0], targets[i] = exp2_32(powers[i]));
+	BENCHMARK_TIME(nanos_exp2[1], targets[i] = exp2_32_fast(powers[i]));
+	BENCHMARK_TIME_BATCH(nanos_exp2[2], exp2_32_fast_batch(count, powers, targets + count));
+	mismatches += !mem_equals(targets, targets + count, sizeof(*targets) * count);
+	for (u32 i = 0; i < count; i++) error_exp2 = max_f64(error_exp2, benchmark_abs((f64)targets[i] / exp2_64(powers[i]) - 1));
+
+	BENCHMARK_TIME(nanos_log2[0], targets[i] = log2_32(values[i]));
+	BENCHMARK_TIME(nanos_log2[1], targets[i] = log2_32_fast(values[i]));
+	BENCHMARK_TIME_BATCH(nanos_log2[2], log2_32_fast_batch(count, values, targets + count));
+	mismatches += !mem_equals(targets, targets + count, sizeof(*targets) * count);
+	for (u32 i = 0; i < count; i++) error_log2 = max_f64(error_log2, benchmark_abs((f64)targets[i] - log2_64(values[i])));
+
+	BENCHMARK_TIME(nanos_pow[0], targets[i] = pow32(values[i], exponents[i]));
+	BENCHMARK_TIME(nanos_pow[1], targets[i] = pow32_fast(values[i], exponents[i]));
+	BENCHMARK_TIME_BATCH(nanos_pow[2], pow32_fast_batch(count, values, exponents, targets + count));
+	mismatches += !mem_equals(targets, targets + count, sizeof(*targets) * count);
+	for (u32 i = 0; i < count; i++) error_pow = max_f64(error_pow, benchmark_abs((f64)targets[i] / pow64(values[i], exponents[i]) - 1));
+
+	BENCHMARK_TIME(nanos_eerp[0], targets[i] = eerp32(values[i], ends[i], factors[i]));
+	BENCHMARK_TIME(nanos_eerp[1], targets[i] = eerp32_fast(values[i], ends[i], factors[i]));
+	BENCHMARK_TIME_BATCH(nanos_eerp[2], eerp32_fast_batch(count, values, ends, factors, targets + count));
+	mismatches += !mem_equals(targets, targets + count, sizeof(*targets) * count);
+	for (u32 i = 0; i < count; i++) error_eerp = max_f64(error_eerp, benchmark_abs((f64)targets[i] / eerp64(values[i], ends[i], factors[i]) - 1));
+
+	fmt_print("[benchmark] fast math: %u ops each, %zu mismatches, best of %u\n", count, mismatches, BENCHMARK_REPEATS);
+	fmt_print("- errors: sin %.3g, exp2 %.3g (rel), log2 %.3g, pow %.3g (rel), eerp %.3g (rel)\n", error_sin, error_exp2, error_log2, error_pow, error_eerp);
+	benchmark_report("sin",      nanos_sin[0],  count);
+	benchmark_report("  fast",   nanos_sin[1],  count);
+	benchmark_report("  batch",  nanos_sin[2],  count);
+	benchmark_report("exp2",     nanos_exp2[0], count);
+	benchmark_report("  fast",   nanos_exp2[1], count);
+	benchmark_report("  batch",  nanos_exp2[2], count);
+	benchmark_report("log2",     nanos_log2[0], count);
+	benchmark_report("  fast",   nanos_log2[1], count);
+	benchmark_report("  batch",  nanos_log2[2], count);
+	benchmark_report("pow",      nanos_pow[0],  count);
+	benchmark_report("  fast",   nanos_pow[1],  count);
+	benchmark_report("  batch",  nanos_pow[2],  count);
+	benchmark_report("eerp",     nanos_eerp[0], count);
+	benchmark_report("  fast",   nanos_eerp[1], count);
+	benchmark_report("  batch",  nanos_eerp[2], count);
+
+	memory_arena_set_position(scratch, scratch_position);
+}
+
+// ---- ---- ---- ----
+// random
+// ---- ---- ---- ----
+
+#define BENCHMARK_RANDOM_COUNT 65536
+
+AttrFileLocal()
+void benchmark_random(void) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+
+	u32 const count = BENCHMARK_RANDOM_COUNT;
+	u32  * numbers = MemoryArenaPushArray(scratch, u32,  count * 2);
+	f32  * targets = MemoryArenaPushArray(scratch, f32,  count * 2);
+	vec2 * points2 = MemoryArenaPushArray(scratch, vec2, count);
+	vec3 * points3 = MemoryArenaPushArray(scratch, vec3, count);
+
+	struct PCG32 const pcg = pcg32_init(0x853c49e6748fea9bull, 0xda3e39cb94b95bdbull);
+	struct PCG32 pcg_scalar = pcg, pcg_batch = pcg;
+	for (u32 i = 0; i < count; i++) {
+		points2[i] = (vec2){pcg32_next_f32(&pcg_scalar) * 256, pcg32_next_f32(&pcg_scalar) * 256};
+		points3[i] = (vec3){points2[i].x, points2[i].y, pcg32_next_f32(&pcg_scalar) * 256};
+	}
+
+	struct Xoshiro256 xoshiro = xoshiro256_init(0x9e3779b9);
+	struct Xoshiro256_X4 xoshiro_x4 = xoshiro256_x4_init(&xoshiro);
+
+	u64 nanos_pcg[2], nanos_xoshiro[2], nanos_value3[2], nanos_gradient2[2], nanos_gradient3[2];
+	size_t mismatches = 0;
+
+	// -- batches should be bit-identical to scalar calls
+	pcg_scalar = pcg_batch = pcg;
+	BENCHMARK_TIME(nanos_pcg[0], numbers[i] = pcg32_next(&pcg_scalar));
+	BENCHMARK_TIME_BATCH(nanos_pcg[1], pcg32_fill_u32(&pcg_batch, count, numbers + count));
+	mismatches += !mem_equals(numbers, numbers + count, sizeof(*numbers) * count);
+
+	BENCHMARK_TIME(nanos_xoshiro[0], numbers[i] = (u32)xoshiro256_next(&xoshiro));
+	BENCHMARK_TIME_BATCH(nanos_xoshiro[1], xoshiro256_x4_fill_u32(&xoshiro_x4, count, numbers + count));
+
+	BENCHMARK_TIME(nanos_value3[0], targets[i] = noise_value3(1, points3[i]));
+	BENCHMARK_TIME_BATCH(nanos_value3[1], noise_value3_batch(1, count, points3, targets + count));
+	mismatches += !mem_equals(targets, targets + count, sizeof(*targets) * count);
+
+	BENCHMARK_TIME(nanos_gradient2[0], targets[i] = noise_gradient2(1, points2[i]));
+	BENCHMARK_TIME_BATCH(nanos_gradient2[1], noise_gradient2_batch(1, count, points2, targets + count));
+	mismatches += !mem_equals(targets, targets + count, sizeof(*targets) * count);
+
+	BENCHMARK_TIME(nanos_gradient3[0], targets[i] = noise_gradient3(1, points3[i]));
+	BENCHMARK_TIME_BATCH(nanos_gradient3[1], noise_gradient3_batch(1, count, points3, targets + count));
+	mismatches += !mem_equals(targets, targets + count, sizeof(*targets) * count);
+
+	fmt_print("[benchmark] random: %u ops each, %zu mismatches, best of %u\n", count, mismatches, BENCHMARK_REPEATS);
+	benchmark_report("pcg32",          nanos_pcg[0],       count);
+	benchmark_report("  batch",        nanos_pcg[1],       count);
+	benchmark_report("xoshiro256",     nanos_xoshiro[0],   count);
+	benchmark_report("  x4 batch",     nanos_xoshiro[1],   count);
+	benchmark_report("noise_value3",   nanos_value3[0],    count);
+	benchmark_report("  batch",        nanos_value3[1],    count);
+	benchmark_report("noise_gradient2", nanos_gradient2[0], count);
+	benchmark_report("  batch",        nanos_gradient2[1], count);
+	benchmark_report("noise_gradient3", nanos_gradient3[0], count);
+	benchmark_report("  batch",        nanos_gradient3[1], count);
+
+	memory_arena_set_position(scratch, scratch_position);
+}
+
+// ---- ---- ---- ----
+// model
+// ---- ---- ---- ----
+
+#define TINYOBJ_LOADER_C_IMPLEMENTATION
+
+#include "_internal/warnings_push.h"
+# include <tinyobj_loader_c.h>
+#include "_internal/warnings_pop.h"
+
+#define BENCHMARK_MODEL_REPEATS 4
+
+AttrFileLocal()
+void benchmark_model_read_file(void * ctx, const char * filename, int is_mtl, const char * obj_filename, char ** buf, size_t * len) {
+	arr8 const * file = ctx;
+	*buf = (char *)file->buffer;
+	*len = file->count;
+}
+
+// @note a unit grid with every attribute per vertex, made of quads;
+// `relative` interleaves rows of vertices and faces, indexing them backwards
+AttrFileLocal()
+arr8 benchmark_model_generate(u32 side, bool relative) {
+	u32 const row = side + 1;
+	size_t const capacity = (size_t)row * row * 64 + (size_t)side * side * 128 + 1;
+	arr8 ret = {.capacity = capacity, .buffer = os_memory_heap(NULL, capacity)};
+	for (u32 y = 0; y < row; y++) {
+		for (u32 x = 0; x < row; x++) {
+			f64 const u = (f64)x / (f64)side, v = (f64)y / (f64)side;
+			ret.count += fmt_buffer_n((char *)ret.buffer + ret.count, capacity - ret.count,
+				"v %.4f %.4f %.4f\nvt %.4f %.4f\nvn 0 1 0\n", u, 0.0, v, u, v
+			);
+		}
+		if (!relative || y == 0)
+			continue;
+		for (u32 x = 0; x < side; x++) {
+			s32 const a = -(s32)(2 * row - x), b = a + 1, c = -(s32)(row - x) + 1, d = c - 1;
+			ret.count += fmt_buffer_n((char *)ret.buffer + ret.count, capacity - ret.count,
+				"f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, c, c, c, d, d, d
+			);
+		}
+	}
+	for (u32 y = 0; !relative && y < side; y++) {
+		for (u32 x = 0; x < side; x++) {
+			u32 const a = y * row + x + 1, b = a + 1, c = b + row, d = a + row;
+			ret.count += fmt_buffer_n((char *)ret.buffer + ret.count, capacity - ret.count,
+				"f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c, d, d, d
+			);
+		}
+	}
+	ret.buffer[ret.count] = '\0';
+	return ret;
+}
+
+AttrFileLocal()
+void benchmark_model_case(char const * name, arr8 file) {
+	tinyobj_attrib_t attrib;
+	tinyobj_shape_t * shapes = NULL;       size_t shapes_num;
+	tinyobj_material_t * materials = NULL; size_t materials_num;
+	u64 nanos_tinyobj = UINT64_MAX;
+	for (u32 repeat = 0; repeat < BENCHMARK_MODEL_REPEATS; repeat++) {
+		if (repeat > 0) {
+			tinyobj_attrib_free(&attrib);
+			if (shapes) tinyobj_shapes_free(shapes, shapes_num);
+			if (materials) tinyobj_materials_free(materials, materials_num);
+		}
+		u64 const nanos_start = os_timer_get_nanos();
+		tinyobj_parse_obj(&attrib, &shapes, &shapes_num, &materials, &materials_num,
+			name, benchmark_model_read_file, &file, TINYOBJ_FLAG_TRIANGULATE
+		);
+		nanos_tinyobj = min_u64(nanos_tinyobj, os_timer_get_nanos() - nanos_start);
+	}
+
+	struct Resource_Model * model = NULL;
+	u64 nanos_native = UINT64_MAX;
+	for (u32 repeat = 0; repeat < BENCHMARK_MODEL_REPEATS; repeat++) {
+		if (model != NULL) resource_model_free(model);
+		u64 const nanos_start = os_timer_get_nanos();
+		model = resource_model_init_obj(file);
+		nanos_native = min_u64(nanos_native, os_timer_get_nanos() - nanos_start);
+	}
+
+	// -- attributes and corners should be bit-identical
+	size_t mismatches = 0;
+	mismatches += (model->positions_count != attrib.num_vertices)
+		|| !mem_equals(model->positions, attrib.vertices, sizeof(*model->positions) * min_u32(model->positions_count, attrib.num_vertices));
+	mismatches += (model->textures_count != attrib.num_texcoords)
+		|| !mem_equals(model->textures, attrib.texcoords, sizeof(*model->textures) * min_u32(model->textures_count, attrib.num_texcoords));
+	mismatches += (model->normals_count != attrib.num_normals)
+		|| !mem_equals(model->normals, attrib.normals, sizeof(*model->normals) * min_u32(model->normals_count, attrib.num_normals));
+	mismatches += (model->corners_count != attrib.num_faces);
+	for (u32 i = 0; i < min_u32(model->corners_count, attrib.num_faces); i++) {
+		struct RMCorner const it = model->corners[i];
+		mismatches += it.position != attrib.faces[i].v_idx
+			|| it.texture != attrib.faces[i].vt_idx
+			|| it.normal  != attrib.faces[i].vn_idx;
+	}
+
+	fmt_print("[benchmark] model \"%s\": %zu bytes, %u corners, %zu mismatches, best of %u\n",
+		name, file.count, model->corners_count, mismatches, BENCHMARK_MODEL_REPEATS
+	);
+	benchmark_report("tinyobj",        nanos_tinyobj, model->corners_count);
+	benchmark_report("resource_model", nanos_native,  model->corners_count);
+
+	resource_model_free(model);
+	tinyobj_attrib_free(&attrib);
+	if (shapes) tinyobj_shapes_free(shapes, shapes_num);
+	if (materials) tinyobj_materials_free(materials, materials_num);
+}
+
+AttrFileLocal()
+void benchmark_model(void) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+
+	arr8 const file = base_file_read(scratch, "../data/viking_room.obj");
+	if (file.count == 0)
+		fmt_print("[benchmark] model: can't read the model\n");
+	else
+		benchmark_model_case("viking_room.obj", file);
+
+	AttrFuncLocal() struct {
+		char const * name;
+		u32 side;
+		bool relative;
+	} const synthetic[] = {
+		{"grid 256",           256, false},
+		{"grid 1024",         1024, false},
+		{"grid 1024 relative", 1024, true},
+	};
+	for (size_t i = 0; i < ArrayCount(synthetic); i++) {
+		arr8 const grid = benchmark_model_generate(synthetic[i].side, synthetic[i].relative);
+		benchmark_model_case(synthetic[i].name, grid);
+		os_memory_heap(grid.buffer, 0);
+	}
+
+	memory_arena_set_position(scratch, scratch_position);
+}
+
+// ---- ---- ---- ----
+// bvh
+// ---- ---- ---- ----
+
+#define BENCHMARK_BVH_RAYS 1024
+
+AttrFileLocal()
+bool reference_ray_triangle(ray3 ray, vec3 a, vec3 b, vec3 c, f32 * distance) {
+	vec3 const e1 = vec3_sub(b, a), e2 = vec3_sub(c, a), d = ray.direction;
+	f32 const px = d.y * e2.z - d.z * e2.y;
+	f32 const py = d.z * e2.x - d.x * e2.z;
+	f32 const pz = d.x * e2.y - d.y * e2.x;
+	f32 const reverse = 1 / (e1.x * px + e1.y * py + e1.z * pz);
+	f32 const tx = ray.origin.x - a.x, ty = ray.origin.y - a.y, tz = ray.origin.z - a.z;
+	f32 const u = (tx * px + ty * py + tz * pz) * reverse;
+	f32 const qx = ty * e1.z - tz * e1.y;
+	f32 const qy = tz * e1.x - tx * e1.z;
+	f32 const qz = tx * e1.y - ty * e1.x;
+	f32 const v = (d.x * qx + d.y * qy + d.z * qz) * reverse;
+	f32 const t = (e2.x * qx + e2.y * qy + e2.z * qz) * reverse;
+	if (!(u >= 0 && v >= 0 && 1 >= u + v && t > 0 && *distance > t)) return false;
+	*distance = t;
+	return true;
+}
+
+AttrFileLocal()
+void benchmark_bvh(void) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+
+	struct RMVertex * vertices; u32 vertices_count;
+	void           * indices;  u32 indices_count; u32 index_size;
+	struct Resource_Model * model = resource_model_init("../data/viking_room.obj");
+	resource_model_dump_vertices(model, scratch, &vertices, &vertices_count, &indices, &indices_count, &index_size);
+	resource_model_free(model);
+	if (indices_count == 0) {
+		fmt_print("[benchmark] bvh: can't read the model\n");
+		memory_arena_set_position(scratch, scratch_position);
+		return;
+	}
+
+	struct BVH_IInfo const bvh_iinfo = {
+		.positions = &vertices->position,
+		.stride = sizeof(*vertices),
+		.indices_count = indices_count,
+		.index_size = index_size,
+		.indices = indices,
+	};
+	struct BVH bvh = {0};
+	u64 nanos_build = UINT64_MAX;
+	for (u32 repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {
+		bvh_free(&bvh);
+		u64 const nanos_start = os_timer_get_nanos();
+		bvh = bvh_init(bvh_iinfo);
+		nanos_build = min_u64(nanos_build, os_timer_get_nanos() - nanos_start);
+	}
+
+	// -- rays from around the bounding sphere, aimed at points inside it
+	u32 const count = BENCHMARK_BVH_RAYS;
+	ray3 * rays = MemoryArenaPushArray(scratch, ray3, count);
+	f32 * distances = MemoryArenaPushArray(scratch, f32, count * 2);
+	sphere3 const sphere = sphere3_from_points(vertices_count, &vertices->position, sizeof(*vertices));
+	u32 state = 0x9e3779b9;
+	for (u32 i = 0; i < count; i++) {
+		vec3 const from = {benchmark_random_f32(&state), benchmark_random_f32(&state), benchmark_random_f32(&state)};
+		vec3 const to   = {benchmark_random_f32(&state), benchmark_random_f32(&state), benchmark_random_f32(&state)};
+		rays[i].origin = vec3_add(sphere.center, vec3_muls(from, sphere.radius * 2));
+		rays[i].direction = vec3_sub(vec3_add(sphere.center, vec3_muls(to, sphere.radius * 0.5f)), rays[i].origin);
+	}
+
+	u32 * corners = MemoryArenaPushArray(scratch, u32, indices_count);
+	for (u32 i = 0; i < indices_count; i++)
+		corners[i] = (index_size == sizeof(u32)) ? ((u32 *)indices)[i] : ((u16 *)indices)[i];
+
+	u64 nanos_linear, nanos_raycast, nanos_occluded;
+	u32 const triangles_count = indices_count / 3;
+	size_t hits = 0, mismatches = 0;
+
+	// -- closest hits should be bit-identical
+	BENCHMARK_TIME(nanos_linear, {
+		distances[i] = INF32;
+		for (u32 t = 0; t < triangles_count; t++) {
+			reference_ray_triangle(rays[i],
+				vertices[corners[t * 3 + 0]].position,
+				vertices[corners[t * 3 + 1]].position,
+				vertices[corners[t * 3 + 2]].position,
+				distances + i
+			);
+		}
+	});
+	BENCHMARK_TIME(nanos_raycast, {
+		struct BVH_Hit hit;
+		distances[count + i] = bvh_raycast(&bvh, rays[i], INF32, &hit) ? hit.distance : INF32;
+	});
+	BENCHMARK_TIME(nanos_occluded, hits += bvh_occluded(&bvh, rays[i], INF32));
+	mismatches += !mem_equals(distances, distances + count, sizeof(*distances) * count);
+	hits /= BENCHMARK_REPEATS;
+
+	fmt_print("[benchmark] bvh: %u triangles, %u nodes, %zu / %u hits, %zu mismatches, best of %u\n",
+		triangles_count, bvh.nodes_count, hits, count, mismatches, BENCHMARK_REPEATS
+	);
+	benchmark_report("bvh_init",     nanos_build,    triangles_count);
+	benchmark_report("linear scan",  nanos_linear,   count);
+	benchmark_report("bvh_raycast",  nanos_raycast,  count);
+	benchmark_report("bvh_occluded", nanos_occluded, count);
+
+	bvh_free(&bvh);
+	memory_arena_set_position(scratch, scratch_position);
+}
+
+// ---- ---- ---- ----
+// entry
+// ---- ---- ---- ----
+
+int main(int argc, char * argv[]) {
+	os_init((struct OS_IInfo){
+		.window_size_x = 320,
+		.window_size_y = 240,
+		.window_caption = "benchmark",
+	});
+	thread_ctx_init();
+	workers_init();
+
+	benchmark_parse();
+	benchmark_math();
+	benchmark_hierarchy();
+	benchmark_fast_math();
+	benchmark_random();
+	benchmark_model();
+	benchmark_bvh();
+
+	workers_free();
+	thread_ctx_free();
+	os_free();
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include "os.h"
+
+/*
+@note a standalone executable, build with `build.bat pack`;
+usage: `packer.exe <archive> <file>...`, entries are named after the files
+*/
+
+AttrFileLocal()
+char const * packer_get_name(char const * path) {
+	char const * ret = path;
+	for (char const * it = path; *it != '\0'; it++)
+		if (*it == '/' || *it == '\\')
+			ret = it + 1;
+	return ret;
+}
+
+int main(int argc, char * argv[]) {
+	if (argc < 2) {
+		fmt_print("usage: packer <archive> <file>...\n");
+		return 1;
+	}
+
+	os_init((struct OS_IInfo){
+		.window_size_x = 320,
+		.window_size_y = 240,
+		.window_caption = "packer",
+	});
+	thread_ctx_init();
+
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	u64 const scratch_position = memory_arena_get_position(scratch);
+
+	int ret = 0;
+	u32 const count = (u32)(argc - 2);
+	struct Archive_Source * sources = MemoryArenaPushArray(scratch, struct Archive_Source, count);
+	for (u32 i = 0; i < count; i++) {
+		char const * path = argv[2 + i];
+		sources[i] = (struct Archive_Source){
+			.name     = packer_get_name(path),
+			.data     = base_file_read(scratch, path),
+			.compress = true,
+		};
+		if (sources[i].data.buffer == NULL) {
+			fmt_print("[packer] missing \"%s\"\n", path);
+			ret = 1;
+		}
+	}
+
+	if (ret == 0) {
+		arr8 const archive = archive_pack(scratch, count, sources);
+		struct File_Writer writer = file_writer_init((struct File_Writer_IInfo){
+			.name   = argv[1],
+			.atomic = true,
+			.direct = true,
+		});
+		file_writer_write(&writer, archive.count, archive.buffer);
+		if (!file_writer_free(&writer)) {
+			fmt_print("[packer] can't write \"%s\"\n", argv[1]);
+			ret = 1;
+		}
+		else
+			fmt_print("[packer] \"%s\" %zu bytes, %u entries\n", argv[1], archive.count, count);
+	}
+
+	memory_arena_set_position(scratch, scratch_position);
+	thread_ctx_free();
+	os_free();
+	return ret;
+}
@@ -0,0 +1,47 @@
+#if !defined (UKWN_SIMD_H)
+#define UKWN_SIMD_H
+
+#include "_project.h"
+
+// @note instruction sets are chosen at compile time, i.e. `-msse4.1` or `-mavx2`;
+// every kernel has a scalar fallback, `BUILD_SIMD_NONE` forces it everywhere
+
+#if BUILD_SIMD == BUILD_SIMD_ENABLE && defined (__SSE2__)
+# define SIMD_SSE2 1
+#else
+# define SIMD_SSE2 0
+#endif
+
+#if SIMD_SSE2 && defined (__SSE4_1__)
+# define SIMD_SSE4 1
+#else
+# define SIMD_SSE4 0
+#endif
+
+#if SIMD_SSE4 && defined (__AVX2__)
+# define SIMD_AVX2 1
+#else
+# define SIMD_AVX2 0
+#endif
+
+#if SIMD_SSE2 && defined (__F16C__)
+# define SIMD_F16C 1
+#else
+# define SIMD_F16C 0
+#endif
+
+#if BUILD_SIMD == BUILD_SIMD_ENABLE && defined (__ARM_NEON) && defined (__aarch64__)
+# define SIMD_NEON 1
+#else
+# define SIMD_NEON 0
+#endif
+
+#include "warnings_push.h"
+#if SIMD_SSE2
+# include <immintrin.h>
+#elif SIMD_NEON
+# include <arm_neon.h>
+#endif
+#include "warnings_pop.h"
+
+#endif
@@ -71,4 +71,10 @@
 # define BUILD_DEBUG (BUILD_OPTIMIZE < BUILD_OPTIMIZE_RELEASE)
 #endif
 
+#define BUILD_SIMD_NONE   0
+#define BUILD_SIMD_ENABLE 1
+#if !defined(BUILD_SIMD)
+# define BUILD_SIMD BUILD_SIMD_ENABLE
+#endif
+
 #endif
@@ -1,8 +1,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
+#include <stdlib.h>
 
 #include "os.h" // includes "base.h"
+#include "_internal/simd.h"
+#include "_internal/power_of_five.h"
 
 /*
 @info floating point IEEE 754
@@ -218,6 +222,7 @@ size_t get_meta_type_size(enum Meta_Type type) {
 		case META_TYPE_S32: return sizeof(s32);
 		case META_TYPE_S64: return sizeof(s64);
 		// floating points
+		case META_TYPE_F16: return sizeof(f16);
 		case META_TYPE_F32: return sizeof(f32);
 		case META_TYPE_F64: return sizeof(f64);
 	}
@@ -238,6 +243,7 @@ AssertSize(s16, 2);
 AssertSize(s32, 4);
 AssertSize(s64, 8);
 
+AssertSize(f16, 2);
 AssertSize(f32, 4);
 AssertSize(f64, 8);
 
@@ -303,6 +309,47 @@ size_t mul_div_size(size_t value, size_t mul, size_t div) {
 	     + (value % div) * mul / div;
 }
 
+u32 ctz_u32(u32 value) {
+#if defined (__clang__) || defined (__GNUC__)
+	return (u32)__builtin_ctz(value);
+#else
+	u32 ret = 0;
+	while (!(value & 1) && ret < 32) { value >>= 1; ret++; }
+	return ret;
+#endif
+}
+
+u32 ctz_u64(u64 value) {
+#if defined (__clang__) || defined (__GNUC__)
+	return (u32)__builtin_ctzll(value);
+#else
+	u32 ret = 0;
+	while (!(value & 1) && ret < 64) { value >>= 1; ret++; }
+	return ret;
+#endif
+}
+
+u32 clz_u64(u64 value) {
+#if defined (__clang__) || defined (__GNUC__)
+	return (u32)__builtin_clzll(value);
+#else
+	u32 ret = 0;
+	while (!(value & ((u64)1 << 63)) && ret < 64) { value <<= 1; ret++; }
+	return ret;
+#endif
+}
+
+u32 popcount_u64(u64 value) {
+#if defined (__clang__) || defined (__GNUC__)
+	return (u32)__builtin_popcountll(value);
+#else
+	value = value - ((value >> 1) & 0x5555555555555555ull);
+	value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+	value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0full;
+	return (u32)((value * 0x0101010101010101ull) >> 56);
+#endif
+}
+
 // ---- ---- ---- ----
 // functions: f32
 // ---- ---- ---- ----
@@ -314,6 +361,7 @@ f32 sin32(f32 value)  { return sinf(value); }
 f32 cos32(f32 value)  { return cosf(value); }
 f32 tan32(f32 value)  { return tanf(value); }
 f32 sqrt32(f32 value) { return sqrtf(value); }
+f32 abs32(f32 value)  { return fabsf(value); }
 
 f32 round32(f32 value) { return roundf(value); }
 f32 trunc32(f32 value) { return truncf(value); }
@@ -360,6 +408,7 @@ f64 sin64(f64 value)  { return sin(value); }
 f64 cos64(f64 value)  { return cos(value); }
 f64 tan64(f64 value)  { return tan(value); }
 f64 sqrt64(f64 value) { return sqrt(value); }
+f64 abs64(f64 value)  { return fabs(value); }
 
 f64 round64(f64 value) { return round(value); }
 f64 trunc64(f64 value) { return trunc(value); }
@@ -395,6 +444,137 @@ f64 next_f64(f64 value) {
 	return bits.as_f;
 }
 
+// ---- ---- ---- ----
+// functions: f16
+// ---- ---- ---- ----
+
+f16 f16_from_f32(f32 value) {
+	bits32 bits = {.as_f = value};
+	u32 const sign = (bits.as_u >> 16) & 0x8000;
+	bits.as_u &= 0x7fffffff;
+
+	// -- infinity and NaN, the latter keeps the upper payload and gets quiet
+	if (bits.as_u >= 0x7f800000)
+		return (f16)(sign | 0x7c00 | ((bits.as_u > 0x7f800000) ? (0x0200 | ((bits.as_u >> 13) & 0x03ff)) : 0));
+
+	// -- rounds up to infinity, `65520` and beyond
+	if (bits.as_u >= 0x477ff000)
+		return (f16)(sign | 0x7c00);
+
+	// -- denormals and zero, `0.5` puts the f16 denormal unit into the last mantissa bit,
+	// the addition itself rounds to nearest even
+	if (bits.as_u < 0x38800000) {
+		bits.as_f += 0.5f;
+		return (f16)(sign | (bits.as_u - 0x3f000000));
+	}
+
+	// -- normals, rebias the exponent, round to nearest even
+	u32 const odd = (bits.as_u >> 13) & 1;
+	bits.as_u += ((u32)(15 - 127) << 23) + 0x0fff + odd;
+	return (f16)(sign | (bits.as_u >> 13));
+}
+
+f32 f32_from_f16(f16 value) {
+	u32 const sign     = (u32)(value & 0x8000) << 16;
+	u32 const exponent = (value >> 10) & 0x1f;
+	u32 const mantissa = value & 0x03ff;
+
+	bits32 bits;
+	if (exponent == 0) {
+		// @note denormals are `M * 2^-24`, exact via `0.5 + M * 2^-24 - 0.5`
+		bits.as_u = 0x3f000000 | mantissa;
+		bits.as_f -= 0.5f;
+		bits.as_u |= sign;
+	}
+	else if (exponent == 0x1f)
+		bits.as_u = sign | 0x7f800000 | ((mantissa != 0) ? (0x00400000 | (mantissa << 13)) : 0);
+	else
+		bits.as_u = sign | ((exponent + (127 - 15)) << 23) | (mantissa << 13);
+	return bits.as_f;
+}
+
+void f16_from_f32_batch(size_t count, f32 const * source, f16 * target) {
+	size_t i = 0;
+#if SIMD_F16C
+	for (; i + 8 <= count; i += 8) {
+		__m128i const halves = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128((__m128i *)(void *)(target + i), halves);
+	}
+#elif SIMD_NEON
+	for (; i + 4 <= count; i += 4)
+		vst1_u16(target + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(source + i))));
+#endif
+	for (; i < count; i++)
+		target[i] = f16_from_f32(source[i]);
+}
+
+void f32_from_f16_batch(size_t count, f16 const * source, f32 * target) {
+	size_t i = 0;
+#if SIMD_F16C
+	for (; i + 8 <= count; i += 8) {
+		__m128i const halves = _mm_loadu_si128((__m128i const *)(void const *)(source + i));
+		_mm256_storeu_ps(target + i, _mm256_cvtph_ps(halves));
+	}
+#elif SIMD_NEON
+	for (; i + 4 <= count; i += 4)
+		vst1q_f32(target + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(source + i))));
+#endif
+	for (; i < count; i++)
+		target[i] = f32_from_f16(source[i]);
+}
+
+// ---- ---- ---- ----
+// functions: packing
+// ---- ---- ---- ----
+
+s16 snorm16_from_f32(f32 value) {
+	value = (value > -1) ? value : -1;
+	value = (value <  1) ? value :  1;
+	return (s16)round32(value * 32767);
+}
+
+f32 f32_from_snorm16(s16 value) {
+	// @note both `-32768` and `-32767` map to `-1`
+	return max_f32((f32)value / 32767, -1);
+}
+
+u16 unorm16_from_f32(f32 value) {
+	value = (value > 0) ? value : 0;
+	value = (value < 1) ? value : 1;
+	return (u16)round32(value * 65535);
+}
+
+f32 f32_from_unorm16(u16 value) {
+	return (f32)value / 65535;
+}
+
+vec2 octahedral_encode(vec3 value) {
+	// @note project onto the octahedron `|x| + |y| + |z| == 1`, then fold the lower half
+	f32 const ax = value.x < 0 ? -value.x : value.x;
+	f32 const ay = value.y < 0 ? -value.y : value.y;
+	f32 const az = value.z < 0 ? -value.z : value.z;
+	f32 const sum = ax + ay + az;
+	f32 const scale = sum > 0 ? 1 / sum : 0;
+	vec2 ret = {value.x * scale, value.y * scale};
+	if (value.z < 0) {
+		f32 const fx = 1 - ay * scale;
+		f32 const fy = 1 - ax * scale;
+		ret.x = ret.x >= 0 ? fx : -fx;
+		ret.y = ret.y >= 0 ? fy : -fy;
+	}
+	return ret;
+}
+
+vec3 octahedral_decode(vec2 value) {
+	f32 const ax = value.x < 0 ? -value.x : value.x;
+	f32 const ay = value.y < 0 ? -value.y : value.y;
+	vec3 ret = {value.x, value.y, 1 - ax - ay};
+	f32 const fold = max_f32(-ret.z, 0);
+	ret.x += ret.x >= 0 ? -fold : fold;
+	ret.y += ret.y >= 0 ? -fold : fold;
+	return vec3_divs(ret, sqrt32(vec3_dot(ret, ret)));
+}
+
 // ---- ---- ---- ----
 // functions: limit
 // ---- ---- ---- ----
@@ -474,8 +654,11 @@ u32 hash32_xorshift(u32 value) {
 }
 
 u64 hash64_fnv1(void const * value, size_t size) {
-	u64 const prime =        1099511628211ull;
-	u64       hash  = 14695981039346656037ull;
+	return hash64_fnv1_continue(14695981039346656037ull, value, size);
+}
+
+u64 hash64_fnv1_continue(u64 hash, void const * value, size_t size) {
+	u64 const prime = 1099511628211ull;
 	for (size_t i = 0; i < size; i++)
 		hash = (hash * prime) ^ ((u8*)value)[i];
 	return hash;
@@ -495,6 +678,152 @@ u64 hash64_xorshift(u64 value) {
 	return value;
 }
 
+// ---- ---- ---- ----
+// functions: compression
+// ---- ---- ---- ----
+
+#define LZ4_HASH_BITS    12
+#define LZ4_MATCH_MIN    4
+#define LZ4_OFFSET_MAX   0xffff
+#define LZ4_LAST_LITERALS 5  // @note the block ends with as many literals
+#define LZ4_LAST_MATCH    12 // @note the last match starts before as many bytes
+
+AttrFileLocal()
+u32 lz4_read_u32(u8 const * source) {
+	u32 ret; mem_copy(source, &ret, sizeof(ret));
+	return ret;
+}
+
+AttrFileLocal()
+size_t lz4_get_length_size(size_t length) {
+	// @note a token nibble holds up to 14, extension bytes carry the rest
+	return length >= 0xf ? (length - 0xf) / 0xff + 1 : 0;
+}
+
+AttrFileLocal()
+size_t lz4_write_length(size_t length, u8 * target) {
+	size_t ret = 0;
+	for (; length >= 0xff; length -= 0xff)
+		target[ret++] = 0xff;
+	target[ret++] = (u8)length;
+	return ret;
+}
+
+size_t lz4_get_bound(size_t size) {
+	return size + size / 0xff + 16;
+}
+
+size_t lz4_compress(size_t size, u8 const * source, size_t capacity, u8 * target) {
+	AssertF(size <= 0xffffffff, "[base] LZ4 source is too large %zu\n", size);
+	u32 table[1 << LZ4_HASH_BITS] = {0};
+
+	size_t ret = 0;
+	size_t anchor = 0;
+	size_t const match_limit = size > LZ4_LAST_MATCH ? size - LZ4_LAST_MATCH : 0;
+	for (size_t cursor = 0; cursor < match_limit; (void)0) {
+		u32 const sequence = lz4_read_u32(source + cursor);
+		u32 const hash = (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+		size_t const candidate = table[hash];
+		table[hash] = (u32)cursor;
+		if (candidate >= cursor || cursor - candidate > LZ4_OFFSET_MAX
+		 || lz4_read_u32(source + candidate) != sequence) {
+			cursor++; continue;
+		}
+
+		size_t length = LZ4_MATCH_MIN;
+		while (cursor + length < size - LZ4_LAST_LITERALS && source[candidate + length] == source[cursor + length])
+			length++;
+
+		size_t const literals = cursor - anchor;
+		size_t const required = 1 + lz4_get_length_size(literals) + literals + 2 + lz4_get_length_size(length - LZ4_MATCH_MIN);
+		if (required > capacity - ret)
+			return 0;
+
+		u8 * token = target + ret++;
+		*token = (u8)((min_size(literals, 0xf) << 4) | min_size(length - LZ4_MATCH_MIN, 0xf));
+		if (literals >= 0xf)
+			ret += lz4_write_length(literals - 0xf, target + ret);
+		mem_copy(source + anchor, target + ret, literals);
+		ret += literals;
+
+		size_t const offset = cursor - candidate;
+		target[ret++] = (u8)(offset >> 0);
+		target[ret++] = (u8)(offset >> 8);
+		if (length - LZ4_MATCH_MIN >= 0xf)
+			ret += lz4_write_length(length - LZ4_MATCH_MIN - 0xf, target + ret);
+
+		cursor += length;
+		anchor = cursor;
+	}
+
+	size_t const literals = size - anchor;
+	if (1 + lz4_get_length_size(literals) + literals > capacity - ret)
+		return 0;
+	target[ret++] = (u8)(min_size(literals, 0xf) << 4);
+	if (literals >= 0xf)
+		ret += lz4_write_length(literals - 0xf, target + ret);
+	mem_copy(source + anchor, target + ret, literals);
+	ret += literals;
+	return ret;
+	// @info LZ4 block format
+	// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+}
+
+size_t lz4_decompress(size_t size, u8 const * source, size_t capacity, u8 * target) {
+	size_t ret = 0;
+	for (size_t cursor = 0; cursor < size; (void)0) {
+		u8 const token = source[cursor++];
+
+		size_t literals = token >> 4;
+		if (literals == 0xf) {
+			u8 next;
+			do {
+				if (cursor >= size)
+					return 0;
+				next = source[cursor++];
+				literals += next;
+			} while (next == 0xff);
+		}
+		if (literals > size - cursor || literals > capacity - ret)
+			return 0;
+		mem_copy(source + cursor, target + ret, literals);
+		cursor += literals;
+		ret += literals;
+
+		// @note the last sequence has no match
+		if (cursor == size)
+			break;
+
+		if (size - cursor < 2)
+			return 0;
+		size_t const offset = (size_t)source[cursor] | ((size_t)source[cursor + 1] << 8);
+		cursor += 2;
+		if (offset == 0 || offset > ret)
+			return 0;
+
+		size_t length = (token & 0xf) + LZ4_MATCH_MIN;
+		if ((token & 0xf) == 0xf) {
+			u8 next;
+			do {
+				if (cursor >= size)
+					return 0;
+				next = source[cursor++];
+				length += next;
+			} while (next == 0xff);
+		}
+		if (length > capacity - ret)
+			return 0;
+
+		// @note matches may overlap their own output
+		if (offset >= length)
+			mem_copy(target + ret - offset, target + ret, length);
+		else for (size_t i = 0; i < length; i++)
+			target[ret + i] = target[ret - offset + i];
+		ret += length;
+	}
+	return ret;
+}
+
 // ---- ---- ---- ----
 // functions: array
 // ---- ---- ---- ----
@@ -594,387 +923,2852 @@ void str32_append(str32 * inst, str32 value) {
 }
 
 // ---- ---- ---- ----
-// functions: table
+// functions: string scanning
 // ---- ---- ---- ----
 
-enum Hash_Map_Mark {
-	HASH_MAP_MARK_NONE,
-	HASH_MAP_MARK_FULL,
-	HASH_MAP_MARK_SKIP,
-};
+/*
+@note `simd8_*` is a byte-wise vector of `SIMD8_WIDTH` lanes, `simd8_mask` packs
+lanes into bits (lane 0 is bit 0), all comparisons yield `0xff` / `0x00` per lane
+*/
+
+#if SIMD_AVX2
+# define SIMD8_WIDTH 32
+typedef __m256i simd8;
+# define simd8_load(ptr)  _mm256_loadu_si256((__m256i const *)(void const *)(ptr))
+# define simd8_splat(v)   _mm256_set1_epi8((char)(v))
+# define simd8_eq(a, b)   _mm256_cmpeq_epi8(a, b)
+# define simd8_or(a, b)   _mm256_or_si256(a, b)
+# define simd8_sub(a, b)  _mm256_sub_epi8(a, b)
+# define simd8_le(a, b)   _mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a)
+# define simd8_mask(a)    (u32)_mm256_movemask_epi8(a)
+#elif SIMD_SSE2
+# define SIMD8_WIDTH 16
+typedef __m128i simd8;
+# define simd8_load(ptr)  _mm_loadu_si128((__m128i const *)(void const *)(ptr))
+# define simd8_splat(v)   _mm_set1_epi8((char)(v))
+# define simd8_eq(a, b)   _mm_cmpeq_epi8(a, b)
+# define simd8_or(a, b)   _mm_or_si128(a, b)
+# define simd8_sub(a, b)  _mm_sub_epi8(a, b)
+# define simd8_le(a, b)   _mm_cmpeq_epi8(_mm_min_epu8(a, b), a)
+# define simd8_mask(a)    (u32)_mm_movemask_epi8(a)
+#elif SIMD_NEON
+# define SIMD8_WIDTH 16
+typedef uint8x16_t simd8;
+# define simd8_load(ptr)  vld1q_u8((u8 const *)(ptr))
+# define simd8_splat(v)   vdupq_n_u8((u8)(v))
+# define simd8_eq(a, b)   vceqq_u8(a, b)
+# define simd8_or(a, b)   vorrq_u8(a, b)
+# define simd8_sub(a, b)  vsubq_u8(a, b)
+# define simd8_le(a, b)   vcleq_u8(a, b)
+# define simd8_mask(a)    simd8_mask_neon(a)
 
 AttrFileLocal()
-size_t hash_map_find_index(struct Hash_Map const * inst, void const * key) {
-	size_t empty = SIZE_MAX;
-	if (inst->count >= inst->capacity)
-		return empty;
+u32 simd8_mask_neon(uint8x16_t value) {
+	// @note NEON lacks `movemask`, weight lanes by their bit and sum halves instead
+	AttrFuncLocal() u8 const weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+	uint8x16_t const bits = vandq_u8(value, vld1q_u8(weights));
+	u32 const lo = vaddv_u8(vget_low_u8(bits));
+	u32 const hi = vaddv_u8(vget_high_u8(bits));
+	return lo | (hi << 8);
+}
+#else
+# define SIMD8_WIDTH 0
+#endif
 
-	u32 const hash = inst->hash(key);
-	size_t const mask = inst->capacity - 1;
-	size_t const base = hash & mask;
-	for (size_t i = 0; i < inst->capacity; i++) {
-		size_t const index = (base + i) & mask;
-		u8 const mark = inst->marks[index];
-		if (mark == HASH_MAP_MARK_FULL) {
-			void const * hash_map_key = (u8*)inst->keys + index * inst->key_size;
-			u32  const   hash_map_hash = inst->hash(hash_map_key);
-			if (hash_map_hash == hash && mem_equals(hash_map_key, key, inst->key_size))
-				return index;
-		}
-		else {
-			if (empty == SIZE_MAX) empty = index;
-			if (mark == HASH_MAP_MARK_NONE) break;
-		}
+AttrFileLocal()
+bool str8_is_space(u8 value) {
+	return value == ' ' || (u8)(value - '\t') <= '\r' - '\t';
+}
+
+size_t str8_find_byte(str8 inst, u8 value) {
+	size_t i = 0;
+#if SIMD8_WIDTH > 0
+	simd8 const needle = simd8_splat(value);
+	for (; i + SIMD8_WIDTH <= inst.count; i += SIMD8_WIDTH) {
+		u32 const mask = simd8_mask(simd8_eq(simd8_load(inst.buffer + i), needle));
+		if (mask != 0) return i + ctz_u32(mask);
 	}
+#endif
+	for (; i < inst.count; i++)
+		if (inst.buffer[i] == value) return i;
+	return inst.count;
+}
 
-	return empty;
+size_t str8_find_any(str8 inst, str8 set) {
+	if (set.count == 1)
+		return str8_find_byte(inst, set.buffer[0]);
+
+	size_t i = 0;
+#if SIMD8_WIDTH > 0
+	// @note a splat per byte of the set is cheaper than a table up to a point
+	if (set.count <= 16) {
+		simd8 needles[16];
+		for (size_t s = 0; s < set.count; s++)
+			needles[s] = simd8_splat(set.buffer[s]);
+		for (; i + SIMD8_WIDTH <= inst.count; i += SIMD8_WIDTH) {
+			simd8 const chunk = simd8_load(inst.buffer + i);
+			simd8 hits = simd8_eq(chunk, needles[0]);
+			for (size_t s = 1; s < set.count; s++)
+				hits = simd8_or(hits, simd8_eq(chunk, needles[s]));
+			u32 const mask = simd8_mask(hits);
+			if (mask != 0) return i + ctz_u32(mask);
+		}
+	}
+#endif
+
+	bool table[256] = {0};
+	for (size_t s = 0; s < set.count; s++)
+		table[set.buffer[s]] = true;
+	for (; i < inst.count; i++)
+		if (table[inst.buffer[i]]) return i;
+	return inst.count;
 }
 
-struct Hash_Map hash_map_init(Hash32 * hash, size_t key_size, size_t val_size) {
-	struct Hash_Map table = {.hash = hash, .key_size = key_size, .val_size = val_size};
-	return table;
+str8 str8_skip_space(str8 inst) {
+	size_t i = 0;
+#if SIMD8_WIDTH > 0
+	u32 const full = (u32)(((u64)1 << SIMD8_WIDTH) - 1);
+	simd8 const space = simd8_splat(' ');
+	simd8 const tab   = simd8_splat('\t');
+	simd8 const range = simd8_splat('\r' - '\t');
+	for (; i + SIMD8_WIDTH <= inst.count; i += SIMD8_WIDTH) {
+		simd8 const chunk = simd8_load(inst.buffer + i);
+		simd8 const hits = simd8_or(
+			simd8_eq(chunk, space),
+			simd8_le(simd8_sub(chunk, tab), range)
+		);
+		u32 const mask = simd8_mask(hits) ^ full;
+		if (mask != 0) { i += ctz_u32(mask); break; }
+	}
+#endif
+	while (i < inst.count && str8_is_space(inst.buffer[i])) i++;
+	return (str8){
+		.count = inst.count - i,
+		.buffer = inst.buffer + i,
+	};
 }
 
-void hash_map_free(struct Hash_Map * inst) {
-	os_memory_heap(inst->keys, 0);
-	os_memory_heap(inst->vals, 0);
-	os_memory_heap(inst->marks, 0);
-	mem_zero(inst, sizeof(*inst));
+str8 str8_next_line(str8 * inst) {
+	size_t const end = str8_find_byte(*inst, '\n');
+	str8 ret = {.count = end, .buffer = inst->buffer};
+	if (ret.count > 0 && ret.buffer[ret.count - 1] == '\r')
+		ret.count -= 1;
+
+	size_t const skip = min_size(end + 1, inst->count);
+	inst->count  -= skip;
+	inst->buffer += skip;
+	return ret;
 }
 
-void hash_map_arena(struct Hash_Map * inst, struct Memory_Arena * arena, size_t count) {
-	AttrFuncLocal() size_t const mark_size = sizeof(*inst->marks);
-	inst->capacity = next_po2_size(count);
-	inst->keys  = memory_arena_push(arena, inst->capacity * inst->key_size, /*align*/ clamp_size(inst->key_size, sizeof(u8), sizeof(u64)));
-	inst->vals  = memory_arena_push(arena, inst->capacity * inst->val_size, /*align*/ clamp_size(inst->val_size, sizeof(u8), sizeof(u64)));
-	inst->marks = memory_arena_push(arena, inst->capacity * mark_size,      /*align*/ clamp_size(mark_size,      sizeof(u8), sizeof(u64)));
+size_t str8_index_newlines(str8 inst, u64 * out_bits) {
+	size_t ret = 0;
+	size_t i = 0;
+#if SIMD8_WIDTH > 0
+	simd8 const needle = simd8_splat('\n');
+	for (; i + 64 <= inst.count; i += 64) {
+		u64 bits = 0;
+		for (u32 k = 0; k < 64; k += SIMD8_WIDTH) {
+			u64 const mask = simd8_mask(simd8_eq(simd8_load(inst.buffer + i + k), needle));
+			bits |= mask << k;
+		}
+		out_bits[i / 64] = bits;
+		ret += popcount_u64(bits);
+	}
+#endif
+	for (; i < inst.count; i += 64) {
+		size_t const limit = min_size(inst.count - i, 64);
+		u64 bits = 0;
+		for (size_t k = 0; k < limit; k++)
+			if (inst.buffer[i + k] == '\n') bits |= (u64)1 << k;
+		out_bits[i / 64] = bits;
+		ret += popcount_u64(bits);
+	}
+	return ret;
 }
 
-void hash_map_resize(struct Hash_Map * inst, size_t target_count) {
-	AttrFuncLocal() size_t const mark_size = sizeof(*inst->marks);
-	size_t const prev_capacity = inst->capacity;
+// ---- ---- ---- ----
+// functions: string parsing
+// ---- ---- ---- ----
 
-	void * keys = inst->keys;
-	void * vals = inst->vals;
-	u8   * marks = inst->marks;
+/*
+@note floats are parsed into a `mantissa * 10^exponent` decimal first, then converted with
+- Clinger's fast path, when both parts are exactly representable
+- Eisel-Lemire algorithm, when the mantissa fits 19 digits
+- `strtod` / `strtof`, when longer mantissa truncation makes rounding ambiguous
+@info https://arxiv.org/abs/2101.11408
+@info https://arxiv.org/abs/2212.06644
+*/
 
-	inst->capacity = next_po2_size(target_count); inst->count = 0;
-	inst->keys  = os_memory_heap(NULL, inst->capacity * inst->key_size);
-	inst->vals  = os_memory_heap(NULL, inst->capacity * inst->val_size);
-	inst->marks = os_memory_heap(NULL, inst->capacity * mark_size);
+struct Str8_Decimal {
+	u64    mantissa;
+	s64    exponent;
+	u32    digits;
+	bool   negative;
+	bool   truncated;
+	size_t length;
+};
 
-	for (size_t i = 0; i < prev_capacity; i++) {
-		if (marks[i] != HASH_MAP_MARK_FULL)
-			continue;
-		void const * key  = (u8*)keys + i * inst->key_size;
-		void const * val  = (u8*)vals + i * inst->val_size;
-		hash_map_set(inst, key, val);
-	}
+struct Float_Format {
+	s32 sign_bit;
+	s32 mantissa_bits;
+	s32 exponent_bias;
+	s32 infinite_power;
+	s32 power_of_ten_min, power_of_ten_max;
+	s32 round_to_even_min, round_to_even_max;
+};
 
-	os_memory_heap(keys, 0);
-	os_memory_heap(vals, 0);
-	os_memory_heap(marks, 0);
+AttrFileLocal()
+struct Float_Format const fl_f64_format = {
+	.sign_bit       = 63,
+	.mantissa_bits  = 52,
+	.exponent_bias  = 1023,
+	.infinite_power = 0x7ff,
+	.power_of_ten_min  = -342, .power_of_ten_max  = 308,
+	.round_to_even_min =   -4, .round_to_even_max =  23,
+};
+
+AttrFileLocal()
+struct Float_Format const fl_f32_format = {
+	.sign_bit       = 31,
+	.mantissa_bits  = 23,
+	.exponent_bias  = 127,
+	.infinite_power = 0xff,
+	.power_of_ten_min  = -65, .power_of_ten_max  = 38,
+	.round_to_even_min = -17, .round_to_even_max = 10,
+};
+
+AttrFileLocal()
+f64 const fl_f64_exact_powers_of_ten[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+AttrFileLocal()
+f32 const fl_f32_exact_powers_of_ten[] = {
+	1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+
+AttrFileLocal()
+bool str8_is_digit(u8 value) {
+	return (u8)(value - '0') <= 9;
 }
 
-void * hash_map_get(struct Hash_Map * inst, void const * key) {
-	size_t const index = hash_map_find_index(inst, key);
-	if (index < inst->capacity && inst->marks[index] == HASH_MAP_MARK_FULL)
-		return (u8*)inst->vals + index * inst->val_size;
-	return NULL;
+AttrFileLocal()
+bool swar_is_eight_digits(u64 value) {
+	return (((value + 0x4646464646464646ull) | (value - 0x3030303030303030ull)) & 0x8080808080808080ull) == 0;
 }
 
-void hash_map_set(struct Hash_Map * inst, void const * key, void const * val) {
-	if (inst->count >= inst->capacity * 2 / 3)
-		hash_map_resize(inst, inst->capacity * 2);
-	size_t const index = hash_map_find_index(inst, key);
-	Assert(index < inst->capacity, "[base] overflow");
-	mem_copy(key, (u8*)inst->keys + index * inst->key_size, inst->key_size);
-	mem_copy(val, (u8*)inst->vals + index * inst->val_size, inst->val_size);
-	inst->count += (inst->marks[index] != HASH_MAP_MARK_FULL);
-	inst->marks[index] = HASH_MAP_MARK_FULL;
+AttrFileLocal()
+u32 swar_parse_eight_digits(u64 value) {
+	// @note expects little-endian bytes, combines pairs, then quads, then halves
+	value -= 0x3030303030303030ull;
+	value = (value * 10) + (value >> 8);
+	value = (((value & 0x000000ff000000ffull) * 0x000f424000000064ull)
+	      + (((value >> 16) & 0x000000ff000000ffull) * 0x0000271000000001ull)) >> 32;
+	return (u32)value;
 }
 
-void hash_map_remove(struct Hash_Map * inst, void const * key) {
-	size_t const index = hash_map_find_index(inst, key);
-	Assert(index < inst->capacity, "[base] overflow");
-	if (inst->marks[index] == HASH_MAP_MARK_FULL) {
-		inst->marks[index] = HASH_MAP_MARK_SKIP;
-		inst->count--;
+AttrFileLocal()
+size_t str8_parse_digits(u8 const * buffer, size_t count, struct Str8_Decimal * dec, size_t * out_kept) {
+	// @note 19 digits always fit into `u64`, the rest is dropped
+	u64 mantissa = dec->mantissa;
+	u32 digits   = dec->digits;
+	bool truncated = false;
+
+	size_t i = 0;
+	while (digits + 8 <= 19 && i + 8 <= count) {
+		u64 chunk; mem_copy(buffer + i, &chunk, sizeof(chunk));
+		if (!swar_is_eight_digits(chunk)) break;
+		mantissa = mantissa * 100000000 + swar_parse_eight_digits(chunk);
+		digits += 8; i += 8;
 	}
+	for (; i < count && digits < 19; i++) {
+		u8 const digit = (u8)(buffer[i] - '0');
+		if (digit > 9) break;
+		mantissa = mantissa * 10 + digit;
+		digits += 1;
+	}
+	size_t const kept = digits - dec->digits;
+	for (; i < count && str8_is_digit(buffer[i]); i++)
+		truncated = truncated || buffer[i] != '0';
+
+	dec->mantissa  = mantissa;
+	dec->digits    = digits;
+	dec->truncated = dec->truncated || truncated;
+	*out_kept = kept;
+	return i;
 }
 
-// ---- ---- ---- ----
-// functions: f32 math, vector
-// ---- ---- ---- ----
+AttrFileLocal()
+bool str8_parse_decimal(str8 inst, struct Str8_Decimal * out) {
+	struct Str8_Decimal dec = {0};
+	u8 const * buffer = inst.buffer;
+	size_t const count = inst.count;
+	size_t i = 0, kept = 0;
+	bool any_digit = false;
+
+	if (i < count && (buffer[i] == '-' || buffer[i] == '+')) {
+		dec.negative = buffer[i] == '-';
+		i += 1;
+	}
 
-vec2 vec2_add(vec2 l, vec2 r) { return (vec2){l.x + r.x, l.y + r.y}; }
-vec2 vec2_sub(vec2 l, vec2 r) { return (vec2){l.x - r.x, l.y - r.y}; }
-vec2 vec2_mul(vec2 l, vec2 r) { return (vec2){l.x * r.x, l.y * r.y}; }
-vec2 vec2_div(vec2 l, vec2 r) { return (vec2){l.x / r.x, l.y / r.y}; }
-f32  vec2_dot(vec2 l, vec2 r) { return l.x * r.x + l.y * r.y; }
-vec2 vec2_muls(vec2 l, f32 r) { return (vec2){l.x * r, l.y * r}; }
-vec2 vec2_divs(vec2 l, f32 r) { return (vec2){l.x / r, l.y / r}; }
+	// -- integer part, leading zeros aren't significant
+	size_t const integer_start = i;
+	while (i < count && buffer[i] == '0') i++;
+	size_t const integer_digits = str8_parse_digits(buffer + i, count - i, &dec, &kept);
+	dec.exponent += (s64)(integer_digits - kept);
+	i += integer_digits;
+	any_digit = i > integer_start;
+
+	// -- fractional part
+	if (i < count && buffer[i] == '.') {
+		i += 1;
+		size_t const fraction_start = i;
+		if (dec.digits == 0)
+			for (; i < count && buffer[i] == '0'; i++) dec.exponent -= 1;
+		i += str8_parse_digits(buffer + i, count - i, &dec, &kept);
+		dec.exponent -= (s64)kept;
+		any_digit = any_digit || i > fraction_start;
+	}
 
-vec3 vec3_add(vec3 l, vec3 r) { return (vec3){l.x + r.x, l.y + r.y, l.z + r.z}; }
-vec3 vec3_sub(vec3 l, vec3 r) { return (vec3){l.x - r.x, l.y - r.y, l.z - r.z}; }
-vec3 vec3_mul(vec3 l, vec3 r) { return (vec3){l.x * r.x, l.y * r.y, l.z * r.z}; }
-vec3 vec3_div(vec3 l, vec3 r) { return (vec3){l.x / r.x, l.y / r.y, l.z / r.z}; }
-f32  vec3_dot(vec3 l, vec3 r) { return l.x * r.x + l.y * r.y + l.z * r.z; }
-vec3 vec3_muls(vec3 l, f32 r) { return (vec3){l.x * r, l.y * r, l.z * r}; }
-vec3 vec3_divs(vec3 l, f32 r) { return (vec3){l.x / r, l.y / r, l.z / r}; }
+	if (!any_digit)
+		return false;
 
-vec4 vec4_add(vec4 l, vec4 r) { return (vec4){l.x + r.x, l.y + r.y, l.z + r.z, l.w + r.w}; }
-vec4 vec4_sub(vec4 l, vec4 r) { return (vec4){l.x - r.x, l.y - r.y, l.z - r.z, l.w - r.w}; }
-vec4 vec4_mul(vec4 l, vec4 r) { return (vec4){l.x * r.x, l.y * r.y, l.z * r.z, l.w * r.w}; }
-vec4 vec4_div(vec4 l, vec4 r) { return (vec4){l.x / r.x, l.y / r.y, l.z / r.z, l.w / r.w}; }
-f32  vec4_dot(vec4 l, vec4 r) { return l.x * r.x + l.y * r.y + l.z * r.z + l.w * r.w; }
-vec4 vec4_muls(vec4 l, f32 r) { return (vec4){l.x * r, l.y * r, l.z * r, l.w * r}; }
-vec4 vec4_divs(vec4 l, f32 r) { return (vec4){l.x / r, l.y / r, l.z / r, l.w / r}; }
+	// -- exponent part, only consumed when well-formed
+	if (i < count && (buffer[i] | 0x20) == 'e') {
+		size_t e = i + 1;
+		bool negative = false;
+		if (e < count && (buffer[e] == '-' || buffer[e] == '+')) {
+			negative = buffer[e] == '-';
+			e += 1;
+		}
+		if (e < count && str8_is_digit(buffer[e])) {
+			s64 value = 0;
+			for (; e < count && str8_is_digit(buffer[e]); e++)
+				if (value < 0x10000) value = value * 10 + (buffer[e] - '0');
+			dec.exponent += negative ? -value : value;
+			i = e;
+		}
+	}
 
-f32  vec2_crs(vec2 l, vec2 r) { return l.x * r.y - l.y * r.x; }
-vec3 vec3_crs(vec3 l, vec3 r) { return (vec3){
-	l.y * r.z - l.z * r.y,
-	l.z * r.x - l.x * r.z,
-	l.x * r.y - l.y * r.x,
-}; }
+	dec.length = i;
+	*out = dec;
+	return true;
+}
 
-// ---- ---- ---- ----
-// functions: f32 math, quaternion
-// ---- ---- ---- ----
+AttrFileLocal()
+u64 mul_u64_full(u64 v1, u64 v2, u64 * out_high) {
+	u64 const v1_lo = (u32)v1, v1_hi = v1 >> 32;
+	u64 const v2_lo = (u32)v2, v2_hi = v2 >> 32;
+	u64 const lo_lo = v1_lo * v2_lo;
+	u64 const lo_hi = v1_lo * v2_hi;
+	u64 const hi_lo = v1_hi * v2_lo;
+	u64 const hi_hi = v1_hi * v2_hi;
+	u64 const mid = (lo_lo >> 32) + (u32)lo_hi + (u32)hi_lo;
+	*out_high = hi_hi + (lo_hi >> 32) + (hi_lo >> 32) + (mid >> 32);
+	return (mid << 32) | (u32)lo_lo;
+}
 
-quat quat_axis(vec3 axis, f32 radians) {
-	f32 const h = radians * 0.5f;
-	f32 const s = sin32(h);
-	f32 const c = cos32(h);
-	return (quat){axis.x * s, axis.y * s, axis.z * s, c};
+AttrFileLocal()
+u64 float_bits_from_decimal(u64 w, s64 q, struct Float_Format const * format) {
+	// @note Eisel-Lemire, returns bits without the sign; exact for any 64-bit `w`
+	// @info https://github.com/fastfloat/fast_float/blob/main/include/fast_float/decimal_to_binary.h
+	u64 const infinity = (u64)format->infinite_power << format->mantissa_bits;
+	if (w == 0 || q < format->power_of_ten_min) return 0;
+	if (q > format->power_of_ten_max) return infinity;
+
+	u32 const lz = clz_u64(w);
+	w <<= lz;
+
+	// -- approximate `w * 5^q` to a sufficient precision
+	size_t const index = (size_t)(q - POWER_OF_FIVE_MIN) * 2;
+	u64 const precision_mask = UINT64_MAX >> (format->mantissa_bits + 3);
+	u64 high;
+	u64 low = mul_u64_full(w, fl_power_of_five_128[index], &high);
+	if ((high & precision_mask) == precision_mask) {
+		u64 second_high;
+		mul_u64_full(w, fl_power_of_five_128[index + 1], &second_high);
+		low += second_high;
+		if (second_high > low) high += 1;
+	}
+
+	// -- `log2(10^q) == q * log2(10) ~= q * 217706 / 2^16`
+	u32 const upper_bit = (u32)(high >> 63);
+	u32 const shift = upper_bit + 64 - (u32)format->mantissa_bits - 3;
+	u64 mantissa = high >> shift;
+	s64 power2 = ((217706 * q) >> 16) + 63 + (s64)upper_bit - (s64)lz + format->exponent_bias;
+
+	// -- subnormals
+	if (power2 <= 0) {
+		if (-power2 + 1 >= 64) return 0;
+		mantissa >>= -power2 + 1;
+		mantissa += mantissa & 1;
+		mantissa >>= 1;
+		power2 = mantissa < ((u64)1 << format->mantissa_bits) ? 0 : 1;
+		return ((u64)power2 << format->mantissa_bits) | mantissa;
+	}
+
+	// -- exactly halfway, round to even
+	if (low <= 1 && (mantissa & 3) == 1
+		&& q >= format->round_to_even_min && q <= format->round_to_even_max
+		&& (mantissa << shift) == high)
+		mantissa &= ~(u64)1;
+
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if (mantissa >= ((u64)2 << format->mantissa_bits)) {
+		mantissa = (u64)1 << format->mantissa_bits;
+		power2 += 1;
+	}
+	mantissa &= ~((u64)1 << format->mantissa_bits);
+
+	if (power2 >= format->infinite_power) return infinity;
+	return ((u64)power2 << format->mantissa_bits) | mantissa;
 }
 
-quat quat_rotation(vec3 radians) {
-	vec3 const h = vec3_mul(radians, (vec3){0.5f, 0.5f, 0.5f});
-	vec3 const s = (vec3){sin32(h.x), sin32(h.y), sin32(h.z)};
-	vec3 const c = (vec3){cos32(h.x), cos32(h.y), cos32(h.z)};
-	float const sy_cx = s.y*c.x; float const cy_sx = c.y*s.x;
-	float const cy_cx = c.y*c.x; float const sy_sx = s.y*s.x;
-	return (quat){
-		sy_cx*s.z + cy_sx*c.z,
-		sy_cx*c.z - cy_sx*s.z,
-		cy_cx*s.z - sy_sx*c.z,
-		cy_cx*c.z + sy_sx*s.z,
-	};
+AttrFileLocal()
+bool float_bits_from_str8_decimal(struct Str8_Decimal dec, struct Float_Format const * format, u64 * out) {
+	u64 bits = float_bits_from_decimal(dec.mantissa, dec.exponent, format);
+	// @note dropped digits lie between `w` and `w + 1`, ambiguous if those differ
+	if (dec.truncated && bits != float_bits_from_decimal(dec.mantissa + 1, dec.exponent, format))
+		return false;
+	if (dec.negative)
+		bits |= (u64)1 << format->sign_bit;
+	*out = bits;
+	return true;
+}
 
-/*
-ret = quat_axis({0,1,0}, radians_y)
-    * quat_axis({1,0,0}, radians_x)
-    * quat_axis({0,0,1}, radians_z)
-*/
+AttrFileLocal()
+f64 str8_parse_fallback(str8 inst, bool single) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+	char * text = MemoryArenaPushArray(scratch, char, inst.count + 1);
+	mem_copy(inst.buffer, text, inst.count);
+	text[inst.count] = '\0';
+	f64 const ret = single ? (f64)strtof(text, NULL) : strtod(text, NULL);
+	memory_arena_set_position(scratch, scratch_position);
+	return ret;
 }
 
-quat quat_mul(quat l, quat r) {
-	return (quat){
-		 l.x * r.w + l.y * r.z - l.z * r.y + l.w * r.x,
-		-l.x * r.z + l.y * r.w + l.z * r.x + l.w * r.y,
-		 l.x * r.y - l.y * r.x + l.z * r.w + l.w * r.z,
-		-l.x * r.x - l.y * r.y - l.z * r.z + l.w * r.w,
-	};
+AttrFileLocal()
+void str8_parse_advance(str8 * inst, size_t length) {
+	inst->count  -= length;
+	inst->buffer += length;
+}
 
-/*
-ret = (l_v + l_w)
-    * (r_v + r_w)
+bool str8_parse_u64(str8 * inst, u64 * out) {
+	u64 value = 0;
+	size_t i = 0;
+	for (; i < inst->count && str8_is_digit(inst->buffer[i]); i++) {
+		u8 const digit = (u8)(inst->buffer[i] - '0');
+		if (value > (UINT64_MAX - digit) / 10)
+			return false;
+		value = value * 10 + digit;
+	}
+	if (i == 0) return false;
+	str8_parse_advance(inst, i);
+	*out = value;
+	return true;
+}
 
-ret = (l_v x r_v) + r_v * l_w + l_v * r_w
-    - (l_v . r_v)             + l_w * r_w
-*/
+bool str8_parse_s64(str8 * inst, s64 * out) {
+	str8 cursor = *inst;
+	bool negative = false;
+	if (cursor.count > 0 && (cursor.buffer[0] == '-' || cursor.buffer[0] == '+')) {
+		negative = cursor.buffer[0] == '-';
+		str8_parse_advance(&cursor, 1);
+	}
+
+	u64 magnitude;
+	if (!str8_parse_u64(&cursor, &magnitude))
+		return false;
+	if (magnitude > (u64)INT64_MAX + negative)
+		return false;
+
+	*inst = cursor;
+	*out = negative
+		? -(s64)(magnitude - 1) - 1
+		:  (s64)magnitude;
+	return true;
 }
 
-vec3 quat_transform(quat q, vec3 v) {
-	vec3 const cr = vec3_crs((vec3){q.x, q.y, q.z}, v);
-	return (vec3){
-	//  v   + (q_v x cr                + q_w * cr)   * 2
-	/**/v.x + (q.y * cr.z - q.z * cr.y + q.w * cr.x) * 2,
-	/**/v.y + (q.z * cr.x - q.x * cr.z + q.w * cr.y) * 2,
-	/**/v.z + (q.x * cr.y - q.y * cr.x + q.w * cr.z) * 2,
-	};
+bool str8_parse_f64(str8 * inst, f64 * out) {
+	struct Str8_Decimal dec;
+	if (!str8_parse_decimal(*inst, &dec))
+		return false;
+
+	f64 value;
+	u64 bits;
+	if (FLT_EVAL_METHOD == 0 && !dec.truncated
+		&& dec.mantissa <= ((u64)1 << 53)
+		&& dec.exponent >= -22 && dec.exponent <= 22) {
+		value = (f64)dec.mantissa;
+		value = dec.exponent < 0
+			? value / fl_f64_exact_powers_of_ten[-dec.exponent]
+			: value * fl_f64_exact_powers_of_ten[dec.exponent];
+		if (dec.negative) value = -value;
+	}
+	else if (float_bits_from_str8_decimal(dec, &fl_f64_format, &bits))
+		mem_copy(&bits, &value, sizeof(value));
+	else
+		value = str8_parse_fallback((str8){.count = dec.length, .buffer = inst->buffer}, false);
+
+	str8_parse_advance(inst, dec.length);
+	*out = value;
+	return true;
+}
 
-/*
-ret = ( q_v + q_w)
-    * (   v +   0)
-    * (-q_v + q_w)
-    / ( q   . q  )
+bool str8_parse_f32(str8 * inst, f32 * out) {
+	struct Str8_Decimal dec;
+	if (!str8_parse_decimal(*inst, &dec))
+		return false;
+
+	f32 value;
+	u64 bits;
+	if (FLT_EVAL_METHOD == 0 && !dec.truncated
+		&& dec.mantissa <= ((u64)1 << 24)
+		&& dec.exponent >= -10 && dec.exponent <= 10) {
+		value = (f32)dec.mantissa;
+		value = dec.exponent < 0
+			? value / fl_f32_exact_powers_of_ten[-dec.exponent]
+			: value * fl_f32_exact_powers_of_ten[dec.exponent];
+		if (dec.negative) value = -value;
+	}
+	else if (float_bits_from_str8_decimal(dec, &fl_f32_format, &bits)) {
+		u32 const bits32 = (u32)bits;
+		mem_copy(&bits32, &value, sizeof(value));
+	}
+	else
+		value = (f32)str8_parse_fallback((str8){.count = dec.length, .buffer = inst->buffer}, true);
 
-ret = v
-    + (q_v x cr * 2)
-    + (q_w * cr * 2)
-*/
+	str8_parse_advance(inst, dec.length);
+	*out = value;
+	return true;
 }
 
-void quat_get_axes(vec4 q, vec3 * x, vec3 * y, vec3 * z) {
-	f32 const xx = q.x*q.x; f32 const xy = q.x*q.y; f32 const xz = q.x*q.z;
-	f32 const zw = q.z*q.w; f32 const yy = q.y*q.y; f32 const yz = q.y*q.z;
-	f32 const yw = q.y*q.w; f32 const wx = q.w*q.x; f32 const zz = q.z*q.z;
-	*x = (vec3){1 - (yy + zz) * 2,     (xy + zw) * 2,     (xz - yw) * 2};
-	*y = (vec3){    (xy - zw) * 2, 1 - (zz + xx) * 2,     (yz + wx) * 2};
-	*z = (vec3){    (xz + yw) * 2,     (yz - wx) * 2, 1 - (xx + yy) * 2};
+size_t str8_parse_vec3(str8 * inst, vec3 * out, size_t count) {
+	str8 cursor = *inst;
+	size_t ret = 0;
+	for (; ret < count; ret++) {
+		vec3 value;
+		cursor = str8_skip_space(cursor);
+		if (!str8_parse_f32(&cursor, &value.x)) break;
+		cursor = str8_skip_space(cursor);
+		if (!str8_parse_f32(&cursor, &value.y)) break;
+		cursor = str8_skip_space(cursor);
+		if (!str8_parse_f32(&cursor, &value.z)) break;
+		out[ret] = value;
+		*inst = cursor;
+	}
+	return ret;
+}
+
+// ---- ---- ---- ----
+// functions: string transcoding
+// ---- ---- ---- ----
 
 /*
-x = quat_transform(q, {1,0,0})
-y = quat_transform(q, {0,1,0})
-z = quat_transform(q, {0,0,1})
+@note each `simd_utf_*` converts a block of 16 code units if those map one-to-one,
+i.e. ASCII for UTF-8 or non-surrogates for UTF-16 / UTF-32; otherwise the block
+is decoded per code point
 */
+
+#define SIMD_UTF (SIMD_SSE2 || SIMD_NEON)
+
+#if SIMD_SSE2
+# define simd_utf_load(ptr)         _mm_loadu_si128((__m128i const *)(void const *)(ptr))
+# define simd_utf_store(ptr, value) _mm_storeu_si128((__m128i *)(void *)(ptr), value)
+
+AttrFileLocal()
+bool simd_utf_widen_8_16(u8 const * source, u16 * target) {
+	__m128i const value = simd_utf_load(source);
+	if (_mm_movemask_epi8(value) != 0) return false;
+	__m128i const zero = _mm_setzero_si128();
+	simd_utf_store(target + 0, _mm_unpacklo_epi8(value, zero));
+	simd_utf_store(target + 8, _mm_unpackhi_epi8(value, zero));
+	return true;
 }
 
-// ---- ---- ---- ----
-// functions: s32 math, matrix
-// ---- ---- ---- ----
+AttrFileLocal()
+bool simd_utf_widen_8_32(u8 const * source, u32 * target) {
+	__m128i const value = simd_utf_load(source);
+	if (_mm_movemask_epi8(value) != 0) return false;
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const lo = _mm_unpacklo_epi8(value, zero);
+	__m128i const hi = _mm_unpackhi_epi8(value, zero);
+	simd_utf_store(target +  0, _mm_unpacklo_epi16(lo, zero));
+	simd_utf_store(target +  4, _mm_unpackhi_epi16(lo, zero));
+	simd_utf_store(target +  8, _mm_unpacklo_epi16(hi, zero));
+	simd_utf_store(target + 12, _mm_unpackhi_epi16(hi, zero));
+	return true;
+}
 
-vec2 mat2_mul_vec(mat2 l, vec2 r) { return (vec2){
-	vec2_dot((vec2){l.x.x, l.y.x}, r),
-	vec2_dot((vec2){l.x.y, l.y.y}, r),
-}; }
+AttrFileLocal()
+bool simd_utf_narrow_16_8(u16 const * source, u8 * target) {
+	__m128i const v0 = simd_utf_load(source + 0);
+	__m128i const v1 = simd_utf_load(source + 8);
+	__m128i const high = _mm_and_si128(_mm_or_si128(v0, v1), _mm_set1_epi16((short)0xff80));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xffff) return false;
+	simd_utf_store(target, _mm_packus_epi16(v0, v1));
+	return true;
+}
 
-mat2 mat2_mul_mat(mat2 l, mat2 r) { return (mat2){
-	mat2_mul_vec(l, r.x),
-	mat2_mul_vec(l, r.y),
-}; }
+AttrFileLocal()
+bool simd_utf_narrow_32_8(u32 const * source, u8 * target) {
+	__m128i const v0 = simd_utf_load(source +  0);
+	__m128i const v1 = simd_utf_load(source +  4);
+	__m128i const v2 = simd_utf_load(source +  8);
+	__m128i const v3 = simd_utf_load(source + 12);
+	__m128i const all = _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3));
+	__m128i const high = _mm_and_si128(all, _mm_set1_epi32(~0x7f));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) != 0xffff) return false;
+	simd_utf_store(target, _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3)));
+	return true;
+}
 
-vec3 mat3_mul_vec(mat3 l, vec3 r) { return (vec3){
-	vec3_dot((vec3){l.x.x, l.y.x, l.z.x}, r),
-	vec3_dot((vec3){l.x.y, l.y.y, l.z.y}, r),
-	vec3_dot((vec3){l.x.z, l.y.z, l.z.z}, r),
-}; }
+AttrFileLocal()
+bool simd_utf_widen_16_32(u16 const * source, u32 * target) {
+	__m128i const v0 = simd_utf_load(source + 0);
+	__m128i const v1 = simd_utf_load(source + 8);
+	__m128i const mask = _mm_set1_epi16((short)0xf800);
+	__m128i const surrogate = _mm_set1_epi16((short)0xd800);
+	__m128i const hits = _mm_or_si128(
+		_mm_cmpeq_epi16(_mm_and_si128(v0, mask), surrogate),
+		_mm_cmpeq_epi16(_mm_and_si128(v1, mask), surrogate)
+	);
+	if (_mm_movemask_epi8(hits) != 0) return false;
+	__m128i const zero = _mm_setzero_si128();
+	simd_utf_store(target +  0, _mm_unpacklo_epi16(v0, zero));
+	simd_utf_store(target +  4, _mm_unpackhi_epi16(v0, zero));
+	simd_utf_store(target +  8, _mm_unpacklo_epi16(v1, zero));
+	simd_utf_store(target + 12, _mm_unpackhi_epi16(v1, zero));
+	return true;
+}
 
-mat3 mat3_mul_mat(mat3 l, mat3 r) { return (mat3){
-	mat3_mul_vec(l, r.x),
-	mat3_mul_vec(l, r.y),
-	mat3_mul_vec(l, r.z),
-}; }
+AttrFileLocal()
+bool simd_utf_narrow_32_16(u32 const * source, u16 * target) {
+	__m128i const v0 = simd_utf_load(source +  0);
+	__m128i const v1 = simd_utf_load(source +  4);
+	__m128i const v2 = simd_utf_load(source +  8);
+	__m128i const v3 = simd_utf_load(source + 12);
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const all = _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3));
+	__m128i const high = _mm_and_si128(all, _mm_set1_epi32((int)0xffff0000));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xffff) return false;
+	__m128i const mask = _mm_set1_epi32(0xf800);
+	__m128i const surrogate = _mm_set1_epi32(0xd800);
+	__m128i const hits = _mm_or_si128(
+		_mm_or_si128(
+			_mm_cmpeq_epi32(_mm_and_si128(v0, mask), surrogate),
+			_mm_cmpeq_epi32(_mm_and_si128(v1, mask), surrogate)
+		),
+		_mm_or_si128(
+			_mm_cmpeq_epi32(_mm_and_si128(v2, mask), surrogate),
+			_mm_cmpeq_epi32(_mm_and_si128(v3, mask), surrogate)
+		)
+	);
+	if (_mm_movemask_epi8(hits) != 0) return false;
+	// @note sign-extend low halves so that signed saturation keeps them intact
+	#define SIMD_UTF_LOW16(v) _mm_srai_epi32(_mm_slli_epi32(v, 16), 16)
+	simd_utf_store(target + 0, _mm_packs_epi32(SIMD_UTF_LOW16(v0), SIMD_UTF_LOW16(v1)));
+	simd_utf_store(target + 8, _mm_packs_epi32(SIMD_UTF_LOW16(v2), SIMD_UTF_LOW16(v3)));
+	#undef SIMD_UTF_LOW16
+	return true;
+}
 
-vec4 mat4_mul_vec(mat4 l, vec4 r) { return (vec4){
-	vec4_dot((vec4){l.x.x, l.y.x, l.z.x, l.w.x}, r),
-	vec4_dot((vec4){l.x.y, l.y.y, l.z.y, l.w.y}, r),
-	vec4_dot((vec4){l.x.z, l.y.z, l.z.z, l.w.z}, r),
-	vec4_dot((vec4){l.x.w, l.y.w, l.z.w, l.w.w}, r),
-}; }
+# undef simd_utf_load
+# undef simd_utf_store
+#elif SIMD_NEON
+AttrFileLocal()
+bool simd_utf_widen_8_16(u8 const * source, u16 * target) {
+	uint8x16_t const value = vld1q_u8(source);
+	if (vmaxvq_u8(value) >= 0x80) return false;
+	vst1q_u16(target + 0, vmovl_u8(vget_low_u8(value)));
+	vst1q_u16(target + 8, vmovl_high_u8(value));
+	return true;
+}
 
-mat4 mat4_mul_mat(mat4 l, mat4 r) { return (mat4){
-	mat4_mul_vec(l, r.x),
-	mat4_mul_vec(l, r.y),
-	mat4_mul_vec(l, r.z),
-	mat4_mul_vec(l, r.w),
-}; }
+AttrFileLocal()
+bool simd_utf_widen_8_32(u8 const * source, u32 * target) {
+	uint8x16_t const value = vld1q_u8(source);
+	if (vmaxvq_u8(value) >= 0x80) return false;
+	uint16x8_t const lo = vmovl_u8(vget_low_u8(value));
+	uint16x8_t const hi = vmovl_high_u8(value);
+	vst1q_u32(target +  0, vmovl_u16(vget_low_u16(lo)));
+	vst1q_u32(target +  4, vmovl_high_u16(lo));
+	vst1q_u32(target +  8, vmovl_u16(vget_low_u16(hi)));
+	vst1q_u32(target + 12, vmovl_high_u16(hi));
+	return true;
+}
 
-mat4 mat4_transformation(vec3 offset, quat rotation, vec3 scale) {
-	vec3 axis_x, axis_y, axis_z;
-	quat_get_axes(rotation, &axis_x, &axis_y, &axis_z);
-	axis_x = vec3_muls(axis_x, scale.x);
-	axis_y = vec3_muls(axis_y, scale.y);
-	axis_z = vec3_muls(axis_z, scale.z);
-	return (mat4){
-		{axis_x.x, axis_x.y, axis_x.z, 0},
-		{axis_y.x, axis_y.y, axis_y.z, 0},
-		{axis_z.x, axis_z.y, axis_z.z, 0},
-		{offset.x, offset.y, offset.z, 1},
-	};
+AttrFileLocal()
+bool simd_utf_narrow_16_8(u16 const * source, u8 * target) {
+	uint16x8_t const v0 = vld1q_u16(source + 0);
+	uint16x8_t const v1 = vld1q_u16(source + 8);
+	if (vmaxvq_u16(vorrq_u16(v0, v1)) >= 0x80) return false;
+	vst1q_u8(target, vcombine_u8(vmovn_u16(v0), vmovn_u16(v1)));
+	return true;
 }
 
-mat4 mat4_transformation_inverse(vec3 offset, quat rotation, vec3 scale) {
-	vec3 axis_x, axis_y, axis_z;
-	quat_get_axes(rotation, &axis_x, &axis_y, &axis_z);
-	axis_x = vec3_muls(axis_x, scale.x);
-	axis_y = vec3_muls(axis_y, scale.y);
-	axis_z = vec3_muls(axis_z, scale.z);
-	return (mat4){
-		// @note inverse rotation matrix is its transposition
-		{axis_x.x, axis_y.x, axis_z.x, 0},
-		{axis_x.y, axis_y.y, axis_z.y, 0},
-		{axis_x.z, axis_y.z, axis_z.z, 0},
-		{ // @note inverse offset in inverted coordinates space
-			-vec3_dot(offset, axis_x),
-			-vec3_dot(offset, axis_y),
-			-vec3_dot(offset, axis_z),
-			1
-		},
-	};
+AttrFileLocal()
+bool simd_utf_narrow_32_8(u32 const * source, u8 * target) {
+	uint32x4_t const v0 = vld1q_u32(source +  0);
+	uint32x4_t const v1 = vld1q_u32(source +  4);
+	uint32x4_t const v2 = vld1q_u32(source +  8);
+	uint32x4_t const v3 = vld1q_u32(source + 12);
+	if (vmaxvq_u32(vorrq_u32(vorrq_u32(v0, v1), vorrq_u32(v2, v3))) >= 0x80) return false;
+	uint16x8_t const lo = vcombine_u16(vmovn_u32(v0), vmovn_u32(v1));
+	uint16x8_t const hi = vcombine_u16(vmovn_u32(v2), vmovn_u32(v3));
+	vst1q_u8(target, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+	return true;
 }
 
-mat4 mat4_invert_transformation(mat4 transformation) {
-	vec3 const position = (vec3){transformation.w.x, transformation.w.y, transformation.w.z};
-	return (mat4){
-		{transformation.x.x, transformation.y.x, transformation.z.x, 0},
-		{transformation.x.y, transformation.y.y, transformation.z.y, 0},
-		{transformation.x.z, transformation.y.z, transformation.z.z, 0},
-		{
-			-vec3_dot(position, (vec3){transformation.x.x, transformation.x.y, transformation.x.z}),
-			-vec3_dot(position, (vec3){transformation.y.x, transformation.y.y, transformation.y.z}),
-			-vec3_dot(position, (vec3){transformation.z.x, transformation.z.y, transformation.z.z}),
-			1
-		},
-	};
+AttrFileLocal()
+bool simd_utf_widen_16_32(u16 const * source, u32 * target) {
+	uint16x8_t const v0 = vld1q_u16(source + 0);
+	uint16x8_t const v1 = vld1q_u16(source + 8);
+	uint16x8_t const mask = vdupq_n_u16(0xf800);
+	uint16x8_t const surrogate = vdupq_n_u16(0xd800);
+	uint16x8_t const hits = vorrq_u16(
+		vceqq_u16(vandq_u16(v0, mask), surrogate),
+		vceqq_u16(vandq_u16(v1, mask), surrogate)
+	);
+	if (vmaxvq_u16(hits) != 0) return false;
+	vst1q_u32(target +  0, vmovl_u16(vget_low_u16(v0)));
+	vst1q_u32(target +  4, vmovl_high_u16(v0));
+	vst1q_u32(target +  8, vmovl_u16(vget_low_u16(v1)));
+	vst1q_u32(target + 12, vmovl_high_u16(v1));
+	return true;
 }
 
-mat4 mat4_projection(
-	vec2 scale_xy, vec2 offset_xy, f32 ortho,
-	f32 view_near, f32 view_far,
-	f32 ndc_near,  f32 ndc_far
-) {
-	float const reverse_depth = 1 / (view_far - view_near);
+AttrFileLocal()
+bool simd_utf_narrow_32_16(u32 const * source, u16 * target) {
+	uint32x4_t const v0 = vld1q_u32(source +  0);
+	uint32x4_t const v1 = vld1q_u32(source +  4);
+	uint32x4_t const v2 = vld1q_u32(source +  8);
+	uint32x4_t const v3 = vld1q_u32(source + 12);
+	if (vmaxvq_u32(vorrq_u32(vorrq_u32(v0, v1), vorrq_u32(v2, v3))) > 0xffff) return false;
+	uint32x4_t const mask = vdupq_n_u32(0xf800);
+	uint32x4_t const surrogate = vdupq_n_u32(0xd800);
+	uint32x4_t const hits = vorrq_u32(
+		vorrq_u32(
+			vceqq_u32(vandq_u32(v0, mask), surrogate),
+			vceqq_u32(vandq_u32(v1, mask), surrogate)
+		),
+		vorrq_u32(
+			vceqq_u32(vandq_u32(v2, mask), surrogate),
+			vceqq_u32(vandq_u32(v3, mask), surrogate)
+		)
+	);
+	if (vmaxvq_u32(hits) != 0) return false;
+	vst1q_u16(target + 0, vcombine_u16(vmovn_u32(v0), vmovn_u32(v1)));
+	vst1q_u16(target + 8, vcombine_u16(vmovn_u32(v2), vmovn_u32(v3)));
+	return true;
+}
+#endif
 
-	float const persp_scale_z  = inf32(view_far) ? ndc_far                            : (reverse_depth * (ndc_far * view_far - ndc_near * view_near));
-	float const persp_offset_z = inf32(view_far) ? ((ndc_near - ndc_far) * view_near) : (reverse_depth * (ndc_near - ndc_far) * view_near * view_far);
+AttrFileLocal()
+bool codepoint_is_valid(u32 value) {
+	return value <= 0x10ffff && (value < 0xd800 || value > 0xdfff);
+}
 
-	float const ortho_scale_z  = inf32(view_far) ? 0        : (reverse_depth * (ndc_far - ndc_near));
-	float const ortho_offset_z = inf32(view_far) ? ndc_near : (reverse_depth * (ndc_near * view_far - ndc_far * view_near));
+AttrFileLocal()
+size_t utf8_decode(u8 const * buffer, size_t count, u32 * out) {
+	// @note returns the consumed length, `0` for malformed or overlong sequences
+	u8 const lead = buffer[0];
+	if (lead < 0x80) { *out = lead; return 1; }
+
+	size_t length; u32 value, minimum;
+	if      ((lead & 0xe0) == 0xc0) { length = 2; value = lead & 0x1f; minimum = 0x80; }
+	else if ((lead & 0xf0) == 0xe0) { length = 3; value = lead & 0x0f; minimum = 0x800; }
+	else if ((lead & 0xf8) == 0xf0) { length = 4; value = lead & 0x07; minimum = 0x10000; }
+	else return 0;
+
+	if (length > count) return 0;
+	for (size_t i = 1; i < length; i++) {
+		if ((buffer[i] & 0xc0) != 0x80) return 0;
+		value = (value << 6) | (buffer[i] & 0x3fu);
+	}
+	if (value < minimum || !codepoint_is_valid(value)) return 0;
+	*out = value;
+	return length;
+}
 
-	float const scale_z  = lerp32(persp_scale_z,  ortho_scale_z,  ortho);
-	float const offset_z = lerp32(persp_offset_z, ortho_offset_z, ortho);
-	float const zw = 1 - ortho;
-	float const ww = ortho;
+AttrFileLocal()
+size_t utf8_encode(u32 value, u8 * buffer) {
+	if (value < 0x80) {
+		buffer[0] = (u8)value;
+		return 1;
+	}
+	if (value < 0x800) {
+		buffer[0] = (u8)(0xc0 | (value >> 6));
+		buffer[1] = (u8)(0x80 | (value & 0x3f));
+		return 2;
+	}
+	if (value < 0x10000) {
+		buffer[0] = (u8)(0xe0 | (value >> 12));
+		buffer[1] = (u8)(0x80 | ((value >> 6) & 0x3f));
+		buffer[2] = (u8)(0x80 | (value & 0x3f));
+		return 3;
+	}
+	buffer[0] = (u8)(0xf0 | (value >> 18));
+	buffer[1] = (u8)(0x80 | ((value >> 12) & 0x3f));
+	buffer[2] = (u8)(0x80 | ((value >> 6) & 0x3f));
+	buffer[3] = (u8)(0x80 | (value & 0x3f));
+	return 4;
+}
 
-	return (mat4){
-		{scale_xy.x,  0,           0,         0},
-		{0,           scale_xy.y,  0,         0},
-		{0,           0,           scale_z,  zw},
-		{offset_xy.x, offset_xy.y, offset_z, ww},
-	};
+AttrFileLocal()
+size_t utf16_decode(u16 const * buffer, size_t count, u32 * out) {
+	// @note returns the consumed length, `0` for unpaired surrogates
+	u16 const lead = buffer[0];
+	if (lead < 0xd800 || lead > 0xdfff) { *out = lead; return 1; }
+	if (lead > 0xdbff || count < 2) return 0;
+	u16 const trail = buffer[1];
+	if (trail < 0xdc00 || trail > 0xdfff) return 0;
+	*out = 0x10000 + (((u32)lead - 0xd800) << 10) + ((u32)trail - 0xdc00);
+	return 2;
+}
 
-/*
-@info projection matrix
+AttrFileLocal()
+size_t utf16_encode(u32 value, u16 * buffer) {
+	if (value < 0x10000) {
+		buffer[0] = (u16)value;
+		return 1;
+	}
+	value -= 0x10000;
+	buffer[0] = (u16)(0xd800 | (value >> 10));
+	buffer[1] = (u16)(0xdc00 | (value & 0x3ff));
+	return 2;
+}
 
-> aim:
-map [-pos_xy   .. pos_xy]   -> [-1       .. 1]
-map [view_near .. view_far] -> [ndc_near .. ndc_far]
+str16 str16_from_str8(struct Memory_Arena * arena, str8 value) {
+	size_t const capacity = value.count + 1;
+	u16 * buffer = MemoryArenaPushArray(arena, u16, capacity);
+	size_t i = 0, o = 0;
+	while (i < value.count) {
+#if SIMD_UTF
+		for (; i + 16 <= value.count; i += 16, o += 16)
+			if (!simd_utf_widen_8_16(value.buffer + i, buffer + o)) break;
+#endif
+		for (size_t const block_end = min_size(i + 16, value.count); i < block_end;) {
+			u32 codepoint;
+			size_t const length = utf8_decode(value.buffer + i, value.count - i, &codepoint);
+			if (length == 0) {
+				memory_arena_pop(arena, sizeof(*buffer) * capacity);
+				return (str16){0};
+			}
+			i += length;
+			o += utf16_encode(codepoint, buffer + o);
+		}
+	}
+	buffer[o] = 0;
+	memory_arena_pop(arena, sizeof(*buffer) * (capacity - o - 1));
+	return (str16){.count = o, .buffer = buffer};
+}
 
-> known params (aspect correction)
-scale_XY = {height / width, 1} / tan(FoV / 2) or {1, width / height} / tan(FoV / 2)
-offset_XY = {0, 0}, i.e. the screen center
+str32 str32_from_str8(struct Memory_Arena * arena, str8 value) {
+	size_t const capacity = value.count + 1;
+	u32 * buffer = MemoryArenaPushArray(arena, u32, capacity);
+	size_t i = 0, o = 0;
+	while (i < value.count) {
+#if SIMD_UTF
+		for (; i + 16 <= value.count; i += 16, o += 16)
+			if (!simd_utf_widen_8_32(value.buffer + i, buffer + o)) break;
+#endif
+		for (size_t const block_end = min_size(i + 16, value.count); i < block_end;) {
+			size_t const length = utf8_decode(value.buffer + i, value.count - i, buffer + o);
+			if (length == 0) {
+				memory_arena_pop(arena, sizeof(*buffer) * capacity);
+				return (str32){0};
+			}
+			i += length;
+			o += 1;
+		}
+	}
+	buffer[o] = 0;
+	memory_arena_pop(arena, sizeof(*buffer) * (capacity - o - 1));
+	return (str32){.count = o, .buffer = buffer};
+}
 
-> known params (direct mapping from bottom-left to top-right)
-scale_XY = {2 / width, 2 / height}
-offset = {-1, -1}
+str8 str8_from_str16(struct Memory_Arena * arena, str16 value) {
+	size_t const capacity = value.count * 3 + 1;
+	u8 * buffer = MemoryArenaPushArray(arena, u8, capacity);
+	size_t i = 0, o = 0;
+	while (i < value.count) {
+#if SIMD_UTF
+		for (; i + 16 <= value.count; i += 16, o += 16)
+			if (!simd_utf_narrow_16_8(value.buffer + i, buffer + o)) break;
+#endif
+		for (size_t const block_end = min_size(i + 16, value.count); i < block_end;) {
+			u32 codepoint;
+			size_t const length = utf16_decode(value.buffer + i, value.count - i, &codepoint);
+			if (length == 0) {
+				memory_arena_pop(arena, sizeof(*buffer) * capacity);
+				return (str8){0};
+			}
+			i += length;
+			o += utf8_encode(codepoint, buffer + o);
+		}
+	}
+	buffer[o] = 0;
+	memory_arena_pop(arena, sizeof(*buffer) * (capacity - o - 1));
+	return (str8){.count = o, .buffer = buffer};
+}
 
-> orthograhic: NDC = XYZ * scale + offset
-Sz = (ndc_far - ndc_near) / (view_far - view_near)
-   ~ 0 ; !IF! view_far == infinity
-Oz = (ndc_near * view_far - ndc_far * view_near) / (view_far - view_near)
-   ~ ndc_near ; !IF! view_far == infinity
-| Sx  0   0  Ox |    | x |    | x * Sx + Ox |
-| 0   Sy  0  Oy | \/ | y | == | y * Sy + Oy |
-| 0   0   Sz Oz | /\ | z | == | z * Sz + Oz |
-| 0   0   0  1  |    | 1 |    | 1           |
+str32 str32_from_str16(struct Memory_Arena * arena, str16 value) {
+	size_t const capacity = value.count + 1;
+	u32 * buffer = MemoryArenaPushArray(arena, u32, capacity);
+	size_t i = 0, o = 0;
+	while (i < value.count) {
+#if SIMD_UTF
+		for (; i + 16 <= value.count; i += 16, o += 16)
+			if (!simd_utf_widen_16_32(value.buffer + i, buffer + o)) break;
+#endif
+		for (size_t const block_end = min_size(i + 16, value.count); i < block_end;) {
+			size_t const length = utf16_decode(value.buffer + i, value.count - i, buffer + o);
+			if (length == 0) {
+				memory_arena_pop(arena, sizeof(*buffer) * capacity);
+				return (str32){0};
+			}
+			i += length;
+			o += 1;
+		}
+	}
+	buffer[o] = 0;
+	memory_arena_pop(arena, sizeof(*buffer) * (capacity - o - 1));
+	return (str32){.count = o, .buffer = buffer};
+}
 
-> perspective: NDC = (XYZ * scale + offset) / z
-Sz = (ndc_far * view_far - ndc_near * view_near) / (view_far - view_near)
-   ~ ndc_far ; !IF! view_far == infinity
-Oz = (ndc_near - ndc_far) * view_near * view_far / (view_far - view_near)
-   ~ (ndc_near - ndc_far) * view_near ; !IF! view_far == infinity
-| Sx  0   0  Ox |    | x |    | x * Sx + Ox |
-| 0   Sy  0  Oy | \/ | y | == | y * Sy + Oy |
-| 0   0   Sz Oz | /\ | z | == | z * Sz + Oz |
-| 0   0   1  0  |    | 1 |    | z           |
-*/
+str8 str8_from_str32(struct Memory_Arena * arena, str32 value) {
+	size_t const capacity = value.count * 4 + 1;
+	u8 * buffer = MemoryArenaPushArray(arena, u8, capacity);
+	size_t i = 0, o = 0;
+	while (i < value.count) {
+#if SIMD_UTF
+		for (; i + 16 <= value.count; i += 16, o += 16)
+			if (!simd_utf_narrow_32_8(value.buffer + i, buffer + o)) break;
+#endif
+		for (size_t const block_end = min_size(i + 16, value.count); i < block_end; i++) {
+			u32 const codepoint = value.buffer[i];
+			if (!codepoint_is_valid(codepoint)) {
+				memory_arena_pop(arena, sizeof(*buffer) * capacity);
+				return (str8){0};
+			}
+			o += utf8_encode(codepoint, buffer + o);
+		}
+	}
+	buffer[o] = 0;
+	memory_arena_pop(arena, sizeof(*buffer) * (capacity - o - 1));
+	return (str8){.count = o, .buffer = buffer};
+}
+
+str16 str16_from_str32(struct Memory_Arena * arena, str32 value) {
+	size_t const capacity = value.count * 2 + 1;
+	u16 * buffer = MemoryArenaPushArray(arena, u16, capacity);
+	size_t i = 0, o = 0;
+	while (i < value.count) {
+#if SIMD_UTF
+		for (; i + 16 <= value.count; i += 16, o += 16)
+			if (!simd_utf_narrow_32_16(value.buffer + i, buffer + o)) break;
+#endif
+		for (size_t const block_end = min_size(i + 16, value.count); i < block_end; i++) {
+			u32 const codepoint = value.buffer[i];
+			if (!codepoint_is_valid(codepoint)) {
+				memory_arena_pop(arena, sizeof(*buffer) * capacity);
+				return (str16){0};
+			}
+			o += utf16_encode(codepoint, buffer + o);
+		}
+	}
+	buffer[o] = 0;
+	memory_arena_pop(arena, sizeof(*buffer) * (capacity - o - 1));
+	return (str16){.count = o, .buffer = buffer};
 }
 
 // ---- ---- ---- ----
-// functions: s32 math, vector
+// functions: table
+// ---- ---- ---- ----
+
+enum Hash_Map_Mark {
+	HASH_MAP_MARK_NONE,
+	HASH_MAP_MARK_FULL,
+	HASH_MAP_MARK_SKIP,
+};
+
+AttrFileLocal()
+size_t hash_map_find_index(struct Hash_Map const * inst, void const * key) {
+	size_t empty = SIZE_MAX;
+	if (inst->count >= inst->capacity)
+		return empty;
+
+	u32 const hash = inst->hash(key);
+	size_t const mask = inst->capacity - 1;
+	size_t const base = hash & mask;
+	for (size_t i = 0; i < inst->capacity; i++) {
+		size_t const index = (base + i) & mask;
+		u8 const mark = inst->marks[index];
+		if (mark == HASH_MAP_MARK_FULL) {
+			void const * hash_map_key = (u8*)inst->keys + index * inst->key_size;
+			u32  const   hash_map_hash = inst->hash(hash_map_key);
+			if (hash_map_hash == hash && mem_equals(hash_map_key, key, inst->key_size))
+				return index;
+		}
+		else {
+			if (empty == SIZE_MAX) empty = index;
+			if (mark == HASH_MAP_MARK_NONE) break;
+		}
+	}
+
+	return empty;
+}
+
+struct Hash_Map hash_map_init(Hash32 * hash, size_t key_size, size_t val_size) {
+	struct Hash_Map table = {.hash = hash, .key_size = key_size, .val_size = val_size};
+	return table;
+}
+
+void hash_map_free(struct Hash_Map * inst) {
+	os_memory_heap(inst->keys, 0);
+	os_memory_heap(inst->vals, 0);
+	os_memory_heap(inst->marks, 0);
+	mem_zero(inst, sizeof(*inst));
+}
+
+void hash_map_arena(struct Hash_Map * inst, struct Memory_Arena * arena, size_t count) {
+	AttrFuncLocal() size_t const mark_size = sizeof(*inst->marks);
+	inst->capacity = next_po2_size(count);
+	inst->keys  = memory_arena_push(arena, inst->capacity * inst->key_size, /*align*/ clamp_size(inst->key_size, sizeof(u8), sizeof(u64)));
+	inst->vals  = memory_arena_push(arena, inst->capacity * inst->val_size, /*align*/ clamp_size(inst->val_size, sizeof(u8), sizeof(u64)));
+	inst->marks = memory_arena_push(arena, inst->capacity * mark_size,      /*align*/ clamp_size(mark_size,      sizeof(u8), sizeof(u64)));
+	// @note arenas hand out used memory just as well
+	mem_zero(inst->marks, inst->capacity * mark_size);
+	inst->count = 0;
+}
+
+void hash_map_resize(struct Hash_Map * inst, size_t target_count) {
+	AttrFuncLocal() size_t const mark_size = sizeof(*inst->marks);
+	size_t const prev_capacity = inst->capacity;
+
+	void * keys = inst->keys;
+	void * vals = inst->vals;
+	u8   * marks = inst->marks;
+
+	inst->capacity = next_po2_size(target_count); inst->count = 0;
+	inst->keys  = os_memory_heap(NULL, inst->capacity * inst->key_size);
+	inst->vals  = os_memory_heap(NULL, inst->capacity * inst->val_size);
+	inst->marks = os_memory_heap(NULL, inst->capacity * mark_size);
+
+	for (size_t i = 0; i < prev_capacity; i++) {
+		if (marks[i] != HASH_MAP_MARK_FULL)
+			continue;
+		void const * key  = (u8*)keys + i * inst->key_size;
+		void const * val  = (u8*)vals + i * inst->val_size;
+		hash_map_set(inst, key, val);
+	}
+
+	os_memory_heap(keys, 0);
+	os_memory_heap(vals, 0);
+	os_memory_heap(marks, 0);
+}
+
+void * hash_map_get(struct Hash_Map * inst, void const * key) {
+	size_t const index = hash_map_find_index(inst, key);
+	if (index < inst->capacity && inst->marks[index] == HASH_MAP_MARK_FULL)
+		return (u8*)inst->vals + index * inst->val_size;
+	return NULL;
+}
+
+void hash_map_set(struct Hash_Map * inst, void const * key, void const * val) {
+	if (inst->count >= inst->capacity * 2 / 3)
+		hash_map_resize(inst, inst->capacity * 2);
+	size_t const index = hash_map_find_index(inst, key);
+	Assert(index < inst->capacity, "[base] overflow");
+	mem_copy(key, (u8*)inst->keys + index * inst->key_size, inst->key_size);
+	mem_copy(val, (u8*)inst->vals + index * inst->val_size, inst->val_size);
+	inst->count += (inst->marks[index] != HASH_MAP_MARK_FULL);
+	inst->marks[index] = HASH_MAP_MARK_FULL;
+}
+
+void hash_map_remove(struct Hash_Map * inst, void const * key) {
+	size_t const index = hash_map_find_index(inst, key);
+	Assert(index < inst->capacity, "[base] overflow");
+	if (inst->marks[index] == HASH_MAP_MARK_FULL) {
+		inst->marks[index] = HASH_MAP_MARK_SKIP;
+		inst->count--;
+	}
+}
+
+// ---- ---- ---- ----
+// functions: f32 math, vector
+// ---- ---- ---- ----
+
+vec2 vec2_add(vec2 l, vec2 r) { return (vec2){l.x + r.x, l.y + r.y}; }
+vec2 vec2_sub(vec2 l, vec2 r) { return (vec2){l.x - r.x, l.y - r.y}; }
+vec2 vec2_mul(vec2 l, vec2 r) { return (vec2){l.x * r.x, l.y * r.y}; }
+vec2 vec2_div(vec2 l, vec2 r) { return (vec2){l.x / r.x, l.y / r.y}; }
+f32  vec2_dot(vec2 l, vec2 r) { return l.x * r.x + l.y * r.y; }
+vec2 vec2_muls(vec2 l, f32 r) { return (vec2){l.x * r, l.y * r}; }
+vec2 vec2_divs(vec2 l, f32 r) { return (vec2){l.x / r, l.y / r}; }
+
+vec3 vec3_add(vec3 l, vec3 r) { return (vec3){l.x + r.x, l.y + r.y, l.z + r.z}; }
+vec3 vec3_sub(vec3 l, vec3 r) { return (vec3){l.x - r.x, l.y - r.y, l.z - r.z}; }
+vec3 vec3_mul(vec3 l, vec3 r) { return (vec3){l.x * r.x, l.y * r.y, l.z * r.z}; }
+vec3 vec3_div(vec3 l, vec3 r) { return (vec3){l.x / r.x, l.y / r.y, l.z / r.z}; }
+f32  vec3_dot(vec3 l, vec3 r) { return l.x * r.x + l.y * r.y + l.z * r.z; }
+vec3 vec3_muls(vec3 l, f32 r) { return (vec3){l.x * r, l.y * r, l.z * r}; }
+vec3 vec3_divs(vec3 l, f32 r) { return (vec3){l.x / r, l.y / r, l.z / r}; }
+
+vec4 vec4_add(vec4 l, vec4 r) { return (vec4){l.x + r.x, l.y + r.y, l.z + r.z, l.w + r.w}; }
+vec4 vec4_sub(vec4 l, vec4 r) { return (vec4){l.x - r.x, l.y - r.y, l.z - r.z, l.w - r.w}; }
+vec4 vec4_mul(vec4 l, vec4 r) { return (vec4){l.x * r.x, l.y * r.y, l.z * r.z, l.w * r.w}; }
+vec4 vec4_div(vec4 l, vec4 r) { return (vec4){l.x / r.x, l.y / r.y, l.z / r.z, l.w / r.w}; }
+f32  vec4_dot(vec4 l, vec4 r) { return l.x * r.x + l.y * r.y + l.z * r.z + l.w * r.w; }
+vec4 vec4_muls(vec4 l, f32 r) { return (vec4){l.x * r, l.y * r, l.z * r, l.w * r}; }
+vec4 vec4_divs(vec4 l, f32 r) { return (vec4){l.x / r, l.y / r, l.z / r, l.w / r}; }
+
+f32  vec2_crs(vec2 l, vec2 r) { return l.x * r.y - l.y * r.x; }
+vec3 vec3_crs(vec3 l, vec3 r) { return (vec3){
+	l.y * r.z - l.z * r.y,
+	l.z * r.x - l.x * r.z,
+	l.x * r.y - l.y * r.x,
+}; }
+
+// ---- ---- ---- ----
+// functions: f32 math, simd
+// ---- ---- ---- ----
+
+/*
+@note kernels repeat the scalar operations lane-wise in the same order and
+without fused multiply-add, so that results stay bit-identical to the scalar code;
+signs are flipped via the sign bit, as `a - b` equals `a + (-b)` exactly
+*/
+
+#if SIMD_SSE2
+typedef __m128 f32x4;
+# define f32x4_load(ptr)         _mm_loadu_ps(ptr)
+# define f32x4_store(ptr, value) _mm_storeu_ps(ptr, value)
+# define f32x4_set(x, y, z, w)   _mm_setr_ps(x, y, z, w)
+# define f32x4_splat(value)      _mm_set1_ps(value)
+# define f32x4_add(l, r)         _mm_add_ps(l, r)
+# define f32x4_sub(l, r)         _mm_sub_ps(l, r)
+# define f32x4_mul(l, r)         _mm_mul_ps(l, r)
+# define f32x4_div(l, r)         _mm_div_ps(l, r)
+# define f32x4_max(l, r)         _mm_max_ps(l, r)
+# define f32x4_min(l, r)         _mm_min_ps(l, r)
+# define f32x4_sqrt(value)       _mm_sqrt_ps(value)
+# define f32x4_lane(v, i)        _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+# define f32x4_first(v)          _mm_cvtss_f32(v)
+# define f32x4_swizzle(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+# define f32x4_flip(v, x, y, z, w) _mm_xor_ps(v, _mm_setr_ps( \
+	(x) ? -0.0f : 0.0f, (y) ? -0.0f : 0.0f, (z) ? -0.0f : 0.0f, (w) ? -0.0f : 0.0f))
+#elif SIMD_NEON
+typedef float32x4_t f32x4;
+# define f32x4_load(ptr)         vld1q_f32(ptr)
+# define f32x4_store(ptr, value) vst1q_f32(ptr, value)
+# define f32x4_set(x, y, z, w)   f32x4_set_neon(x, y, z, w)
+# define f32x4_splat(value)      vdupq_n_f32(value)
+# define f32x4_add(l, r)         vaddq_f32(l, r)
+# define f32x4_sub(l, r)         vsubq_f32(l, r)
+# define f32x4_mul(l, r)         vmulq_f32(l, r)
+# define f32x4_div(l, r)         vdivq_f32(l, r)
+# define f32x4_max(l, r)         vmaxq_f32(l, r)
+# define f32x4_min(l, r)         vminq_f32(l, r)
+# define f32x4_sqrt(value)       vsqrtq_f32(value)
+# define f32x4_lane(v, i)        vdupq_laneq_f32(v, i)
+# define f32x4_first(v)          vgetq_lane_f32(v, 0)
+# define f32x4_swizzle(v, x, y, z, w) vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(v), (uint8x16_t){ \
+	(x)*4, (x)*4+1, (x)*4+2, (x)*4+3, (y)*4, (y)*4+1, (y)*4+2, (y)*4+3,                               \
+	(z)*4, (z)*4+1, (z)*4+2, (z)*4+3, (w)*4, (w)*4+1, (w)*4+2, (w)*4+3}))
+# define f32x4_flip(v, x, y, z, w) vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), (uint32x4_t){ \
+	(x) ? 0x80000000u : 0, (y) ? 0x80000000u : 0, (z) ? 0x80000000u : 0, (w) ? 0x80000000u : 0}))
+
+AttrFileLocal()
+float32x4_t f32x4_set_neon(f32 x, f32 y, f32 z, f32 w) {
+	f32 const values[4] = {x, y, z, w};
+	return vld1q_f32(values);
+}
+#endif
+
+#if SIMD_SSE2 || SIMD_NEON
+# define SIMD_F32X4 1
+
+AttrFileLocal()
+f32x4 f32x4_mat4_mul_vec(f32x4 const * l, f32x4 r) {
+	// @note `l` are matrix columns
+	f32x4 ret =  f32x4_mul(l[0], f32x4_lane(r, 0));
+	ret = f32x4_add(ret, f32x4_mul(l[1], f32x4_lane(r, 1)));
+	ret = f32x4_add(ret, f32x4_mul(l[2], f32x4_lane(r, 2)));
+	ret = f32x4_add(ret, f32x4_mul(l[3], f32x4_lane(r, 3)));
+	return ret;
+}
+
+AttrFileLocal()
+void f32x4_load_mat4(mat4 const * value, f32x4 * columns) {
+	columns[0] = f32x4_load(&value->x.x);
+	columns[1] = f32x4_load(&value->y.x);
+	columns[2] = f32x4_load(&value->z.x);
+	columns[3] = f32x4_load(&value->w.x);
+}
+
+AttrFileLocal()
+f32x4 f32x4_crs(f32x4 l, f32x4 r) {
+	return f32x4_sub(
+		f32x4_mul(f32x4_swizzle(l, 1, 2, 0, 3), f32x4_swizzle(r, 2, 0, 1, 3)),
+		f32x4_mul(f32x4_swizzle(l, 2, 0, 1, 3), f32x4_swizzle(r, 1, 2, 0, 3))
+	);
+}
+
+AttrFileLocal()
+void f32x4_transpose(f32x4 * rows) {
+#if SIMD_SSE2
+	_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+#else
+	float32x4x2_t const t01 = vtrnq_f32(rows[0], rows[1]);
+	float32x4x2_t const t23 = vtrnq_f32(rows[2], rows[3]);
+	rows[0] = vcombine_f32(vget_low_f32(t01.val[0]),  vget_low_f32(t23.val[0]));
+	rows[1] = vcombine_f32(vget_low_f32(t01.val[1]),  vget_low_f32(t23.val[1]));
+	rows[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+	rows[3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#endif
+}
+
+AttrFileLocal()
+f32x4 f32x4_dot3_x4(f32x4 * products) {
+	// @note lane `i` is `products[i].x + products[i].y + products[i].z`, in that order
+	f32x4_transpose(products);
+	return f32x4_add(f32x4_add(products[0], products[1]), products[2]);
+}
+#else
+# define SIMD_F32X4 0
+#endif
+
+#if SIMD_AVX2
+AttrFileLocal()
+void f32x8_load_mat4(mat4 const * value, __m256 * columns) {
+	// @note each column is duplicated into both halves
+	columns[0] = _mm256_broadcast_ps((__m128 const *)(void const *)&value->x);
+	columns[1] = _mm256_broadcast_ps((__m128 const *)(void const *)&value->y);
+	columns[2] = _mm256_broadcast_ps((__m128 const *)(void const *)&value->z);
+	columns[3] = _mm256_broadcast_ps((__m128 const *)(void const *)&value->w);
+}
+
+AttrFileLocal()
+void f32x8_mat4_mul_mat(__m256 const * l, mat4 const * r, mat4 * target) {
+	// @note two columns per register
+	for (u32 i = 0; i < 2; i++) {
+		__m256 const rv = _mm256_loadu_ps(&r->x.x + i * 8);
+		__m256 col =        _mm256_mul_ps(l[0], _mm256_shuffle_ps(rv, rv, 0x00));
+		col = _mm256_add_ps(col, _mm256_mul_ps(l[1], _mm256_shuffle_ps(rv, rv, 0x55)));
+		col = _mm256_add_ps(col, _mm256_mul_ps(l[2], _mm256_shuffle_ps(rv, rv, 0xaa)));
+		col = _mm256_add_ps(col, _mm256_mul_ps(l[3], _mm256_shuffle_ps(rv, rv, 0xff)));
+		_mm256_storeu_ps(&target->x.x + i * 8, col);
+	}
+}
+#endif
+
+/*
+@note `f32xw` is the widest available vector, used by batch kernels over SoA data
+*/
+
+#if SIMD_AVX2
+# define F32XW_WIDTH 8
+typedef __m256 f32xw;
+# define f32xw_load(ptr)         _mm256_loadu_ps(ptr)
+# define f32xw_store(ptr, value) _mm256_storeu_ps(ptr, value)
+# define f32xw_splat(value)      _mm256_set1_ps(value)
+# define f32xw_add(l, r)         _mm256_add_ps(l, r)
+# define f32xw_mul(l, r)         _mm256_mul_ps(l, r)
+# define f32xw_div(l, r)         _mm256_div_ps(l, r)
+# define f32xw_max(l, r)         _mm256_max_ps(l, r)
+# define f32xw_sqrt(value)       _mm256_sqrt_ps(value)
+# define f32xw_sub(l, r)         _mm256_sub_ps(l, r)
+# define f32xw_xor(l, r)         _mm256_xor_ps(l, r)
+# define f32xw_gt(l, r)          _mm256_cmp_ps(l, r, _CMP_GT_OQ)
+# define f32xw_ge(l, r)          _mm256_cmp_ps(l, r, _CMP_GE_OQ)
+# define f32xw_and(l, r)         _mm256_and_ps(l, r)
+# define f32xw_mask(value)       (u32)_mm256_movemask_ps(value)
+# define f32xw_select(mask, l, r) _mm256_blendv_ps(r, l, mask)
+typedef __m256i s32xw;
+# define s32xw_load(ptr)         _mm256_loadu_si256((__m256i const *)(void const *)(ptr))
+# define s32xw_splat(value)      _mm256_set1_epi32(value)
+# define s32xw_add(l, r)         _mm256_add_epi32(l, r)
+# define s32xw_sub(l, r)         _mm256_sub_epi32(l, r)
+# define s32xw_and(l, r)         _mm256_and_si256(l, r)
+# define s32xw_or(l, r)          _mm256_or_si256(l, r)
+# define s32xw_shl(v, count)     _mm256_slli_epi32(v, count)
+# define s32xw_shr(v, count)     _mm256_srli_epi32(v, count)
+# define s32xw_xor(l, r)         _mm256_xor_si256(l, r)
+# define s32xw_mul(l, r)         _mm256_mullo_epi32(l, r)
+# define s32xw_truncate(value)   _mm256_cvttps_epi32(value)
+# define s32xw_bits(value)       _mm256_castps_si256(value)
+# define f32xw_bits(value)       _mm256_castsi256_ps(value)
+# define f32xw_convert(value)    _mm256_cvtepi32_ps(value)
+#elif SIMD_F32X4
+# define F32XW_WIDTH 4
+typedef f32x4 f32xw;
+# define f32xw_load(ptr)         f32x4_load(ptr)
+# define f32xw_store(ptr, value) f32x4_store(ptr, value)
+# define f32xw_splat(value)      f32x4_splat(value)
+# define f32xw_add(l, r)         f32x4_add(l, r)
+# define f32xw_mul(l, r)         f32x4_mul(l, r)
+# define f32xw_div(l, r)         f32x4_div(l, r)
+# define f32xw_max(l, r)         f32x4_max(l, r)
+# define f32xw_sqrt(value)       f32x4_sqrt(value)
+# define f32xw_sub(l, r)         f32x4_sub(l, r)
+# if SIMD_SSE2
+# define f32xw_xor(l, r)         _mm_xor_ps(l, r)
+# define f32xw_gt(l, r)          _mm_cmpgt_ps(l, r)
+# define f32xw_ge(l, r)          _mm_cmpge_ps(l, r)
+# define f32xw_and(l, r)         _mm_and_ps(l, r)
+# define f32xw_mask(value)       (u32)_mm_movemask_ps(value)
+# define f32xw_select(mask, l, r) _mm_or_ps(_mm_and_ps(mask, l), _mm_andnot_ps(mask, r))
+typedef __m128i s32xw;
+# define s32xw_load(ptr)         _mm_loadu_si128((__m128i const *)(void const *)(ptr))
+# define s32xw_splat(value)      _mm_set1_epi32(value)
+# define s32xw_add(l, r)         _mm_add_epi32(l, r)
+# define s32xw_sub(l, r)         _mm_sub_epi32(l, r)
+# define s32xw_and(l, r)         _mm_and_si128(l, r)
+# define s32xw_or(l, r)          _mm_or_si128(l, r)
+# define s32xw_shl(v, count)     _mm_slli_epi32(v, count)
+# define s32xw_shr(v, count)     _mm_srli_epi32(v, count)
+# define s32xw_xor(l, r)         _mm_xor_si128(l, r)
+# define s32xw_truncate(value)   _mm_cvttps_epi32(value)
+#  if SIMD_SSE4
+# define s32xw_mul(l, r)         _mm_mullo_epi32(l, r)
+#  else
+# define s32xw_mul(l, r)         s32x4_mul_sse2(l, r)
+
+AttrFileLocal()
+__m128i s32x4_mul_sse2(__m128i l, __m128i r) {
+	// @note low halves of even and odd lanes' products, interleaved back
+	__m128i const even = _mm_mul_epu32(l, r);
+	__m128i const odd  = _mm_mul_epu32(_mm_srli_si128(l, 4), _mm_srli_si128(r, 4));
+	return _mm_unpacklo_epi32(
+		_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+		_mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0))
+	);
+}
+#  endif
+# define s32xw_bits(value)       _mm_castps_si128(value)
+# define f32xw_bits(value)       _mm_castsi128_ps(value)
+# define f32xw_convert(value)    _mm_cvtepi32_ps(value)
+# else
+# define f32xw_xor(l, r)         vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(l), vreinterpretq_u32_f32(r)))
+# define f32xw_gt(l, r)          vreinterpretq_f32_u32(vcgtq_f32(l, r))
+# define f32xw_ge(l, r)          vreinterpretq_f32_u32(vcgeq_f32(l, r))
+# define f32xw_and(l, r)         vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(l), vreinterpretq_u32_f32(r)))
+# define f32xw_mask(value)       vaddvq_u32(vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(value), 31), (int32x4_t){0, 1, 2, 3}))
+# define f32xw_select(mask, l, r) vbslq_f32(vreinterpretq_u32_f32(mask), l, r)
+typedef int32x4_t s32xw;
+# define s32xw_load(ptr)         vld1q_s32((s32 const *)(void const *)(ptr))
+# define s32xw_splat(value)      vdupq_n_s32(value)
+# define s32xw_add(l, r)         vaddq_s32(l, r)
+# define s32xw_sub(l, r)         vsubq_s32(l, r)
+# define s32xw_and(l, r)         vandq_s32(l, r)
+# define s32xw_or(l, r)          vorrq_s32(l, r)
+# define s32xw_shl(v, count)     vshlq_n_s32(v, count)
+# define s32xw_shr(v, count)     vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), count))
+# define s32xw_xor(l, r)         veorq_s32(l, r)
+# define s32xw_mul(l, r)         vmulq_s32(l, r)
+# define s32xw_truncate(value)   vcvtq_s32_f32(value)
+# define s32xw_bits(value)       vreinterpretq_s32_f32(value)
+# define f32xw_bits(value)       vreinterpretq_f32_s32(value)
+# define f32xw_convert(value)    vcvtq_f32_s32(value)
+# endif
+#else
+# define F32XW_WIDTH 0
+#endif
+
+// ---- ---- ---- ----
+// functions: f32, fast
+// ---- ---- ---- ----
+
+/*
+@note adding `1.5 * 2^23` rounds to the nearest integer, which then lands
+in the low mantissa bits; both scalar and vector kernels rely on that,
+so there is no dependency on rounding instructions or modes
+*/
+
+#define FAST_ROUND        12582912.0f
+#define FAST_ROUND_BITS   0x4b400000
+
+// @note Cody-Waite split of `pi / 2`, leading parts multiply exactly
+#define FAST_2_OVER_PI    0.636619772367581343f
+#define FAST_PI_2_A       1.5703125f
+#define FAST_PI_2_B       4.837512969970703125e-4f
+#define FAST_PI_2_C       7.54978995489188216e-8f
+
+// @note minimax over `[-pi/4 .. pi/4]`
+#define FAST_SIN_1       -1.6666654611e-1f
+#define FAST_SIN_2        8.3321608736e-3f
+#define FAST_SIN_3       -1.9515295891e-4f
+#define FAST_COS_1        4.166664568298827e-2f
+#define FAST_COS_2       -1.388731625493765e-3f
+#define FAST_COS_3        2.443315711809948e-5f
+
+// @note minimax of `(2^x - 1) / x` over `[-0.5 .. 0.5]`
+#define FAST_EXP2_1       6.931472028550421e-1f
+#define FAST_EXP2_2       2.402264791363012e-1f
+#define FAST_EXP2_3       5.550332471162809e-2f
+#define FAST_EXP2_4       9.618437357674640e-3f
+#define FAST_EXP2_5       1.339887440266574e-3f
+#define FAST_EXP2_6       1.535336188319500e-4f
+
+// @note minimax of `(ln(1 + x) - x + x^2 / 2) / x^3` over `[sqrt(1/2) - 1 .. sqrt(2) - 1]`
+#define FAST_LOG_1        3.3333331174e-1f
+#define FAST_LOG_2       -2.4999993993e-1f
+#define FAST_LOG_3        2.0000714765e-1f
+#define FAST_LOG_4       -1.6668057665e-1f
+#define FAST_LOG_5        1.4249322787e-1f
+#define FAST_LOG_6       -1.2420140846e-1f
+#define FAST_LOG_7        1.1676998740e-1f
+#define FAST_LOG_8       -1.1514610310e-1f
+#define FAST_LOG_9        7.0376836292e-2f
+#define FAST_LOG2_E       1.44269504088896340736f
+#define FAST_SQRT_2       1.41421356237309504880f
+
+AttrFileLocal()
+f32 fast_reduce(f32 value, u32 * out_quadrant) {
+	bits32 const rounded = {.as_f = value * FAST_2_OVER_PI + FAST_ROUND};
+	f32 const n = rounded.as_f - FAST_ROUND;
+	*out_quadrant = rounded.as_u;
+	return ((value - n * FAST_PI_2_A) - n * FAST_PI_2_B) - n * FAST_PI_2_C;
+}
+
+AttrFileLocal()
+f32 fast_sin_poly(f32 r) {
+	f32 const z = r * r;
+	return r + r * z * (FAST_SIN_1 + z * (FAST_SIN_2 + z * FAST_SIN_3));
+}
+
+AttrFileLocal()
+f32 fast_cos_poly(f32 r) {
+	f32 const z = r * r;
+	return (1 - 0.5f * z) + z * z * (FAST_COS_1 + z * (FAST_COS_2 + z * FAST_COS_3));
+}
+
+AttrFileLocal()
+f32 fast_sin_quadrant(f32 r, u32 quadrant) {
+	// @note both branches are evaluated, as quadrants are unpredictable
+	f32 const s = fast_sin_poly(r);
+	f32 const c = fast_cos_poly(r);
+	bits32 ret = {.as_f = (quadrant & 1) ? c : s};
+	ret.as_u ^= (quadrant & 2) << 30;
+	return ret.as_f;
+}
+
+f32 sin32_fast(f32 value) {
+	u32 quadrant; f32 const r = fast_reduce(value, &quadrant);
+	return fast_sin_quadrant(r, quadrant);
+}
+
+f32 cos32_fast(f32 value) {
+	u32 quadrant; f32 const r = fast_reduce(value, &quadrant);
+	return fast_sin_quadrant(r, quadrant + 1);
+}
+
+f32 tan32_fast(f32 value) {
+	u32 quadrant; f32 const r = fast_reduce(value, &quadrant);
+	f32 const s = fast_sin_poly(r);
+	f32 const c = fast_cos_poly(r);
+	return (quadrant & 1) ? (-c / s) : (s / c);
+}
+
+f32 exp2_32_fast(f32 value) {
+	value = (value > -126.0f) ? value : -126.0f;
+	value = (127.0f > value) ? value : 127.0f;
+	bits32 const rounded = {.as_f = value + FAST_ROUND};
+	f32 const f = value - (rounded.as_f - FAST_ROUND);
+	f32 const p = 1 + f * (FAST_EXP2_1 + f * (FAST_EXP2_2 + f * (FAST_EXP2_3
+		+ f * (FAST_EXP2_4 + f * (FAST_EXP2_5 + f * FAST_EXP2_6)))));
+	bits32 const scale = {.as_u = (rounded.as_u - FAST_ROUND_BITS + 127) << 23};
+	return p * scale.as_f;
+}
+
+f32 log2_32_fast(f32 value) {
+	bits32 bits = {.as_f = value};
+	s32 e = (s32)(bits.as_u >> 23) - 127;
+	bits.as_u = (bits.as_u & 0x007fffff) | 0x3f800000;
+	u32 const above = bits.as_f > FAST_SQRT_2;
+	bits.as_u -= above << 23; e += (s32)above;
+	f32 const x = bits.as_f - 1;
+	f32 const z = x * x;
+	f32 const p = FAST_LOG_1 + x * (FAST_LOG_2 + x * (FAST_LOG_3 + x * (FAST_LOG_4
+		+ x * (FAST_LOG_5 + x * (FAST_LOG_6 + x * (FAST_LOG_7 + x * (FAST_LOG_8 + x * FAST_LOG_9)))))));
+	f32 const ln = x + (x * z * p - 0.5f * z);
+	return ln * FAST_LOG2_E + (f32)e;
+}
+
+f32 pow32_fast(f32 base, f32 exp) {
+	return exp2_32_fast(exp * log2_32_fast(base));
+}
+
+f32 eerp32_fast(f32 v1, f32 v2, f32 t) {
+	return v1 * exp2_32_fast(t * log2_32_fast(v2 / v1));
+}
+
+#if F32XW_WIDTH > 0
+AttrFileLocal()
+f32xw f32xw_fast_reduce(f32xw value, s32xw * out_quadrant) {
+	f32xw const round = f32xw_splat(FAST_ROUND);
+	f32xw const rounded = f32xw_add(f32xw_mul(value, f32xw_splat(FAST_2_OVER_PI)), round);
+	f32xw const n = f32xw_sub(rounded, round);
+	*out_quadrant = s32xw_bits(rounded);
+	value = f32xw_sub(value, f32xw_mul(n, f32xw_splat(FAST_PI_2_A)));
+	value = f32xw_sub(value, f32xw_mul(n, f32xw_splat(FAST_PI_2_B)));
+	value = f32xw_sub(value, f32xw_mul(n, f32xw_splat(FAST_PI_2_C)));
+	return value;
+}
+
+AttrFileLocal()
+f32xw f32xw_fast_sin_poly(f32xw r) {
+	f32xw const z = f32xw_mul(r, r);
+	f32xw p = f32xw_add(f32xw_splat(FAST_SIN_2), f32xw_mul(z, f32xw_splat(FAST_SIN_3)));
+	p = f32xw_add(f32xw_splat(FAST_SIN_1), f32xw_mul(z, p));
+	return f32xw_add(r, f32xw_mul(f32xw_mul(r, z), p));
+}
+
+AttrFileLocal()
+f32xw f32xw_fast_cos_poly(f32xw r) {
+	f32xw const z = f32xw_mul(r, r);
+	f32xw p = f32xw_add(f32xw_splat(FAST_COS_2), f32xw_mul(z, f32xw_splat(FAST_COS_3)));
+	p = f32xw_add(f32xw_splat(FAST_COS_1), f32xw_mul(z, p));
+	f32xw const head = f32xw_sub(f32xw_splat(1), f32xw_mul(f32xw_splat(0.5f), z));
+	return f32xw_add(head, f32xw_mul(f32xw_mul(z, z), p));
+}
+
+AttrFileLocal()
+f32xw f32xw_fast_sin_quadrant(f32xw r, s32xw quadrant) {
+	s32xw const odd = s32xw_sub(s32xw_splat(0), s32xw_and(quadrant, s32xw_splat(1)));
+	s32xw const sign = s32xw_shl(s32xw_and(quadrant, s32xw_splat(2)), 30);
+	f32xw const ret = f32xw_select(f32xw_bits(odd), f32xw_fast_cos_poly(r), f32xw_fast_sin_poly(r));
+	return f32xw_xor(ret, f32xw_bits(sign));
+}
+
+AttrFileLocal()
+f32xw f32xw_exp2_fast(f32xw value) {
+	f32xw const min = f32xw_splat(-126.0f), max = f32xw_splat(127.0f);
+	value = f32xw_select(f32xw_gt(value, min), value, min);
+	value = f32xw_select(f32xw_gt(max, value), value, max);
+	f32xw const round = f32xw_splat(FAST_ROUND);
+	f32xw const rounded = f32xw_add(value, round);
+	f32xw const f = f32xw_sub(value, f32xw_sub(rounded, round));
+	f32xw p =       f32xw_add(f32xw_splat(FAST_EXP2_5), f32xw_mul(f, f32xw_splat(FAST_EXP2_6)));
+	p = f32xw_add(f32xw_splat(FAST_EXP2_4), f32xw_mul(f, p));
+	p = f32xw_add(f32xw_splat(FAST_EXP2_3), f32xw_mul(f, p));
+	p = f32xw_add(f32xw_splat(FAST_EXP2_2), f32xw_mul(f, p));
+	p = f32xw_add(f32xw_splat(FAST_EXP2_1), f32xw_mul(f, p));
+	p = f32xw_add(f32xw_splat(1),           f32xw_mul(f, p));
+	s32xw const scale = s32xw_shl(s32xw_add(s32xw_sub(s32xw_bits(rounded), s32xw_splat(FAST_ROUND_BITS)), s32xw_splat(127)), 23);
+	return f32xw_mul(p, f32xw_bits(scale));
+}
+
+AttrFileLocal()
+f32xw f32xw_log2_fast(f32xw value) {
+	s32xw const bits = s32xw_bits(value);
+	s32xw e = s32xw_sub(s32xw_shr(bits, 23), s32xw_splat(127));
+	f32xw m = f32xw_bits(s32xw_or(s32xw_and(bits, s32xw_splat(0x007fffff)), s32xw_splat(0x3f800000)));
+	f32xw const above = f32xw_gt(m, f32xw_splat(FAST_SQRT_2));
+	m = f32xw_select(above, f32xw_bits(s32xw_sub(s32xw_bits(m), s32xw_splat(0x00800000))), m);
+	e = s32xw_sub(e, s32xw_bits(above));
+	f32xw const x = f32xw_sub(m, f32xw_splat(1));
+	f32xw const z = f32xw_mul(x, x);
+	f32xw p =       f32xw_add(f32xw_splat(FAST_LOG_8), f32xw_mul(x, f32xw_splat(FAST_LOG_9)));
+	p = f32xw_add(f32xw_splat(FAST_LOG_7), f32xw_mul(x, p));
+	p = f32xw_add(f32xw_splat(FAST_LOG_6), f32xw_mul(x, p));
+	p = f32xw_add(f32xw_splat(FAST_LOG_5), f32xw_mul(x, p));
+	p = f32xw_add(f32xw_splat(FAST_LOG_4), f32xw_mul(x, p));
+	p = f32xw_add(f32xw_splat(FAST_LOG_3), f32xw_mul(x, p));
+	p = f32xw_add(f32xw_splat(FAST_LOG_2), f32xw_mul(x, p));
+	p = f32xw_add(f32xw_splat(FAST_LOG_1), f32xw_mul(x, p));
+	f32xw const tail = f32xw_sub(f32xw_mul(f32xw_mul(x, z), p), f32xw_mul(f32xw_splat(0.5f), z));
+	f32xw const ln = f32xw_add(x, tail);
+	return f32xw_add(f32xw_mul(ln, f32xw_splat(FAST_LOG2_E)), f32xw_convert(e));
+}
+#endif
+
+void sin32_fast_batch(size_t count, f32 const * source, f32 * target) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		s32xw quadrant; f32xw const r = f32xw_fast_reduce(f32xw_load(source + i), &quadrant);
+		f32xw_store(target + i, f32xw_fast_sin_quadrant(r, quadrant));
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = sin32_fast(source[i]);
+}
+
+void cos32_fast_batch(size_t count, f32 const * source, f32 * target) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		s32xw quadrant; f32xw const r = f32xw_fast_reduce(f32xw_load(source + i), &quadrant);
+		f32xw_store(target + i, f32xw_fast_sin_quadrant(r, s32xw_add(quadrant, s32xw_splat(1))));
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = cos32_fast(source[i]);
+}
+
+void tan32_fast_batch(size_t count, f32 const * source, f32 * target) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		s32xw quadrant; f32xw const r = f32xw_fast_reduce(f32xw_load(source + i), &quadrant);
+		f32xw const odd = f32xw_bits(s32xw_sub(s32xw_splat(0), s32xw_and(quadrant, s32xw_splat(1))));
+		f32xw const s = f32xw_fast_sin_poly(r);
+		f32xw const c = f32xw_fast_cos_poly(r);
+		f32xw const num = f32xw_select(odd, f32xw_xor(c, f32xw_splat(-0.0f)), s);
+		f32xw const den = f32xw_select(odd, s, c);
+		f32xw_store(target + i, f32xw_div(num, den));
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = tan32_fast(source[i]);
+}
+
+void exp2_32_fast_batch(size_t count, f32 const * source, f32 * target) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH)
+		f32xw_store(target + i, f32xw_exp2_fast(f32xw_load(source + i)));
+#endif
+	for (; i < count; i++)
+		target[i] = exp2_32_fast(source[i]);
+}
+
+void log2_32_fast_batch(size_t count, f32 const * source, f32 * target) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH)
+		f32xw_store(target + i, f32xw_log2_fast(f32xw_load(source + i)));
+#endif
+	for (; i < count; i++)
+		target[i] = log2_32_fast(source[i]);
+}
+
+void pow32_fast_batch(size_t count, f32 const * base, f32 const * exp, f32 * target) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		f32xw const l = f32xw_log2_fast(f32xw_load(base + i));
+		f32xw_store(target + i, f32xw_exp2_fast(f32xw_mul(f32xw_load(exp + i), l)));
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = pow32_fast(base[i], exp[i]);
+}
+
+void eerp32_fast_batch(size_t count, f32 const * v1, f32 const * v2, f32 const * t, f32 * target) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		f32xw const from = f32xw_load(v1 + i);
+		f32xw const l = f32xw_log2_fast(f32xw_div(f32xw_load(v2 + i), from));
+		f32xw_store(target + i, f32xw_mul(from, f32xw_exp2_fast(f32xw_mul(f32xw_load(t + i), l))));
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = eerp32_fast(v1[i], v2[i], t[i]);
+}
+
+// ---- ---- ---- ----
+// functions: f32 math, quaternion
+// ---- ---- ---- ----
+
+quat quat_axis(vec3 axis, f32 radians) {
+	f32 const h = radians * 0.5f;
+	f32 const s = sin32(h);
+	f32 const c = cos32(h);
+	return (quat){axis.x * s, axis.y * s, axis.z * s, c};
+}
+
+quat quat_rotation(vec3 radians) {
+	vec3 const h = vec3_mul(radians, (vec3){0.5f, 0.5f, 0.5f});
+	vec3 const s = (vec3){sin32(h.x), sin32(h.y), sin32(h.z)};
+	vec3 const c = (vec3){cos32(h.x), cos32(h.y), cos32(h.z)};
+	float const sy_cx = s.y*c.x; float const cy_sx = c.y*s.x;
+	float const cy_cx = c.y*c.x; float const sy_sx = s.y*s.x;
+	return (quat){
+		sy_cx*s.z + cy_sx*c.z,
+		sy_cx*c.z - cy_sx*s.z,
+		cy_cx*s.z - sy_sx*c.z,
+		cy_cx*c.z + sy_sx*s.z,
+	};
+
+/*
+ret = quat_axis({0,1,0}, radians_y)
+    * quat_axis({1,0,0}, radians_x)
+    * quat_axis({0,0,1}, radians_z)
+*/
+}
+
+quat quat_mul(quat l, quat r) {
+#if SIMD_F32X4
+	f32x4 const lv = f32x4_load(&l.x);
+	f32x4 const rv = f32x4_load(&r.x);
+	f32x4 ret =  f32x4_flip(f32x4_mul(f32x4_lane(lv, 0), f32x4_swizzle(rv, 3, 2, 1, 0)), 0, 1, 0, 1);
+	ret = f32x4_add(ret, f32x4_flip(f32x4_mul(f32x4_lane(lv, 1), f32x4_swizzle(rv, 2, 3, 0, 1)), 0, 0, 1, 1));
+	ret = f32x4_add(ret, f32x4_flip(f32x4_mul(f32x4_lane(lv, 2), f32x4_swizzle(rv, 1, 0, 3, 2)), 1, 0, 0, 1));
+	ret = f32x4_add(ret, f32x4_mul(f32x4_lane(lv, 3), rv));
+	quat out; f32x4_store(&out.x, ret);
+	return out;
+#else
+	return (quat){
+		 l.x * r.w + l.y * r.z - l.z * r.y + l.w * r.x,
+		-l.x * r.z + l.y * r.w + l.z * r.x + l.w * r.y,
+		 l.x * r.y - l.y * r.x + l.z * r.w + l.w * r.z,
+		-l.x * r.x - l.y * r.y - l.z * r.z + l.w * r.w,
+	};
+#endif
+
+/*
+ret = (l_v + l_w)
+    * (r_v + r_w)
+
+ret = (l_v x r_v) + r_v * l_w + l_v * r_w
+    - (l_v . r_v)             + l_w * r_w
+*/
+}
+
+vec3 quat_transform(quat q, vec3 v) {
+#if SIMD_F32X4
+	f32x4 const qv = f32x4_load(&q.x);
+	f32x4 const vv = f32x4_set(v.x, v.y, v.z, 0);
+	f32x4 const cr = f32x4_crs(qv, vv);
+	f32x4 const ret = f32x4_add(vv, f32x4_mul(
+		f32x4_add(f32x4_crs(qv, cr), f32x4_mul(f32x4_lane(qv, 3), cr)),
+		f32x4_splat(2)
+	));
+	f32 out[4]; f32x4_store(out, ret);
+	return (vec3){out[0], out[1], out[2]};
+#else
+	vec3 const cr = vec3_crs((vec3){q.x, q.y, q.z}, v);
+	return (vec3){
+	//  v   + (q_v x cr                + q_w * cr)   * 2
+	/**/v.x + (q.y * cr.z - q.z * cr.y + q.w * cr.x) * 2,
+	/**/v.y + (q.z * cr.x - q.x * cr.z + q.w * cr.y) * 2,
+	/**/v.z + (q.x * cr.y - q.y * cr.x + q.w * cr.z) * 2,
+	};
+#endif
+
+/*
+ret = ( q_v + q_w)
+    * (   v +   0)
+    * (-q_v + q_w)
+    / ( q   . q  )
+
+ret = v
+    + (q_v x cr * 2)
+    + (q_w * cr * 2)
+*/
+}
+
+void quat_get_axes(vec4 q, vec3 * x, vec3 * y, vec3 * z) {
+	f32 const xx = q.x*q.x; f32 const xy = q.x*q.y; f32 const xz = q.x*q.z;
+	f32 const zw = q.z*q.w; f32 const yy = q.y*q.y; f32 const yz = q.y*q.z;
+	f32 const yw = q.y*q.w; f32 const wx = q.w*q.x; f32 const zz = q.z*q.z;
+	*x = (vec3){1 - (yy + zz) * 2,     (xy + zw) * 2,     (xz - yw) * 2};
+	*y = (vec3){    (xy - zw) * 2, 1 - (zz + xx) * 2,     (yz + wx) * 2};
+	*z = (vec3){    (xz + yw) * 2,     (yz - wx) * 2, 1 - (xx + yy) * 2};
+
+/*
+x = quat_transform(q, {1,0,0})
+y = quat_transform(q, {0,1,0})
+z = quat_transform(q, {0,0,1})
+*/
+}
+
+// ---- ---- ---- ----
+// functions: s32 math, matrix
+// ---- ---- ---- ----
+
+vec2 mat2_mul_vec(mat2 l, vec2 r) { return (vec2){
+	vec2_dot((vec2){l.x.x, l.y.x}, r),
+	vec2_dot((vec2){l.x.y, l.y.y}, r),
+}; }
+
+mat2 mat2_mul_mat(mat2 l, mat2 r) { return (mat2){
+	mat2_mul_vec(l, r.x),
+	mat2_mul_vec(l, r.y),
+}; }
+
+vec3 mat3_mul_vec(mat3 l, vec3 r) { return (vec3){
+	vec3_dot((vec3){l.x.x, l.y.x, l.z.x}, r),
+	vec3_dot((vec3){l.x.y, l.y.y, l.z.y}, r),
+	vec3_dot((vec3){l.x.z, l.y.z, l.z.z}, r),
+}; }
+
+mat3 mat3_mul_mat(mat3 l, mat3 r) { return (mat3){
+	mat3_mul_vec(l, r.x),
+	mat3_mul_vec(l, r.y),
+	mat3_mul_vec(l, r.z),
+}; }
+
+vec4 mat4_mul_vec(mat4 l, vec4 r) {
+#if SIMD_F32X4
+	f32x4 columns[4]; f32x4_load_mat4(&l, columns);
+	vec4 ret; f32x4_store(&ret.x, f32x4_mat4_mul_vec(columns, f32x4_load(&r.x)));
+	return ret;
+#else
+	return (vec4){
+		vec4_dot((vec4){l.x.x, l.y.x, l.z.x, l.w.x}, r),
+		vec4_dot((vec4){l.x.y, l.y.y, l.z.y, l.w.y}, r),
+		vec4_dot((vec4){l.x.z, l.y.z, l.z.z, l.w.z}, r),
+		vec4_dot((vec4){l.x.w, l.y.w, l.z.w, l.w.w}, r),
+	};
+#endif
+}
+
+mat4 mat4_mul_mat(mat4 l, mat4 r) {
+#if SIMD_AVX2
+	__m256 columns[4]; f32x8_load_mat4(&l, columns);
+	mat4 ret; f32x8_mat4_mul_mat(columns, &r, &ret);
+	return ret;
+#elif SIMD_F32X4
+	f32x4 columns[4]; f32x4_load_mat4(&l, columns);
+	mat4 ret;
+	f32x4_store(&ret.x.x, f32x4_mat4_mul_vec(columns, f32x4_load(&r.x.x)));
+	f32x4_store(&ret.y.x, f32x4_mat4_mul_vec(columns, f32x4_load(&r.y.x)));
+	f32x4_store(&ret.z.x, f32x4_mat4_mul_vec(columns, f32x4_load(&r.z.x)));
+	f32x4_store(&ret.w.x, f32x4_mat4_mul_vec(columns, f32x4_load(&r.w.x)));
+	return ret;
+#else
+	return (mat4){
+		mat4_mul_vec(l, r.x),
+		mat4_mul_vec(l, r.y),
+		mat4_mul_vec(l, r.z),
+		mat4_mul_vec(l, r.w),
+	};
+#endif
+}
+
+mat4 mat4_transformation(vec3 offset, quat rotation, vec3 scale) {
+	vec3 axis_x, axis_y, axis_z;
+	quat_get_axes(rotation, &axis_x, &axis_y, &axis_z);
+	axis_x = vec3_muls(axis_x, scale.x);
+	axis_y = vec3_muls(axis_y, scale.y);
+	axis_z = vec3_muls(axis_z, scale.z);
+	return (mat4){
+		{axis_x.x, axis_x.y, axis_x.z, 0},
+		{axis_y.x, axis_y.y, axis_y.z, 0},
+		{axis_z.x, axis_z.y, axis_z.z, 0},
+		{offset.x, offset.y, offset.z, 1},
+	};
+}
+
+mat4 mat4_transformation_inverse(vec3 offset, quat rotation, vec3 scale) {
+	vec3 axis_x, axis_y, axis_z;
+	quat_get_axes(rotation, &axis_x, &axis_y, &axis_z);
+	axis_x = vec3_muls(axis_x, scale.x);
+	axis_y = vec3_muls(axis_y, scale.y);
+	axis_z = vec3_muls(axis_z, scale.z);
+	return (mat4){
+		// @note inverse rotation matrix is its transposition
+		{axis_x.x, axis_y.x, axis_z.x, 0},
+		{axis_x.y, axis_y.y, axis_z.y, 0},
+		{axis_x.z, axis_y.z, axis_z.z, 0},
+		{ // @note inverse offset in inverted coordinates space
+			-vec3_dot(offset, axis_x),
+			-vec3_dot(offset, axis_y),
+			-vec3_dot(offset, axis_z),
+			1
+		},
+	};
+}
+
+mat4 mat4_invert_transformation(mat4 transformation) {
+	vec3 const position = (vec3){transformation.w.x, transformation.w.y, transformation.w.z};
+	return (mat4){
+		{transformation.x.x, transformation.y.x, transformation.z.x, 0},
+		{transformation.x.y, transformation.y.y, transformation.z.y, 0},
+		{transformation.x.z, transformation.y.z, transformation.z.z, 0},
+		{
+			-vec3_dot(position, (vec3){transformation.x.x, transformation.x.y, transformation.x.z}),
+			-vec3_dot(position, (vec3){transformation.y.x, transformation.y.y, transformation.y.z}),
+			-vec3_dot(position, (vec3){transformation.z.x, transformation.z.y, transformation.z.z}),
+			1
+		},
+	};
+}
+
+/*
+@note a general inverse via cross products of columns, see
+"Foundations of Game Engine Development, Volume 1" by Eric Lengyel;
+with `a, b, c, d` being column vectors and `x, y, z, w` their last components:
+s = a x b, t = c x d, u = a * y - b * x, v = c * w - d * z
+determinant = s . v + t . u
+inverse rows are `b x v + t * y | -b . t`, `v x a - t * x |  a . t`,
+                 `d x u + s * w | -d . s`, `u x c - s * z |  c . s`, over the determinant
+*/
+
+AttrFileLocal()
+void mat4_inverse_kernel(mat4 const * source, mat4 * target) {
+#if SIMD_F32X4
+	f32x4 const a = f32x4_load(&source->x.x), b = f32x4_load(&source->y.x);
+	f32x4 const c = f32x4_load(&source->z.x), d = f32x4_load(&source->w.x);
+	f32x4 const x = f32x4_lane(a, 3), y = f32x4_lane(b, 3);
+	f32x4 const z = f32x4_lane(c, 3), w = f32x4_lane(d, 3);
+	f32x4 s = f32x4_crs(a, b);
+	f32x4 t = f32x4_crs(c, d);
+	f32x4 u = f32x4_sub(f32x4_mul(a, y), f32x4_mul(b, x));
+	f32x4 v = f32x4_sub(f32x4_mul(c, w), f32x4_mul(d, z));
+
+	f32x4 dots[4] = {f32x4_mul(s, v), f32x4_mul(t, u), f32x4_splat(0), f32x4_splat(0)};
+	f32x4 const sums = f32x4_dot3_x4(dots);
+	f32 const determinant = f32x4_first(sums) + f32x4_first(f32x4_lane(sums, 1));
+	f32x4 const scale = f32x4_splat(determinant != 0 ? 1 / determinant : 0);
+	s = f32x4_mul(s, scale); t = f32x4_mul(t, scale);
+	u = f32x4_mul(u, scale); v = f32x4_mul(v, scale);
+
+	f32x4 rows[4] = {
+		f32x4_add(f32x4_crs(b, v), f32x4_mul(t, y)),
+		f32x4_sub(f32x4_crs(v, a), f32x4_mul(t, x)),
+		f32x4_add(f32x4_crs(d, u), f32x4_mul(s, w)),
+		f32x4_sub(f32x4_crs(u, c), f32x4_mul(s, z)),
+	};
+	f32x4 lasts[4] = {f32x4_mul(b, t), f32x4_mul(a, t), f32x4_mul(d, s), f32x4_mul(c, s)};
+	f32x4 const last = f32x4_flip(f32x4_dot3_x4(lasts), 1, 0, 1, 0);
+	f32x4_transpose(rows);
+	f32x4_store(&target->x.x, rows[0]);
+	f32x4_store(&target->y.x, rows[1]);
+	f32x4_store(&target->z.x, rows[2]);
+	f32x4_store(&target->w.x, last);
+#else
+	vec3 const a = {source->x.x, source->x.y, source->x.z}; f32 const x = source->x.w;
+	vec3 const b = {source->y.x, source->y.y, source->y.z}; f32 const y = source->y.w;
+	vec3 const c = {source->z.x, source->z.y, source->z.z}; f32 const z = source->z.w;
+	vec3 const d = {source->w.x, source->w.y, source->w.z}; f32 const w = source->w.w;
+	vec3 s = vec3_crs(a, b);
+	vec3 t = vec3_crs(c, d);
+	vec3 u = vec3_sub(vec3_muls(a, y), vec3_muls(b, x));
+	vec3 v = vec3_sub(vec3_muls(c, w), vec3_muls(d, z));
+
+	f32 const determinant = vec3_dot(s, v) + vec3_dot(t, u);
+	f32 const scale = determinant != 0 ? 1 / determinant : 0;
+	s = vec3_muls(s, scale); t = vec3_muls(t, scale);
+	u = vec3_muls(u, scale); v = vec3_muls(v, scale);
+
+	vec3 const r0 = vec3_add(vec3_crs(b, v), vec3_muls(t, y));
+	vec3 const r1 = vec3_sub(vec3_crs(v, a), vec3_muls(t, x));
+	vec3 const r2 = vec3_add(vec3_crs(d, u), vec3_muls(s, w));
+	vec3 const r3 = vec3_sub(vec3_crs(u, c), vec3_muls(s, z));
+	*target = (mat4){
+		{r0.x, r1.x, r2.x, r3.x},
+		{r0.y, r1.y, r2.y, r3.y},
+		{r0.z, r1.z, r2.z, r3.z},
+		{-vec3_dot(b, t), vec3_dot(a, t), -vec3_dot(d, s), vec3_dot(c, s)},
+	};
+#endif
+}
+
+AttrFileLocal()
+void mat4_inverse_affine_kernel(mat4 const * source, mat4 * target) {
+	// @note the upper 3x3 inverse is its cofactors over the determinant
+#if SIMD_F32X4
+	f32x4 const a = f32x4_load(&source->x.x), b = f32x4_load(&source->y.x);
+	f32x4 const c = f32x4_load(&source->z.x), d = f32x4_load(&source->w.x);
+	f32x4 rows[4] = {f32x4_crs(b, c), f32x4_crs(c, a), f32x4_crs(a, b), f32x4_splat(0)};
+
+	f32x4 dots[4] = {f32x4_mul(a, rows[0]), f32x4_splat(0), f32x4_splat(0), f32x4_splat(0)};
+	f32 const determinant = f32x4_first(f32x4_dot3_x4(dots));
+	f32x4 const scale = f32x4_splat(determinant != 0 ? 1 / determinant : 0);
+	rows[0] = f32x4_mul(rows[0], scale);
+	rows[1] = f32x4_mul(rows[1], scale);
+	rows[2] = f32x4_mul(rows[2], scale);
+
+	f32x4 offsets[4] = {f32x4_mul(rows[0], d), f32x4_mul(rows[1], d), f32x4_mul(rows[2], d), f32x4_splat(0)};
+	f32x4 const offset = f32x4_flip(f32x4_dot3_x4(offsets), 1, 1, 1, 0);
+	f32x4_transpose(rows);
+	f32x4_store(&target->x.x, rows[0]);
+	f32x4_store(&target->y.x, rows[1]);
+	f32x4_store(&target->z.x, rows[2]);
+	f32x4_store(&target->w.x, offset);
+	target->w.w = 1;
+#else
+	vec3 const a = {source->x.x, source->x.y, source->x.z};
+	vec3 const b = {source->y.x, source->y.y, source->y.z};
+	vec3 const c = {source->z.x, source->z.y, source->z.z};
+	vec3 const d = {source->w.x, source->w.y, source->w.z};
+	vec3 r0 = vec3_crs(b, c);
+	vec3 r1 = vec3_crs(c, a);
+	vec3 r2 = vec3_crs(a, b);
+
+	f32 const determinant = vec3_dot(a, r0);
+	f32 const scale = determinant != 0 ? 1 / determinant : 0;
+	r0 = vec3_muls(r0, scale);
+	r1 = vec3_muls(r1, scale);
+	r2 = vec3_muls(r2, scale);
+	*target = (mat4){
+		{r0.x, r1.x, r2.x, 0},
+		{r0.y, r1.y, r2.y, 0},
+		{r0.z, r1.z, r2.z, 0},
+		{-vec3_dot(r0, d), -vec3_dot(r1, d), -vec3_dot(r2, d), 1},
+	};
+#endif
+}
+
+f32 mat4_determinant(mat4 value) {
+	vec3 const a = {value.x.x, value.x.y, value.x.z};
+	vec3 const b = {value.y.x, value.y.y, value.y.z};
+	vec3 const c = {value.z.x, value.z.y, value.z.z};
+	vec3 const d = {value.w.x, value.w.y, value.w.z};
+	vec3 const s = vec3_crs(a, b);
+	vec3 const t = vec3_crs(c, d);
+	vec3 const u = vec3_sub(vec3_muls(a, value.y.w), vec3_muls(b, value.x.w));
+	vec3 const v = vec3_sub(vec3_muls(c, value.w.w), vec3_muls(d, value.z.w));
+	return vec3_dot(s, v) + vec3_dot(t, u);
+}
+
+mat4 mat4_inverse(mat4 value) {
+	mat4 ret; mat4_inverse_kernel(&value, &ret);
+	return ret;
+}
+
+mat4 mat4_inverse_affine(mat4 value) {
+	mat4 ret; mat4_inverse_affine_kernel(&value, &ret);
+	return ret;
+}
+
+mat4 mat4_projection(
+	vec2 scale_xy, vec2 offset_xy, f32 ortho,
+	f32 view_near, f32 view_far,
+	f32 ndc_near,  f32 ndc_far
+) {
+	float const reverse_depth = 1 / (view_far - view_near);
+
+	float const persp_scale_z  = inf32(view_far) ? ndc_far                            : (reverse_depth * (ndc_far * view_far - ndc_near * view_near));
+	float const persp_offset_z = inf32(view_far) ? ((ndc_near - ndc_far) * view_near) : (reverse_depth * (ndc_near - ndc_far) * view_near * view_far);
+
+	float const ortho_scale_z  = inf32(view_far) ? 0        : (reverse_depth * (ndc_far - ndc_near));
+	float const ortho_offset_z = inf32(view_far) ? ndc_near : (reverse_depth * (ndc_near * view_far - ndc_far * view_near));
+
+	float const scale_z  = lerp32(persp_scale_z,  ortho_scale_z,  ortho);
+	float const offset_z = lerp32(persp_offset_z, ortho_offset_z, ortho);
+	float const zw = 1 - ortho;
+	float const ww = ortho;
+
+	return (mat4){
+		{scale_xy.x,  0,           0,         0},
+		{0,           scale_xy.y,  0,         0},
+		{0,           0,           scale_z,  zw},
+		{offset_xy.x, offset_xy.y, offset_z, ww},
+	};
+
+/*
+@info projection matrix
+
+> aim:
+map [-pos_xy   .. pos_xy]   -> [-1       .. 1]
+map [view_near .. view_far] -> [ndc_near .. ndc_far]
+
+> known params (aspect correction)
+scale_XY = {height / width, 1} / tan(FoV / 2) or {1, width / height} / tan(FoV / 2)
+offset_XY = {0, 0}, i.e. the screen center
+
+> known params (direct mapping from bottom-left to top-right)
+scale_XY = {2 / width, 2 / height}
+offset = {-1, -1}
+
+> orthograhic: NDC = XYZ * scale + offset
+Sz = (ndc_far - ndc_near) / (view_far - view_near)
+   ~ 0 ; !IF! view_far == infinity
+Oz = (ndc_near * view_far - ndc_far * view_near) / (view_far - view_near)
+   ~ ndc_near ; !IF! view_far == infinity
+| Sx  0   0  Ox |    | x |    | x * Sx + Ox |
+| 0   Sy  0  Oy | \/ | y | == | y * Sy + Oy |
+| 0   0   Sz Oz | /\ | z | == | z * Sz + Oz |
+| 0   0   0  1  |    | 1 |    | 1           |
+
+> perspective: NDC = (XYZ * scale + offset) / z
+Sz = (ndc_far * view_far - ndc_near * view_near) / (view_far - view_near)
+   ~ ndc_far ; !IF! view_far == infinity
+Oz = (ndc_near - ndc_far) * view_near * view_far / (view_far - view_near)
+   ~ (ndc_near - ndc_far) * view_near ; !IF! view_far == infinity
+| Sx  0   0  Ox |    | x |    | x * Sx + Ox |
+| 0   Sy  0  Oy | \/ | y | == | y * Sy + Oy |
+| 0   0   Sz Oz | /\ | z | == | z * Sz + Oz |
+| 0   0   1  0  |    | 1 |    | z           |
+*/
+}
+
+// ---- ---- ---- ----
+// functions: f32 math, batch
+// ---- ---- ---- ----
+
+#define TRANSFORM_CHUNK 64
+
+AttrFileLocal()
+void transform_soa(
+	mat4 const * m, f32 w, bool normalize, size_t count,
+	f32 const * x, f32 const * y, f32 const * z,
+	f32 * out_x, f32 * out_y, f32 * out_z
+) {
+	// @note the same operations order as `mat4_mul_vec`, `m->w * w` is exact for `w` of `0` and `1`
+	f32 const tx = m->w.x * w, ty = m->w.y * w, tz = m->w.z * w;
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	f32xw const xx = f32xw_splat(m->x.x), xy = f32xw_splat(m->x.y), xz = f32xw_splat(m->x.z);
+	f32xw const yx = f32xw_splat(m->y.x), yy = f32xw_splat(m->y.y), yz = f32xw_splat(m->y.z);
+	f32xw const zx = f32xw_splat(m->z.x), zy = f32xw_splat(m->z.y), zz = f32xw_splat(m->z.z);
+	f32xw const wx = f32xw_splat(tx),     wy = f32xw_splat(ty),     wz = f32xw_splat(tz);
+	f32xw const epsilon = f32xw_splat(FLT_MIN);
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		f32xw const vx = f32xw_load(x + i);
+		f32xw const vy = f32xw_load(y + i);
+		f32xw const vz = f32xw_load(z + i);
+		f32xw rx = f32xw_add(f32xw_add(f32xw_add(f32xw_mul(xx, vx), f32xw_mul(yx, vy)), f32xw_mul(zx, vz)), wx);
+		f32xw ry = f32xw_add(f32xw_add(f32xw_add(f32xw_mul(xy, vx), f32xw_mul(yy, vy)), f32xw_mul(zy, vz)), wy);
+		f32xw rz = f32xw_add(f32xw_add(f32xw_add(f32xw_mul(xz, vx), f32xw_mul(yz, vy)), f32xw_mul(zz, vz)), wz);
+		if (normalize) {
+			f32xw const length = f32xw_max(epsilon, f32xw_sqrt(f32xw_add(f32xw_add(
+				f32xw_mul(rx, rx), f32xw_mul(ry, ry)), f32xw_mul(rz, rz)
+			)));
+			rx = f32xw_div(rx, length);
+			ry = f32xw_div(ry, length);
+			rz = f32xw_div(rz, length);
+		}
+		f32xw_store(out_x + i, rx);
+		f32xw_store(out_y + i, ry);
+		f32xw_store(out_z + i, rz);
+	}
+#endif
+	for (; i < count; i++) {
+		f32 const vx = x[i], vy = y[i], vz = z[i];
+		f32 rx = m->x.x * vx + m->y.x * vy + m->z.x * vz + tx;
+		f32 ry = m->x.y * vx + m->y.y * vy + m->z.y * vz + ty;
+		f32 rz = m->x.z * vx + m->y.z * vy + m->z.z * vz + tz;
+		if (normalize) {
+			f32 const length = max_f32(FLT_MIN, sqrt32(rx * rx + ry * ry + rz * rz));
+			rx /= length; ry /= length; rz /= length;
+		}
+		out_x[i] = rx; out_y[i] = ry; out_z[i] = rz;
+	}
+}
+
+AttrFileLocal()
+void transform_strided(
+	mat4 const * m, f32 w, bool normalize, size_t count,
+	vec3 const * source, size_t source_stride,
+	vec3 * target, size_t target_stride
+) {
+	// @note AoS data is transposed in chunks that fit into the stack
+	f32 x[TRANSFORM_CHUNK], y[TRANSFORM_CHUNK], z[TRANSFORM_CHUNK];
+	u8 const * source_bytes = (u8 const *)source;
+	u8       * target_bytes = (u8       *)target;
+	for (size_t offset = 0; offset < count; offset += TRANSFORM_CHUNK) {
+		size_t const chunk = min_size(count - offset, TRANSFORM_CHUNK);
+		for (size_t i = 0; i < chunk; i++) {
+			vec3 const * it = (vec3 const *)(void const *)(source_bytes + source_stride * (offset + i));
+			x[i] = it->x; y[i] = it->y; z[i] = it->z;
+		}
+		transform_soa(m, w, normalize, chunk, x, y, z, x, y, z);
+		for (size_t i = 0; i < chunk; i++) {
+			vec3 * it = (vec3 *)(void *)(target_bytes + target_stride * (offset + i));
+			*it = (vec3){x[i], y[i], z[i]};
+		}
+	}
+}
+
+AttrFileLocal()
+mat4 mat4_normal_matrix(mat4 m) {
+	// @note the inverse-transpose of the upper 3x3: cofactor columns over the determinant
+	vec3 const a = {m.x.x, m.x.y, m.x.z};
+	vec3 const b = {m.y.x, m.y.y, m.y.z};
+	vec3 const c = {m.z.x, m.z.y, m.z.z};
+	vec3 const bc = vec3_crs(b, c);
+	vec3 const ca = vec3_crs(c, a);
+	vec3 const ab = vec3_crs(a, b);
+	f32 const determinant = vec3_dot(a, bc);
+	f32 const scale = determinant != 0 ? 1 / determinant : 1;
+	return (mat4){
+		{bc.x * scale, bc.y * scale, bc.z * scale, 0},
+		{ca.x * scale, ca.y * scale, ca.z * scale, 0},
+		{ab.x * scale, ab.y * scale, ab.z * scale, 0},
+		{0, 0, 0, 1},
+	};
+}
+
+void mat4_transform_points(mat4 m, size_t count, vec3 const * source, size_t source_stride, vec3 * target, size_t target_stride) {
+	transform_strided(&m, 1, false, count, source, source_stride, target, target_stride);
+}
+
+void mat4_transform_directions(mat4 m, size_t count, vec3 const * source, size_t source_stride, vec3 * target, size_t target_stride) {
+	transform_strided(&m, 0, false, count, source, source_stride, target, target_stride);
+}
+
+void mat4_transform_points_soa(mat4 m, size_t count, vec3_soa source, vec3_soa target) {
+	transform_soa(&m, 1, false, count, source.x, source.y, source.z, target.x, target.y, target.z);
+}
+
+void mat4_transform_directions_soa(mat4 m, size_t count, vec3_soa source, vec3_soa target) {
+	transform_soa(&m, 0, false, count, source.x, source.y, source.z, target.x, target.y, target.z);
+}
+
+void mat4_transform_normals(mat4 m, size_t count, vec3 const * source, size_t source_stride, vec3 * target, size_t target_stride) {
+	mat4 const normal = mat4_normal_matrix(m);
+	transform_strided(&normal, 0, true, count, source, source_stride, target, target_stride);
+}
+
+void mat4_transform_normals_soa(mat4 m, size_t count, vec3_soa source, vec3_soa target) {
+	mat4 const normal = mat4_normal_matrix(m);
+	transform_soa(&normal, 0, true, count, source.x, source.y, source.z, target.x, target.y, target.z);
+}
+
+void mat4_inverse_batch(size_t count, mat4 const * source, mat4 * target) {
+	for (size_t i = 0; i < count; i++)
+		mat4_inverse_kernel(source + i, target + i);
+}
+
+void mat4_inverse_affine_batch(size_t count, mat4 const * source, mat4 * target) {
+	for (size_t i = 0; i < count; i++)
+		mat4_inverse_affine_kernel(source + i, target + i);
+}
+
+void mat4_mul_mat_batch(mat4 l, size_t count, mat4 const * source, mat4 * target) {
+#if SIMD_AVX2
+	__m256 columns[4]; f32x8_load_mat4(&l, columns);
+	for (size_t i = 0; i < count; i++)
+		f32x8_mat4_mul_mat(columns, source + i, target + i);
+#elif SIMD_F32X4
+	f32x4 columns[4]; f32x4_load_mat4(&l, columns);
+	for (size_t i = 0; i < count; i++) {
+		f32 const * r = &source[i].x.x;
+		f32 * it = &target[i].x.x;
+		for (u32 c = 0; c < 4; c++)
+			f32x4_store(it + c * 4, f32x4_mat4_mul_vec(columns, f32x4_load(r + c * 4)));
+	}
+#else
+	for (size_t i = 0; i < count; i++)
+		target[i] = mat4_mul_mat(l, source[i]);
+#endif
+}
+
+// ---- ---- ---- ----
+// functions: f32 math, bounds
+// ---- ---- ---- ----
+
+aabb3 aabb3_from_points(size_t count, vec3 const * source, size_t stride) {
+	if (count == 0) return (aabb3){0};
+	u8 const * bytes = (u8 const *)source;
+	aabb3 ret = {.min = *source, .max = *source};
+	for (size_t i = 1; i < count; i++) {
+		vec3 const it = *(vec3 const *)(void const *)(bytes + stride * i);
+		ret.min = (vec3){min_f32(ret.min.x, it.x), min_f32(ret.min.y, it.y), min_f32(ret.min.z, it.z)};
+		ret.max = (vec3){max_f32(ret.max.x, it.x), max_f32(ret.max.y, it.y), max_f32(ret.max.z, it.z)};
+	}
+	return ret;
+}
+
+sphere3 sphere3_from_points(size_t count, vec3 const * source, size_t stride) {
+	// @note centered at the bounding box, not the minimal sphere, but a single extra pass
+	aabb3 const box = aabb3_from_points(count, source, stride);
+	vec3 const center = vec3_muls(vec3_add(box.min, box.max), 0.5f);
+	u8 const * bytes = (u8 const *)source;
+	f32 radius_squared = 0;
+	for (size_t i = 0; i < count; i++) {
+		vec3 const it = *(vec3 const *)(void const *)(bytes + stride * i);
+		vec3 const offset = vec3_sub(it, center);
+		radius_squared = max_f32(radius_squared, vec3_dot(offset, offset));
+	}
+	return (sphere3){.center = center, .radius = sqrt32(radius_squared)};
+}
+
+aabb3 aabb3_transform(aabb3 value, mat4 m) {
+	// @note transforms the center, the extent goes through absolute axes
+	vec3 const center = vec3_muls(vec3_add(value.min, value.max), 0.5f);
+	vec3 const extent = vec3_muls(vec3_sub(value.max, value.min), 0.5f);
+	vec4 const c = mat4_mul_vec(m, (vec4){center.x, center.y, center.z, 1});
+	vec3 const e = {
+		abs32(m.x.x) * extent.x + abs32(m.y.x) * extent.y + abs32(m.z.x) * extent.z,
+		abs32(m.x.y) * extent.x + abs32(m.y.y) * extent.y + abs32(m.z.y) * extent.z,
+		abs32(m.x.z) * extent.x + abs32(m.y.z) * extent.y + abs32(m.z.z) * extent.z,
+	};
+	return (aabb3){
+		.min = {c.x - e.x, c.y - e.y, c.z - e.z},
+		.max = {c.x + e.x, c.y + e.y, c.z + e.z},
+	};
+}
+
+void mat4_frustum_planes(mat4 value, f32 ndc_near, f32 ndc_far, vec4 * out_planes) {
+	// @note clip space inequalities `-w <= x <= w`, `-w <= y <= w`, `lo * w <= z <= hi * w`
+	vec4 const row_x = {value.x.x, value.y.x, value.z.x, value.w.x};
+	vec4 const row_y = {value.x.y, value.y.y, value.z.y, value.w.y};
+	vec4 const row_z = {value.x.z, value.y.z, value.z.z, value.w.z};
+	vec4 const row_w = {value.x.w, value.y.w, value.z.w, value.w.w};
+	f32 const lo = min_f32(ndc_near, ndc_far);
+	f32 const hi = max_f32(ndc_near, ndc_far);
+	out_planes[0] = vec4_add(row_w, row_x);
+	out_planes[1] = vec4_sub(row_w, row_x);
+	out_planes[2] = vec4_add(row_w, row_y);
+	out_planes[3] = vec4_sub(row_w, row_y);
+	out_planes[4] = vec4_sub(row_z, vec4_muls(row_w, lo));
+	out_planes[5] = vec4_sub(vec4_muls(row_w, hi), row_z);
+	for (u32 i = 0; i < FRUSTUM_PLANES; i++) {
+		vec4 const it = out_planes[i];
+		f32 const length = sqrt32(it.x * it.x + it.y * it.y + it.z * it.z);
+		// @note an infinite far plane degenerates into `{0, 0, 0, positive}`, which passes everything
+		if (length > 0) out_planes[i] = vec4_muls(it, 1 / length);
+	}
+}
+
+#define CULL_CHUNK 64
+
+AttrFileLocal()
+u64 frustum_cull_chunk(
+	vec4 const * planes, size_t count,
+	f32 const * cx, f32 const * cy, f32 const * cz,
+	f32 const * ex, f32 const * ey, f32 const * ez
+) {
+	// @note a volume is visible unless it's fully behind some plane, `n . c + w + |n| . e < 0`;
+	// spheres pass radii as `ex` and `{1, 0, 0}` as `|n|`
+	u64 ret = 0;
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		f32xw const vcx = f32xw_load(cx + i), vcy = f32xw_load(cy + i), vcz = f32xw_load(cz + i);
+		f32xw const vex = f32xw_load(ex + i), vey = f32xw_load(ey + i), vez = f32xw_load(ez + i);
+		f32xw visible = f32xw_ge(f32xw_splat(0), f32xw_splat(0));
+		for (u32 p = 0; p < FRUSTUM_PLANES; p++) {
+			vec4 const it = planes[p * 2 + 0], abs_n = planes[p * 2 + 1];
+			f32xw d = f32xw_add(f32xw_add(f32xw_add(
+				f32xw_mul(f32xw_splat(it.x), vcx),
+				f32xw_mul(f32xw_splat(it.y), vcy)),
+				f32xw_mul(f32xw_splat(it.z), vcz)),
+				f32xw_splat(it.w));
+			d = f32xw_add(d, f32xw_add(f32xw_add(
+				f32xw_mul(f32xw_splat(abs_n.x), vex),
+				f32xw_mul(f32xw_splat(abs_n.y), vey)),
+				f32xw_mul(f32xw_splat(abs_n.z), vez)));
+			visible = f32xw_and(visible, f32xw_ge(d, f32xw_splat(0)));
+		}
+		ret |= (u64)f32xw_mask(visible) << i;
+	}
+#endif
+	for (; i < count; i++) {
+		bool visible = true;
+		for (u32 p = 0; p < FRUSTUM_PLANES; p++) {
+			vec4 const it = planes[p * 2 + 0], abs_n = planes[p * 2 + 1];
+			f32 d = it.x * cx[i] + it.y * cy[i] + it.z * cz[i] + it.w;
+			d = d + (abs_n.x * ex[i] + abs_n.y * ey[i] + abs_n.z * ez[i]);
+			visible = visible && d >= 0;
+		}
+		ret |= (u64)visible << i;
+	}
+	return ret;
+}
+
+void frustum_cull_aabb3(vec4 const * planes, size_t count, aabb3 const * source, u64 * out_visible) {
+	vec4 prepared[FRUSTUM_PLANES * 2];
+	for (u32 p = 0; p < FRUSTUM_PLANES; p++) {
+		prepared[p * 2 + 0] = planes[p];
+		prepared[p * 2 + 1] = (vec4){abs32(planes[p].x), abs32(planes[p].y), abs32(planes[p].z), 0};
+	}
+
+	f32 cx[CULL_CHUNK], cy[CULL_CHUNK], cz[CULL_CHUNK];
+	f32 ex[CULL_CHUNK], ey[CULL_CHUNK], ez[CULL_CHUNK];
+	for (size_t offset = 0; offset < count; offset += CULL_CHUNK) {
+		size_t const chunk = min_size(count - offset, CULL_CHUNK);
+		for (size_t i = 0; i < chunk; i++) {
+			aabb3 const it = source[offset + i];
+			cx[i] = (it.min.x + it.max.x) * 0.5f; ex[i] = (it.max.x - it.min.x) * 0.5f;
+			cy[i] = (it.min.y + it.max.y) * 0.5f; ey[i] = (it.max.y - it.min.y) * 0.5f;
+			cz[i] = (it.min.z + it.max.z) * 0.5f; ez[i] = (it.max.z - it.min.z) * 0.5f;
+		}
+		out_visible[offset / CULL_CHUNK] = frustum_cull_chunk(prepared, chunk, cx, cy, cz, ex, ey, ez);
+	}
+}
+
+void frustum_cull_sphere3(vec4 const * planes, size_t count, sphere3 const * source, u64 * out_visible) {
+	vec4 prepared[FRUSTUM_PLANES * 2];
+	for (u32 p = 0; p < FRUSTUM_PLANES; p++) {
+		prepared[p * 2 + 0] = planes[p];
+		prepared[p * 2 + 1] = vec4_x1;
+	}
+
+	AttrFuncLocal() f32 const zeros[CULL_CHUNK] = {0};
+	f32 cx[CULL_CHUNK], cy[CULL_CHUNK], cz[CULL_CHUNK], radii[CULL_CHUNK];
+	for (size_t offset = 0; offset < count; offset += CULL_CHUNK) {
+		size_t const chunk = min_size(count - offset, CULL_CHUNK);
+		for (size_t i = 0; i < chunk; i++) {
+			sphere3 const it = source[offset + i];
+			cx[i] = it.center.x; cy[i] = it.center.y; cz[i] = it.center.z;
+			radii[i] = it.radius;
+		}
+		out_visible[offset / CULL_CHUNK] = frustum_cull_chunk(prepared, chunk, cx, cy, cz, radii, zeros, zeros);
+	}
+}
+
+// ---- ---- ---- ----
+// functions: random
+// ---- ---- ---- ----
+
+#define PCG32_MULTIPLIER 6364136223846793005ull
+#define RANDOM_CHUNK 64
+
+AttrFileLocal()
+f32 random_unit(u32 value) {
+	// @note top 24 bits, exactly representable
+	return (f32)(value >> 8) * (1.0f / 16777216.0f);
+}
+
+AttrFileLocal()
+void random_unit_batch(size_t count, u32 const * source, f32 * target) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		f32xw const value = f32xw_convert(s32xw_shr(s32xw_load(source + i), 8));
+		f32xw_store(target + i, f32xw_mul(value, f32xw_splat(1.0f / 16777216.0f)));
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = random_unit(source[i]);
+}
+
+AttrFileLocal()
+u32 pcg32_output(u64 state) {
+	u32 const xorshifted = (u32)(((state >> 18) ^ state) >> 27);
+	u32 const rotation   = (u32)(state >> 59);
+	return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+}
+
+#if SIMD_AVX2
+AttrFileLocal()
+__m256i u64x4_mul(__m256i l, __m256i r) {
+	// @note low 64 bits of the product, from 32-bit halves
+	__m256i const low   = _mm256_mul_epu32(l, r);
+	__m256i const cross = _mm256_add_epi64(
+		_mm256_mul_epu32(_mm256_srli_epi64(l, 32), r),
+		_mm256_mul_epu32(l, _mm256_srli_epi64(r, 32))
+	);
+	return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+AttrFileLocal()
+__m256i u64x4_rotl(__m256i value, int shift) {
+	return _mm256_or_si256(_mm256_slli_epi64(value, shift), _mm256_srli_epi64(value, 64 - shift));
+}
+
+AttrFileLocal()
+__m128i u64x4_pcg32_output(__m256i state) {
+	// @note `pcg32_output` on 64-bit lanes, packed into 32-bit ones
+	__m256i const low_mask = _mm256_set1_epi64x(0xffffffff);
+	__m256i const xorshifted = _mm256_and_si256(_mm256_srli_epi64(_mm256_xor_si256(_mm256_srli_epi64(state, 18), state), 27), low_mask);
+	__m256i const rotation = _mm256_srli_epi64(state, 59);
+	__m256i const rotated = _mm256_or_si256(
+		_mm256_srlv_epi64(xorshifted, rotation),
+		_mm256_sllv_epi64(xorshifted, _mm256_and_si256(_mm256_sub_epi64(_mm256_set1_epi64x(32), rotation), _mm256_set1_epi64x(31)))
+	);
+	return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(rotated, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+}
+#endif
+
+struct PCG32 pcg32_init(u64 seed, u64 sequence) {
+	// @note the reference seeding procedure
+	struct PCG32 ret = {.increment = (sequence << 1) | 1};
+	pcg32_next(&ret);
+	ret.state += seed;
+	pcg32_next(&ret);
+	return ret;
+}
+
+u32 pcg32_next(struct PCG32 * inst) {
+	u64 const state = inst->state;
+	inst->state = state * PCG32_MULTIPLIER + inst->increment;
+	return pcg32_output(state);
+}
+
+f32 pcg32_next_f32(struct PCG32 * inst) {
+	return random_unit(pcg32_next(inst));
+}
+
+void pcg32_fill_u32(struct PCG32 * inst, size_t count, u32 * target) {
+	size_t i = 0;
+#if SIMD_AVX2
+	if (count >= 8) {
+		// @note lane `k` starts `k` steps ahead and all of them stride 8 steps,
+		// so the output is the same stream as of `pcg32_next`; two registers
+		// hide the latency of the emulated 64-bit multiplication
+		u64 lanes[8]; u64 multiplier = 1, increment = 0;
+		for (u32 k = 0; k < 8; k++) {
+			lanes[k] = inst->state * multiplier + increment;
+			multiplier = multiplier * PCG32_MULTIPLIER;
+			increment  = increment  * PCG32_MULTIPLIER + inst->increment;
+		}
+
+		__m256i states[2] = {
+			_mm256_loadu_si256((__m256i const *)(void const *)(lanes + 0)),
+			_mm256_loadu_si256((__m256i const *)(void const *)(lanes + 4)),
+		};
+		__m256i const lanes_multiplier = _mm256_set1_epi64x((long long)multiplier);
+		__m256i const lanes_increment  = _mm256_set1_epi64x((long long)increment);
+		for (; i + 8 <= count; i += 8) {
+			for (u32 k = 0; k < 2; k++) {
+				_mm_storeu_si128((__m128i *)(void *)(target + i + k * 4), u64x4_pcg32_output(states[k]));
+				states[k] = _mm256_add_epi64(u64x4_mul(states[k], lanes_multiplier), lanes_increment);
+			}
+		}
+
+		_mm256_storeu_si256((__m256i *)(void *)lanes, states[0]);
+		inst->state = lanes[0];
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = pcg32_next(inst);
+}
+
+void pcg32_fill_f32(struct PCG32 * inst, size_t count, f32 * target) {
+	u32 buffer[RANDOM_CHUNK];
+	for (size_t offset = 0; offset < count; offset += RANDOM_CHUNK) {
+		size_t const chunk = min_size(count - offset, RANDOM_CHUNK);
+		pcg32_fill_u32(inst, chunk, buffer);
+		random_unit_batch(chunk, buffer, target + offset);
+	}
+}
+
+AttrFileLocal()
+u64 rotl64(u64 value, u32 shift) {
+	return (value << shift) | (value >> (64 - shift));
+}
+
+struct Xoshiro256 xoshiro256_init(u64 seed) {
+	// @note expanded with splitmix64, as recommended by the authors
+	struct Xoshiro256 ret;
+	for (u32 i = 0; i < 4; i++) {
+		seed += 0x9e3779b97f4a7c15ull;
+		u64 value = seed;
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+		ret.state[i] = value ^ (value >> 31);
+	}
+	return ret;
+}
+
+u64 xoshiro256_next(struct Xoshiro256 * inst) {
+	u64 * s = inst->state;
+	u64 const ret = rotl64(s[1] * 5, 7) * 9;
+	u64 const t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl64(s[3], 45);
+	return ret;
+}
+
+f32 xoshiro256_next_f32(struct Xoshiro256 * inst) {
+	return random_unit((u32)(xoshiro256_next(inst) >> 32));
+}
+
+void xoshiro256_jump(struct Xoshiro256 * inst) {
+	AttrFuncLocal() u64 const jump[] = {
+		0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+		0xa9582618e03fc9aaull, 0x39abdc4529b1661cull,
+	};
+
+	u64 state[4] = {0};
+	for (u32 i = 0; i < ArrayCount(jump); i++) {
+		for (u32 bit = 0; bit < 64; bit++) {
+			if (jump[i] & ((u64)1 << bit)) {
+				state[0] ^= inst->state[0];
+				state[1] ^= inst->state[1];
+				state[2] ^= inst->state[2];
+				state[3] ^= inst->state[3];
+			}
+			xoshiro256_next(inst);
+		}
+	}
+	mem_copy(state, inst->state, sizeof(state));
+}
+
+struct Xoshiro256_X4 xoshiro256_x4_init(struct Xoshiro256 * source) {
+	struct Xoshiro256_X4 ret;
+	for (u32 lane = 0; lane < 4; lane++) {
+		for (u32 i = 0; i < 4; i++)
+			ret.state[i][lane] = source->state[i];
+		xoshiro256_jump(source);
+	}
+	return ret;
+}
+
+AttrFileLocal()
+void xoshiro256_x4_step(struct Xoshiro256_X4 * inst, u64 * target) {
+	for (u32 lane = 0; lane < 4; lane++) {
+		struct Xoshiro256 it = {{
+			inst->state[0][lane], inst->state[1][lane],
+			inst->state[2][lane], inst->state[3][lane],
+		}};
+		target[lane] = xoshiro256_next(&it);
+		for (u32 i = 0; i < 4; i++)
+			inst->state[i][lane] = it.state[i];
+	}
+}
+
+void xoshiro256_x4_fill_u32(struct Xoshiro256_X4 * inst, size_t count, u32 * target) {
+	size_t i = 0;
+#if SIMD_AVX2
+	__m256i s0 = _mm256_loadu_si256((__m256i const *)(void const *)inst->state[0]);
+	__m256i s1 = _mm256_loadu_si256((__m256i const *)(void const *)inst->state[1]);
+	__m256i s2 = _mm256_loadu_si256((__m256i const *)(void const *)inst->state[2]);
+	__m256i s3 = _mm256_loadu_si256((__m256i const *)(void const *)inst->state[3]);
+	for (; i + 8 <= count; i += 8) {
+		// @note `x * 5` and `x * 9` as shifts and adds
+		__m256i const scaled = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+		__m256i const rotated = u64x4_rotl(scaled, 7);
+		_mm256_storeu_si256((__m256i *)(void *)(target + i), _mm256_add_epi64(_mm256_slli_epi64(rotated, 3), rotated));
+
+		__m256i const t = _mm256_slli_epi64(s1, 17);
+		s2 = _mm256_xor_si256(s2, s0);
+		s3 = _mm256_xor_si256(s3, s1);
+		s1 = _mm256_xor_si256(s1, s2);
+		s0 = _mm256_xor_si256(s0, s3);
+		s2 = _mm256_xor_si256(s2, t);
+		s3 = u64x4_rotl(s3, 45);
+	}
+	_mm256_storeu_si256((__m256i *)(void *)inst->state[0], s0);
+	_mm256_storeu_si256((__m256i *)(void *)inst->state[1], s1);
+	_mm256_storeu_si256((__m256i *)(void *)inst->state[2], s2);
+	_mm256_storeu_si256((__m256i *)(void *)inst->state[3], s3);
+#endif
+	// @note a step yields 8 values, the remainder of a partial one is dropped
+	for (; i < count; i += 8) {
+		u64 values[4];
+		xoshiro256_x4_step(inst, values);
+		mem_copy(values, target + i, sizeof(*target) * min_size(count - i, 8));
+	}
+}
+
+void xoshiro256_x4_fill_f32(struct Xoshiro256_X4 * inst, size_t count, f32 * target) {
+	u32 buffer[RANDOM_CHUNK];
+	for (size_t offset = 0; offset < count; offset += RANDOM_CHUNK) {
+		size_t const chunk = min_size(count - offset, RANDOM_CHUNK);
+		xoshiro256_x4_fill_u32(inst, chunk, buffer);
+		random_unit_batch(chunk, buffer, target + offset);
+	}
+}
+
+// ---- ---- ---- ----
+// functions: noise
+// ---- ---- ---- ----
+
+/*
+@note lattice noise over a multiplicative hash of integer coordinates;
+gradients are diagonals `(±1, ±1, ±1)` with signs from the top bits of the hash,
+applied via the sign bit; the vector kernels match the scalar ones bit for bit
+*/
+
+#define NOISE_PRIME_X 0x9e3779b1u
+#define NOISE_PRIME_Y 0x85ebca77u
+#define NOISE_PRIME_Z 0xc2b2ae3du
+
+// @note the extremum of a 3d lattice with diagonal gradients is `1.5`
+#define NOISE_GRADIENT3_SCALE (2.0f / 3.0f)
+
+AttrFileLocal()
+u32 noise_mix(u32 hash, s32 coordinate, u32 prime) {
+	hash = (hash ^ (u32)coordinate) * prime;
+	return hash ^ (hash >> 15);
+}
+
+AttrFileLocal()
+s32 noise_floor(f32 value) {
+	s32 const ret = (s32)value;
+	return ret - ((f32)ret > value);
+}
+
+AttrFileLocal()
+f32 noise_fade(f32 t) {
+	return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+AttrFileLocal()
+f32 noise_sign(f32 value, u32 hash) {
+	bits32 bits = {.as_f = value};
+	bits.as_u ^= hash & 0x80000000u;
+	return bits.as_f;
+}
+
+AttrFileLocal()
+f32 noise_value(u32 hash) {
+	return (f32)(hash >> 8) * (2.0f / 16777216.0f) - 1;
+}
+
+AttrFileLocal()
+f32 noise_lattice2(u32 seed, vec2 position, bool gradient) {
+	s32 const ix = noise_floor(position.x), iy = noise_floor(position.y);
+	f32 const fx = position.x - (f32)ix,   fy = position.y - (f32)iy;
+
+	u32 hx[2], hy[4]; f32 corners[4];
+	for (u32 c = 0; c < 2; c++) hx[c] = noise_mix(seed,          ix + (s32)c,        NOISE_PRIME_X);
+	for (u32 c = 0; c < 4; c++) hy[c] = noise_mix(hx[c & 1], iy + (s32)(c >> 1), NOISE_PRIME_Y);
+	for (u32 c = 0; c < 4; c++) {
+		corners[c] = gradient
+			? noise_sign(fx - (f32)(c & 1), hy[c]) + noise_sign(fy - (f32)(c >> 1), hy[c] << 1)
+			: noise_value(hy[c]);
+	}
+
+	f32 const u = noise_fade(fx), v = noise_fade(fy);
+	return lerp32(lerp32(corners[0], corners[1], u), lerp32(corners[2], corners[3], u), v);
+}
+
+AttrFileLocal()
+f32 noise_lattice3(u32 seed, vec3 position, bool gradient) {
+	s32 const ix = noise_floor(position.x), iy = noise_floor(position.y), iz = noise_floor(position.z);
+	f32 const fx = position.x - (f32)ix,   fy = position.y - (f32)iy,   fz = position.z - (f32)iz;
+
+	u32 hx[2], hy[4], hz[8]; f32 corners[8];
+	for (u32 c = 0; c < 2; c++) hx[c] = noise_mix(seed,      ix + (s32)c,        NOISE_PRIME_X);
+	for (u32 c = 0; c < 4; c++) hy[c] = noise_mix(hx[c & 1], iy + (s32)(c >> 1), NOISE_PRIME_Y);
+	for (u32 c = 0; c < 8; c++) hz[c] = noise_mix(hy[c & 3], iz + (s32)(c >> 2), NOISE_PRIME_Z);
+	for (u32 c = 0; c < 8; c++) {
+		corners[c] = gradient
+			? noise_sign(fx - (f32)(c & 1), hz[c]) + noise_sign(fy - (f32)((c >> 1) & 1), hz[c] << 1) + noise_sign(fz - (f32)(c >> 2), hz[c] << 2)
+			: noise_value(hz[c]);
+	}
+
+	f32 const u = noise_fade(fx), v = noise_fade(fy), w = noise_fade(fz);
+	f32 const ret = lerp32(
+		lerp32(lerp32(corners[0], corners[1], u), lerp32(corners[2], corners[3], u), v),
+		lerp32(lerp32(corners[4], corners[5], u), lerp32(corners[6], corners[7], u), v),
+		w
+	);
+	return gradient ? ret * NOISE_GRADIENT3_SCALE : ret;
+}
+
+#if F32XW_WIDTH > 0
+AttrFileLocal()
+s32xw s32xw_noise_mix(s32xw hash, s32xw coordinate, u32 prime) {
+	hash = s32xw_mul(s32xw_xor(hash, coordinate), s32xw_splat((s32)prime));
+	return s32xw_xor(hash, s32xw_shr(hash, 15));
+}
+
+AttrFileLocal()
+s32xw s32xw_noise_floor(f32xw value) {
+	s32xw const ret = s32xw_truncate(value);
+	return s32xw_add(ret, s32xw_bits(f32xw_gt(f32xw_convert(ret), value)));
+}
+
+AttrFileLocal()
+f32xw f32xw_noise_fade(f32xw t) {
+	f32xw const t3 = f32xw_mul(f32xw_mul(t, t), t);
+	f32xw const poly = f32xw_add(f32xw_mul(t, f32xw_sub(f32xw_mul(t, f32xw_splat(6)), f32xw_splat(15))), f32xw_splat(10));
+	return f32xw_mul(t3, poly);
+}
+
+AttrFileLocal()
+f32xw f32xw_noise_sign(f32xw value, s32xw hash) {
+	return f32xw_xor(value, f32xw_and(f32xw_bits(hash), f32xw_splat(-0.0f)));
+}
+
+AttrFileLocal()
+f32xw f32xw_noise_value(s32xw hash) {
+	f32xw const value = f32xw_convert(s32xw_shr(hash, 8));
+	return f32xw_sub(f32xw_mul(value, f32xw_splat(2.0f / 16777216.0f)), f32xw_splat(1));
+}
+
+AttrFileLocal()
+f32xw f32xw_noise_lerp(f32xw v1, f32xw v2, f32xw t) {
+	return f32xw_add(v1, f32xw_mul(f32xw_sub(v2, v1), t));
+}
+
+AttrFileLocal()
+f32xw f32xw_noise_lattice2(u32 seed, f32xw x, f32xw y, bool gradient) {
+	s32xw const ix = s32xw_noise_floor(x), iy = s32xw_noise_floor(y);
+	f32xw const fx = f32xw_sub(x, f32xw_convert(ix)), fy = f32xw_sub(y, f32xw_convert(iy));
+
+	s32xw hx[2], hy[4]; f32xw corners[4];
+	for (u32 c = 0; c < 2; c++) hx[c] = s32xw_noise_mix(s32xw_splat((s32)seed), s32xw_add(ix, s32xw_splat((s32)c)), NOISE_PRIME_X);
+	for (u32 c = 0; c < 4; c++) hy[c] = s32xw_noise_mix(hx[c & 1], s32xw_add(iy, s32xw_splat((s32)(c >> 1))), NOISE_PRIME_Y);
+	for (u32 c = 0; c < 4; c++) {
+		corners[c] = gradient
+			? f32xw_add(
+				f32xw_noise_sign(f32xw_sub(fx, f32xw_splat((f32)(c & 1))),  hy[c]),
+				f32xw_noise_sign(f32xw_sub(fy, f32xw_splat((f32)(c >> 1))), s32xw_shl(hy[c], 1)))
+			: f32xw_noise_value(hy[c]);
+	}
+
+	f32xw const u = f32xw_noise_fade(fx), v = f32xw_noise_fade(fy);
+	return f32xw_noise_lerp(f32xw_noise_lerp(corners[0], corners[1], u), f32xw_noise_lerp(corners[2], corners[3], u), v);
+}
+
+AttrFileLocal()
+f32xw f32xw_noise_lattice3(u32 seed, f32xw x, f32xw y, f32xw z, bool gradient) {
+	s32xw const ix = s32xw_noise_floor(x), iy = s32xw_noise_floor(y), iz = s32xw_noise_floor(z);
+	f32xw const fx = f32xw_sub(x, f32xw_convert(ix)), fy = f32xw_sub(y, f32xw_convert(iy)), fz = f32xw_sub(z, f32xw_convert(iz));
+
+	s32xw hx[2], hy[4], hz[8]; f32xw corners[8];
+	for (u32 c = 0; c < 2; c++) hx[c] = s32xw_noise_mix(s32xw_splat((s32)seed), s32xw_add(ix, s32xw_splat((s32)c)), NOISE_PRIME_X);
+	for (u32 c = 0; c < 4; c++) hy[c] = s32xw_noise_mix(hx[c & 1], s32xw_add(iy, s32xw_splat((s32)(c >> 1))), NOISE_PRIME_Y);
+	for (u32 c = 0; c < 8; c++) hz[c] = s32xw_noise_mix(hy[c & 3], s32xw_add(iz, s32xw_splat((s32)(c >> 2))), NOISE_PRIME_Z);
+	for (u32 c = 0; c < 8; c++) {
+		corners[c] = gradient
+			? f32xw_add(f32xw_add(
+				f32xw_noise_sign(f32xw_sub(fx, f32xw_splat((f32)(c & 1))),        hz[c]),
+				f32xw_noise_sign(f32xw_sub(fy, f32xw_splat((f32)((c >> 1) & 1))), s32xw_shl(hz[c], 1))),
+				f32xw_noise_sign(f32xw_sub(fz, f32xw_splat((f32)(c >> 2))),       s32xw_shl(hz[c], 2)))
+			: f32xw_noise_value(hz[c]);
+	}
+
+	f32xw const u = f32xw_noise_fade(fx), v = f32xw_noise_fade(fy), w = f32xw_noise_fade(fz);
+	f32xw const ret = f32xw_noise_lerp(
+		f32xw_noise_lerp(f32xw_noise_lerp(corners[0], corners[1], u), f32xw_noise_lerp(corners[2], corners[3], u), v),
+		f32xw_noise_lerp(f32xw_noise_lerp(corners[4], corners[5], u), f32xw_noise_lerp(corners[6], corners[7], u), v),
+		w
+	);
+	return gradient ? f32xw_mul(ret, f32xw_splat(NOISE_GRADIENT3_SCALE)) : ret;
+}
+#endif
+
+f32 noise_value2(u32 seed, vec2 position)    { return noise_lattice2(seed, position, false); }
+f32 noise_value3(u32 seed, vec3 position)    { return noise_lattice3(seed, position, false); }
+f32 noise_gradient2(u32 seed, vec2 position) { return noise_lattice2(seed, position, true); }
+f32 noise_gradient3(u32 seed, vec3 position) { return noise_lattice3(seed, position, true); }
+
+AttrFileLocal()
+void noise_lattice2_batch(u32 seed, size_t count, vec2 const * source, f32 * target, bool gradient) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		f32 xs[F32XW_WIDTH], ys[F32XW_WIDTH];
+		for (u32 k = 0; k < F32XW_WIDTH; k++) {
+			xs[k] = source[i + k].x;
+			ys[k] = source[i + k].y;
+		}
+		f32xw_store(target + i, f32xw_noise_lattice2(seed, f32xw_load(xs), f32xw_load(ys), gradient));
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = noise_lattice2(seed, source[i], gradient);
+}
+
+AttrFileLocal()
+void noise_lattice3_batch(u32 seed, size_t count, vec3 const * source, f32 * target, bool gradient) {
+	size_t i = 0;
+#if F32XW_WIDTH > 0
+	for (; i + F32XW_WIDTH <= count; i += F32XW_WIDTH) {
+		f32 xs[F32XW_WIDTH], ys[F32XW_WIDTH], zs[F32XW_WIDTH];
+		for (u32 k = 0; k < F32XW_WIDTH; k++) {
+			xs[k] = source[i + k].x;
+			ys[k] = source[i + k].y;
+			zs[k] = source[i + k].z;
+		}
+		f32xw_store(target + i, f32xw_noise_lattice3(seed, f32xw_load(xs), f32xw_load(ys), f32xw_load(zs), gradient));
+	}
+#endif
+	for (; i < count; i++)
+		target[i] = noise_lattice3(seed, source[i], gradient);
+}
+
+void noise_value2_batch(u32 seed, size_t count, vec2 const * source, f32 * target)    { noise_lattice2_batch(seed, count, source, target, false); }
+void noise_value3_batch(u32 seed, size_t count, vec3 const * source, f32 * target)    { noise_lattice3_batch(seed, count, source, target, false); }
+void noise_gradient2_batch(u32 seed, size_t count, vec2 const * source, f32 * target) { noise_lattice2_batch(seed, count, source, target, true); }
+void noise_gradient3_batch(u32 seed, size_t count, vec3 const * source, f32 * target) { noise_lattice3_batch(seed, count, source, target, true); }
+
+// ---- ---- ---- ----
+// functions: s32 math, vector
 // ---- ---- ---- ----
 
 svec2 svec2_add(svec2 l, svec2 r) { return (svec2){l.x + r.x, l.y + r.y}; }
@@ -985,474 +3779,2619 @@ s32   svec2_dot(svec2 l, svec2 r) { return l.x * r.x + l.y * r.y; }
 svec2 svec2_muls(svec2 l, s32 r) { return (svec2){l.x * r, l.y * r}; }
 svec2 svec2_divs(svec2 l, s32 r) { return (svec2){l.x / r, l.y / r}; }
 
-svec3 svec3_add(svec3 l, svec3 r) { return (svec3){l.x + r.x, l.y + r.y, l.z + r.z}; }
-svec3 svec3_sub(svec3 l, svec3 r) { return (svec3){l.x - r.x, l.y - r.y, l.z - r.z}; }
-svec3 svec3_mul(svec3 l, svec3 r) { return (svec3){l.x * r.x, l.y * r.y, l.z * r.z}; }
-svec3 svec3_div(svec3 l, svec3 r) { return (svec3){l.x / r.x, l.y / r.y, l.z / r.z}; }
-s32   svec3_dot(svec3 l, svec3 r) { return l.x * r.x + l.y * r.y + l.z * r.z; }
-svec3 svec3_muls(svec3 l, s32 r) { return (svec3){l.x * r, l.y * r, l.z * r}; }
-svec3 svec3_divs(svec3 l, s32 r) { return (svec3){l.x / r, l.y / r, l.z / r}; }
+svec3 svec3_add(svec3 l, svec3 r) { return (svec3){l.x + r.x, l.y + r.y, l.z + r.z}; }
+svec3 svec3_sub(svec3 l, svec3 r) { return (svec3){l.x - r.x, l.y - r.y, l.z - r.z}; }
+svec3 svec3_mul(svec3 l, svec3 r) { return (svec3){l.x * r.x, l.y * r.y, l.z * r.z}; }
+svec3 svec3_div(svec3 l, svec3 r) { return (svec3){l.x / r.x, l.y / r.y, l.z / r.z}; }
+s32   svec3_dot(svec3 l, svec3 r) { return l.x * r.x + l.y * r.y + l.z * r.z; }
+svec3 svec3_muls(svec3 l, s32 r) { return (svec3){l.x * r, l.y * r, l.z * r}; }
+svec3 svec3_divs(svec3 l, s32 r) { return (svec3){l.x / r, l.y / r, l.z / r}; }
+
+svec4 svec4_add(svec4 l, svec4 r) { return (svec4){l.x + r.x, l.y + r.y, l.z + r.z, l.w + r.w}; }
+svec4 svec4_sub(svec4 l, svec4 r) { return (svec4){l.x - r.x, l.y - r.y, l.z - r.z, l.w - r.w}; }
+svec4 svec4_mul(svec4 l, svec4 r) { return (svec4){l.x * r.x, l.y * r.y, l.z * r.z, l.w * r.w}; }
+svec4 svec4_div(svec4 l, svec4 r) { return (svec4){l.x / r.x, l.y / r.y, l.z / r.z, l.w / r.w}; }
+s32   svec4_dot(svec4 l, svec4 r) { return l.x * r.x + l.y * r.y + l.z * r.z + l.w * r.w; }
+svec4 svec4_muls(svec4 l, s32 r) { return (svec4){l.x * r, l.y * r, l.z * r, l.w * r}; }
+svec4 svec4_divs(svec4 l, s32 r) { return (svec4){l.x / r, l.y / r, l.z / r, l.w / r}; }
+
+s32   svec2_crs(svec2 l, svec2 r) { return l.x * r.y - l.y * r.x; }
+svec3 svec3_crs(svec3 l, svec3 r) { return (svec3){
+	l.y * r.z - l.z * r.y,
+	l.z * r.x - l.x * r.z,
+	l.x * r.y - l.y * r.x,
+}; }
+
+// ---- ---- ---- ----
+// functions: u32 math, vector
+// ---- ---- ---- ----
+
+uvec2 uvec2_add(uvec2 l, uvec2 r) { return (uvec2){l.x + r.x, l.y + r.y}; }
+uvec2 uvec2_sub(uvec2 l, uvec2 r) { return (uvec2){l.x - r.x, l.y - r.y}; }
+uvec2 uvec2_mul(uvec2 l, uvec2 r) { return (uvec2){l.x * r.x, l.y * r.y}; }
+uvec2 uvec2_div(uvec2 l, uvec2 r) { return (uvec2){l.x / r.x, l.y / r.y}; }
+u32   uvec2_dot(uvec2 l, uvec2 r) { return l.x * r.x + l.y * r.y; }
+uvec2 uvec2_muls(uvec2 l, u32 r) { return (uvec2){l.x * r, l.y * r}; }
+uvec2 uvec2_divs(uvec2 l, u32 r) { return (uvec2){l.x / r, l.y / r}; }
+
+uvec3 uvec3_add(uvec3 l, uvec3 r) { return (uvec3){l.x + r.x, l.y + r.y, l.z + r.z}; }
+uvec3 uvec3_sub(uvec3 l, uvec3 r) { return (uvec3){l.x - r.x, l.y - r.y, l.z - r.z}; }
+uvec3 uvec3_mul(uvec3 l, uvec3 r) { return (uvec3){l.x * r.x, l.y * r.y, l.z * r.z}; }
+uvec3 uvec3_div(uvec3 l, uvec3 r) { return (uvec3){l.x / r.x, l.y / r.y, l.z / r.z}; }
+u32   uvec3_dot(uvec3 l, uvec3 r) { return l.x * r.x + l.y * r.y + l.z * r.z; }
+uvec3 uvec3_muls(uvec3 l, u32 r) { return (uvec3){l.x * r, l.y * r, l.z * r}; }
+uvec3 uvec3_divs(uvec3 l, u32 r) { return (uvec3){l.x / r, l.y / r, l.z / r}; }
+
+uvec4 uvec4_add(uvec4 l, uvec4 r) { return (uvec4){l.x + r.x, l.y + r.y, l.z + r.z, l.w + r.w}; }
+uvec4 uvec4_sub(uvec4 l, uvec4 r) { return (uvec4){l.x - r.x, l.y - r.y, l.z - r.z, l.w - r.w}; }
+uvec4 uvec4_mul(uvec4 l, uvec4 r) { return (uvec4){l.x * r.x, l.y * r.y, l.z * r.z, l.w * r.w}; }
+uvec4 uvec4_div(uvec4 l, uvec4 r) { return (uvec4){l.x / r.x, l.y / r.y, l.z / r.z, l.w / r.w}; }
+u32   uvec4_dot(uvec4 l, uvec4 r) { return l.x * r.x + l.y * r.y + l.z * r.z + l.w * r.w; }
+uvec4 uvec4_muls(uvec4 l, u32 r) { return (uvec4){l.x * r, l.y * r, l.z * r, l.w * r}; }
+uvec4 uvec4_divs(uvec4 l, u32 r) { return (uvec4){l.x / r, l.y / r, l.z / r, l.w / r}; }
+
+// ---- ---- ---- ----
+// constants
+// ---- ---- ---- ----
+
+AttrGlobal() bits32 const bits_min32  = (bits32){.as_u = 0x00000001u};
+AttrGlobal() bits32 const bits_seq32  = (bits32){.as_u = 0x4b800000u}; // 2^24
+AttrGlobal() bits32 const bits_lim32  = (bits32){.as_u = 0x7f7fffffu}; // 2^127 * [1 .. 2)
+AttrGlobal() bits32 const bits_inf32  = (bits32){.as_u = 0x7f800000u}; // 2^128
+AttrGlobal() bits32 const bits_qnan32 = (bits32){.as_u = 0x7fc00000u}; // 2^128 * (1 .. 2)
+AttrGlobal() bits32 const bits_snan32 = (bits32){.as_u = 0x7fa00000u}; // 2^128 * (1 .. 2)
+
+AttrGlobal() bits64 const bits_min64  = (bits64){.as_u = 0x0000000000000001ull};
+AttrGlobal() bits64 const bits_seq64  = (bits64){.as_u = 0x4340000000000000ull}; // 2^53
+AttrGlobal() bits64 const bits_lim64  = (bits64){.as_u = 0x7fefffffffffffffull}; // 2^1023 * [1 .. 2)
+AttrGlobal() bits64 const bits_inf64  = (bits64){.as_u = 0x7ff0000000000000ull}; // 2^1024
+AttrGlobal() bits64 const bits_qnan64 = (bits64){.as_u = 0x7ff8000000000000ull}; // 2^1024 * (1 .. 2)
+AttrGlobal() bits64 const bits_snan64 = (bits64){.as_u = 0x7ff4000000000000ull}; // 2^1024 * (1 .. 2)
+
+// ground truth, 20 digits after the decimal searator                              6.28318530717958647693
+AttrGlobal() bits32 const bits_tau32 = (bits32){.as_u = 0x40c90fdbu};           // 6.2831854f
+AttrGlobal() bits64 const bits_tau64 = (bits64){.as_u = 0x401921fb54442d18ull}; // 6.283185307179586
+
+// ground truth, 20 digits after the decimal searator                             3.14159265358979323846
+AttrGlobal() bits32 const bits_pi32 = (bits32){.as_u = 0x40490fdbu};           // 3.1415927f
+AttrGlobal() bits64 const bits_pi64 = (bits64){.as_u = 0x400921fb54442d18ull}; // 3.141592653589793
+
+// ground truth, 20 digits after the decimal searator                             2.71828182845904523536
+AttrGlobal() bits32 const bits_e32  = (bits32){.as_u = 0x402df855u};           // 2.7182819f
+AttrGlobal() bits64 const bits_e64  = (bits64){.as_u = 0x4005bf0a8b145769ull}; // 2.718281828459045
+
+AttrGlobal() vec2 const vec2_0  = (vec2){0, 0};
+AttrGlobal() vec2 const vec2_1  = (vec2){1, 1};
+AttrGlobal() vec2 const vec2_x1 = (vec2){1, 0};
+AttrGlobal() vec2 const vec2_y1 = (vec2){0, 1};
+
+AttrGlobal() vec3 const vec3_0  = (vec3){0, 0, 0};
+AttrGlobal() vec3 const vec3_1  = (vec3){1, 1, 1};
+AttrGlobal() vec3 const vec3_x1 = (vec3){1, 0, 0};
+AttrGlobal() vec3 const vec3_y1 = (vec3){0, 1, 0};
+AttrGlobal() vec3 const vec3_z1 = (vec3){0, 0, 1};
+
+AttrGlobal() vec4 const vec4_0  = (vec4){0, 0, 0, 0};
+AttrGlobal() vec4 const vec4_1  = (vec4){1, 1, 1, 1};
+AttrGlobal() vec4 const vec4_x1 = (vec4){1, 0, 0, 0};
+AttrGlobal() vec4 const vec4_y1 = (vec4){0, 1, 0, 0};
+AttrGlobal() vec4 const vec4_z1 = (vec4){0, 0, 1, 0};
+AttrGlobal() vec4 const vec4_w1 = (vec4){0, 0, 0, 1};
+
+AttrGlobal() quat const quat_i = (quat){0, 0, 0, 1};
+
+AttrGlobal() mat2 const mat2_i = (mat2){
+	{1, 0},
+	{0, 1},
+};
+
+AttrGlobal() mat3 const mat3_i = (mat3){
+	{1, 0, 0},
+	{0, 1, 0},
+	{0, 0, 1},
+};
+
+AttrGlobal() mat4 const mat4_i = (mat4){
+	{1, 0, 0, 0},
+	{0, 1, 0, 0},
+	{0, 0, 1, 0},
+	{0, 0, 0, 1},
+};
+
+// ---- ---- ---- ----
+// memory
+// ---- ---- ---- ----
+
+struct Memory_Arena {
+	struct Memory_Arena_IInfo info;
+	size_t reserved, commited, base, offset;
+	struct Memory_Arena * prev, * curr;
+	// @todo pad and protect the boundary
+};
+
+struct Memory_Arena * arena_init(struct Memory_Arena_IInfo info) {
+	Assert(g_os_info.page_size > 0, "[base] call `os_init` first\n");
+	size_t const maximum = SIZE_MAX - (sizeof(struct Memory_Arena) + g_os_info.page_size - 1);
+
+	Assert(info.reserve <= maximum, "[base] trying to reserve too much\n");
+	Assert(info.commit <= info.reserve, "[base] trying to commit too much\n");
+
+	size_t const reserve = align_size(sizeof(struct Memory_Arena) + info.reserve, g_os_info.page_size);
+	size_t const commit = align_size(sizeof(struct Memory_Arena) + info.commit, g_os_info.page_size);
+	struct Memory_Arena * ret = os_memory_reserve(reserve);
+	if (ret == NULL)
+		os_exit(1);
+	os_memory_commit(ret, commit);
+	*ret = (struct Memory_Arena){
+		.info = info,
+		.reserved = reserve,
+		.commited = commit,
+		.offset = sizeof(struct Memory_Arena),
+		//
+		.curr = ret,
+	};
+	return ret;
+}
+
+void memory_arena_free(struct Memory_Arena * arena) {
+	struct Memory_Arena * curr = arena->curr;
+	for (struct Memory_Arena * prev = NULL; curr != NULL; curr = prev) {
+		prev = curr->prev;
+		os_memory_release(curr, curr->reserved);
+	}
+}
+
+size_t memory_arena_get_position(struct Memory_Arena const * arena) {
+	struct Memory_Arena const * curr = arena->curr;
+	return curr->base + curr->offset;
+}
+
+void memory_arena_set_position(struct Memory_Arena * arena, size_t position) {
+	struct Memory_Arena * curr = arena->curr;
+
+	Assert(position <= memory_arena_get_position(arena), "[base] overflow\n");
+	Assert(position >= sizeof(struct Memory_Arena), "[base] underflow\n");
+	for (struct Memory_Arena * it = NULL; curr->base >= position; curr = it) {
+		it = curr->prev;
+		os_memory_release(curr, curr->reserved);
+	}
+
+	curr->offset = position - curr->base;
+	arena->curr = curr;
+}
+
+void * memory_arena_push(struct Memory_Arena * arena, size_t size, size_t align) {
+	Assert(size > 0, "[base] size should be positive\n");
+	Assert(align > 0, "[base] alignment should be positive\n");
+	struct Memory_Arena * curr = arena->curr;
+
+	if (curr->offset + size > curr->reserved) {
+		curr = arena_init((struct Memory_Arena_IInfo){
+			.reserve = max_size(curr->info.reserve, sizeof(struct Memory_Arena) + size),
+			.commit = max_size(curr->info.commit, sizeof(struct Memory_Arena) + size),
+		});
+		curr->base = memory_arena_get_position(arena);
+		curr->prev = arena;
+		arena->curr = curr;
+	}
+
+	curr->offset = align_size(curr->offset, align);
+	void * memory = (u8 *)curr + curr->offset;
+
+	curr->offset += size;
+	if (curr->commited < curr->offset) {
+		curr->commited = align_size(curr->offset, g_os_info.page_size);
+		os_memory_commit(curr, curr->commited);
+	}
+
+	return memory;
+}
+
+void memory_arena_pop(struct Memory_Arena * arena, size_t size) {
+	size_t const position = memory_arena_get_position(arena);
+	memory_arena_set_position(arena, position - size);
+}
+
+// ---- ---- ---- ----
+// thread context
+// ---- ---- ---- ----
+
+AttrFileLocal() AttrThreadLocal()
+struct Thread_Ctx {
+	struct Memory_Arena * scratch;
+} ftl_thread_ctx;
+
+void thread_ctx_init(void) {
+	ftl_thread_ctx.scratch = arena_init((struct Memory_Arena_IInfo){
+		.reserve = MB(64),
+		.commit = KB(64),
+	});
+}
+
+void thread_ctx_free(void) {
+	memory_arena_free(ftl_thread_ctx.scratch);
+	mem_zero(&ftl_thread_ctx, sizeof(ftl_thread_ctx));
+}
+
+struct Memory_Arena * thread_ctx_get_scratch(void) {
+	return ftl_thread_ctx.scratch;
+}
+
+// ---- ---- ---- ----
+// workers
+// ---- ---- ---- ----
+
+AttrFileLocal()
+struct Workers {
+	struct OS_Thread    * threads[WORKERS_MAX];
+	struct OS_Semaphore * wake;
+	struct OS_Semaphore * done;
+	u32  threads_count;
+	bool quit;
+	// @note a batch; fields are published before `unclaimed` is set
+	void (* function)(void * context);
+	u8 *   contexts;
+	size_t stride;
+	u32    count;
+	s32 volatile unclaimed;
+	s32 volatile unfinished;
+} fl_workers;
+
+AttrFileLocal()
+void workers_drain(void) {
+	// @note stale claims of idle threads land below zero and never touch the batch
+	for (s32 left; (left = os_atomic_add(&fl_workers.unclaimed, -1)) >= 0; /**/) {
+		u32 const index = fl_workers.count - 1 - (u32)left;
+		fl_workers.function(fl_workers.contexts + fl_workers.stride * index);
+		if (os_atomic_add(&fl_workers.unfinished, -1) == 0)
+			os_semaphore_signal(fl_workers.done, 1);
+	}
+}
+
+AttrFileLocal()
+void workers_loop(void * context) {
+	(void)context;
+	while (true) {
+		os_semaphore_wait(fl_workers.wake);
+		if (fl_workers.quit) break;
+		workers_drain();
+	}
+}
+
+void workers_init(void) {
+	u32 const threads_count = min_u32(max_u32(g_os_info.processor_count, 1), WORKERS_MAX) - 1;
+	fl_workers = (struct Workers){
+		.wake = os_semaphore_init((struct OS_Semaphore_IInfo){.limit = INT32_MAX}),
+		.done = os_semaphore_init((struct OS_Semaphore_IInfo){.limit = 1}),
+		.threads_count = threads_count,
+		.unclaimed = -1,
+	};
+	for (u32 i = 0; i < threads_count; i++)
+		fl_workers.threads[i] = os_thread_init((struct OS_Thread_IInfo){
+			.function = workers_loop,
+		});
+}
+
+void workers_free(void) {
+	if (fl_workers.wake == NULL)
+		return;
+	fl_workers.quit = true;
+	os_semaphore_signal(fl_workers.wake, fl_workers.threads_count);
+	for (u32 i = 0; i < fl_workers.threads_count; i++) {
+		os_thread_join(fl_workers.threads[i]);
+		os_thread_free(fl_workers.threads[i]);
+	}
+	os_semaphore_free(fl_workers.wake);
+	os_semaphore_free(fl_workers.done);
+	mem_zero(&fl_workers, sizeof(fl_workers));
+}
+
+u32 workers_get_count(void) {
+	return fl_workers.threads_count + 1;
+}
+
+void workers_run(void (* function)(void * context), void * contexts, size_t stride, u32 count) {
+	if (fl_workers.threads_count == 0 || count <= 1) {
+		for (u32 i = 0; i < count; i++)
+			function((u8 *)contexts + stride * i);
+		return;
+	}
+
+	Assert(fl_workers.function == NULL, "[base] workers are busy\n");
+	fl_workers.function   = function;
+	fl_workers.contexts   = contexts;
+	fl_workers.stride     = stride;
+	fl_workers.count      = count;
+	fl_workers.unfinished = (s32)count;
+	os_atomic_set(&fl_workers.unclaimed, (s32)count);
+
+	os_semaphore_signal(fl_workers.wake, min_u32(count - 1, fl_workers.threads_count));
+	workers_drain();
+	os_semaphore_wait(fl_workers.done);
+	fl_workers.function = NULL;
+}
+
+// ---- ---- ---- ----
+// file utilities
+// ---- ---- ---- ----
+
+arr8 base_file_read(struct Memory_Arena * arena, char const * name) {
+	arr8 ret = {0};
+	struct OS_File * file = os_file_init((struct OS_File_IInfo){
+		.name = name,
+		.access = OS_FILE_ACCESS_SEQUENTIAL,
+	});
+	if (file != NULL) {
+		u64 const required = os_file_get_size(file);
+		ret.capacity = min_u64(required + 1, ~ret.capacity);
+		AssertF(required <= ret.capacity, "[base] file \"%s\" is too large %llu / %zu\n", name, required, ret.capacity);
+		ret.buffer = MemoryArenaPushArray(arena, u8, ret.capacity);
+		ret.count = os_file_read(file, 0, ret.capacity, ret.buffer);
+		if (ret.count < ret.capacity)
+			ret.buffer[ret.count] = 0;
+		os_file_free(file);
+	}
+	return ret;
+}
+
+void base_file_read_batch(struct Memory_Arena * arena, u32 count, char const * const * names, arr8 * out) {
+	struct OS_File_Completion completions[16];
+
+	// @note the heap, as `arena` might well be the scratch
+	struct OS_File ** files = os_memory_heap(NULL, sizeof(*files) * count);
+	struct OS_File_Queue * queue = os_file_queue_init((struct OS_File_Queue_IInfo){
+		.capacity = max_u32(count, 1),
+	});
+
+	for (u32 i = 0; i < count; i++) {
+		out[i] = (arr8){0};
+		files[i] = os_file_init((struct OS_File_IInfo){
+			.name = names[i],
+			.async = true,
+			.access = OS_FILE_ACCESS_SEQUENTIAL,
+		});
+		if (files[i] == NULL)
+			continue;
+		u64 const required = os_file_get_size(files[i]);
+		out[i].capacity = min_u64(required + 1, ~out[i].capacity);
+		AssertF(required <= out[i].capacity, "[base] file \"%s\" is too large %llu / %zu\n", names[i], required, out[i].capacity);
+		out[i].buffer = MemoryArenaPushArray(arena, u8, out[i].capacity);
+		os_file_queue_submit(queue, (struct OS_File_Request){
+			.file    = files[i],
+			.size    = required,
+			.buffer  = out[i].buffer,
+			.context = out + i,
+		});
+	}
+
+	while (os_file_queue_get_pending(queue) > 0) {
+		u32 const received = os_file_queue_wait(queue, (u32)ArrayCount(completions), completions);
+		for (u32 i = 0; i < received; i++) {
+			arr8 * it = completions[i].context;
+			it->count = completions[i].ok ? (size_t)completions[i].size : 0;
+			if (it->count < it->capacity)
+				it->buffer[it->count] = 0;
+		}
+	}
+
+	os_file_queue_free(queue);
+	for (u32 i = 0; i < count; i++)
+		if (files[i] != NULL)
+			os_file_free(files[i]);
+	os_memory_heap(files, 0);
+}
+
+arr8 base_file_map(char const * name, bool read_ahead) {
+	arr8 ret = {0};
+	struct OS_File * file = os_file_init((struct OS_File_IInfo){
+		.name = name,
+		.access = read_ahead ? OS_FILE_ACCESS_SEQUENTIAL : OS_FILE_ACCESS_RANDOM,
+	});
+	if (file != NULL) {
+		u64 const size = os_file_get_size(file);
+		AssertF(size <= ~ret.count, "[base] file \"%s\" is too large %llu / %zu\n", name, size, ~ret.count);
+		ret.buffer = (u8 *)os_file_map(file, read_ahead);
+		ret.count = ret.capacity = (ret.buffer != NULL) ? (size_t)size : 0;
+		os_file_free(file);
+	}
+	return ret;
+}
+
+void base_file_unmap(arr8 * inst) {
+	if (inst->buffer != NULL)
+		os_file_unmap(inst->buffer, inst->count);
+	mem_zero(inst, sizeof(*inst));
+}
+
+bool base_file_write(char const * name, arr8 data) {
+	struct File_Writer writer = file_writer_init((struct File_Writer_IInfo){
+		.name = name,
+		.buffer_size = 1, // @note big writes skip the buffer anyway
+		.atomic = true,
+	});
+	file_writer_write(&writer, data.count, data.buffer);
+	return file_writer_free(&writer);
+}
+
+// ---- ---- ---- ----
+// file writer
+// ---- ---- ---- ----
+
+AttrFileLocal()
+void file_writer_put(struct File_Writer * inst, size_t size, void const * data) {
+	u64 const written = inst->append
+		? os_file_append(inst->file, size, data)
+		: os_file_write(inst->file, inst->offset, size, data);
+	inst->failed = inst->failed || (written != size);
+	inst->offset += written;
+}
+
+AttrFileLocal()
+void file_writer_flush(struct File_Writer * inst) {
+	if (inst->count == 0)
+		return;
+	file_writer_put(inst, inst->count, inst->buffer);
+	inst->count = 0;
+}
+
+struct File_Writer file_writer_init(struct File_Writer_IInfo info) {
+	Assert(!info.append || (!info.atomic && !info.direct), "[base] appending is neither atomic nor direct\n");
+	struct File_Writer ret = {
+		.name     = info.name,
+		.capacity = info.buffer_size > 0 ? info.buffer_size : FILE_WRITER_BUFFER_SIZE,
+		.append   = info.append,
+		.direct   = info.direct,
+	};
+
+	char const * name = info.name;
+	if (info.atomic) {
+		size_t const length = strlen(info.name);
+		ret.temporary = os_memory_heap(NULL, length + 5);
+		mem_copy(info.name, ret.temporary, length);
+		mem_copy(".tmp", ret.temporary + length, 5);
+		name = ret.temporary;
+	}
+
+	ret.file = os_file_init((struct OS_File_IInfo){
+		.name   = name,
+		.mode   = info.append ? OS_FILE_MODE_APPEND : OS_FILE_MODE_WRITE,
+		.direct = info.direct,
+		.access = OS_FILE_ACCESS_SEQUENTIAL,
+	});
+	if (ret.file == NULL) {
+		os_memory_heap(ret.temporary, 0);
+		ret.temporary = NULL;
+		return ret;
+	}
+
+	// @note direct transfers are whole pages from page-aligned memory
+	ret.capacity = align_size(ret.capacity, g_os_info.page_size);
+	ret.buffer = os_memory_reserve(ret.capacity);
+	os_memory_commit(ret.buffer, ret.capacity);
+	return ret;
+}
+
+bool file_writer_free(struct File_Writer * inst) {
+	bool ok = false;
+	if (inst->file != NULL) {
+		if (inst->direct && inst->count > 0) {
+			// @note pad the tail to a page and cut it off afterwards
+			u64 const size = inst->offset + inst->count;
+			size_t const padded = align_size(inst->count, g_os_info.page_size);
+			mem_zero(inst->buffer + inst->count, padded - inst->count);
+			file_writer_put(inst, padded, inst->buffer);
+			inst->count = 0;
+			os_file_set_size(inst->file, size);
+		}
+		else file_writer_flush(inst);
+
+		if (inst->temporary != NULL && !inst->failed)
+			os_file_flush(inst->file);
+		os_file_free(inst->file);
+
+		ok = !inst->failed;
+		if (inst->temporary != NULL) {
+			ok = ok && os_file_replace(inst->temporary, inst->name);
+			if (!ok) os_file_delete(inst->temporary);
+		}
+
+		os_memory_decommit(inst->buffer, inst->capacity);
+		os_memory_release(inst->buffer, inst->capacity);
+		os_memory_heap(inst->temporary, 0);
+	}
+	mem_zero(inst, sizeof(*inst));
+	return ok;
+}
+
+void file_writer_write(struct File_Writer * inst, size_t size, void const * data) {
+	if (inst->file == NULL)
+		return;
+	u8 const * source = data;
+
+	// @note buffered writes don't care for alignment, so big ones go straight away
+	if (!inst->direct && size >= inst->capacity) {
+		file_writer_flush(inst);
+		file_writer_put(inst, size, source);
+		return;
+	}
+
+	while (size > 0) {
+		size_t const step = min_size(size, inst->capacity - inst->count);
+		mem_copy(source, inst->buffer + inst->count, step);
+		inst->count += step;
+		source += step;
+		size -= step;
+		if (inst->count == inst->capacity)
+			file_writer_flush(inst);
+	}
+}
+
+// ---- ---- ---- ----
+// file stream
+// ---- ---- ---- ----
+
+AttrFileLocal()
+void file_stream_submit(struct File_Stream * inst) {
+	if (inst->submitted >= inst->size)
+		return;
+	u64 const chunk = inst->submitted / inst->chunk_size;
+	u64 const size = min_u64(inst->size - inst->submitted, inst->chunk_size);
+	os_file_queue_submit(inst->queue, (struct OS_File_Request){
+		.file    = inst->file,
+		.offset  = inst->submitted,
+		.size    = size,
+		.buffer  = inst->buffer + inst->chunk_size * (chunk & 1),
+		.context = inst->buffer + inst->chunk_size * (chunk & 1),
+	});
+	inst->submitted += size;
+}
+
+struct File_Stream file_stream_init(struct File_Stream_IInfo info) {
+	struct File_Stream ret = {
+		.chunk_size = info.chunk_size > 0 ? info.chunk_size : FILE_STREAM_CHUNK_SIZE,
+	};
+	if (info.view.buffer != NULL) {
+		ret.view = info.view.buffer;
+		ret.size = info.view.count;
+		os_memory_prefetch(ret.view, (size_t)min_u64(ret.size, ret.chunk_size));
+		return ret;
+	}
+	ret.file = os_file_init((struct OS_File_IInfo){
+		.name = info.name,
+		.async = true,
+		.access = OS_FILE_ACCESS_SEQUENTIAL,
+	});
+	if (ret.file == NULL)
+		return ret;
+	ret.size = os_file_get_size(ret.file);
+	ret.queue = os_file_queue_init((struct OS_File_Queue_IInfo){
+		.capacity = 2,
+	});
+	ret.buffer = os_memory_heap(NULL, ret.chunk_size * 2);
+	file_stream_submit(&ret);
+	return ret;
+}
+
+void file_stream_free(struct File_Stream * inst) {
+	if (inst->file != NULL) {
+		os_file_queue_free(inst->queue);
+		os_file_free(inst->file);
+		os_memory_heap(inst->buffer, 0);
+	}
+	mem_zero(inst, sizeof(*inst));
+}
+
+arr8 file_stream_next(struct File_Stream * inst) {
+	if (inst->view != NULL) {
+		size_t const size = (size_t)min_u64(inst->size - inst->submitted, inst->chunk_size);
+		arr8 const ret = {
+			.capacity = size,
+			.count    = size,
+			.buffer   = (u8 *)inst->view + inst->submitted,
+		};
+		inst->submitted += size;
+		inst->delivered += (size > 0);
+		// @note the system pages in the next chunk while this one is consumed
+		os_memory_prefetch(inst->view + inst->submitted, (size_t)min_u64(inst->size - inst->submitted, inst->chunk_size));
+		return ret;
+	}
+	if (inst->file == NULL)
+		return (arr8){0};
+	u8 * const expected = inst->buffer + inst->chunk_size * (inst->delivered & 1);
+
+	// @note the previous chunk is released, so its buffer takes the one after
+	file_stream_submit(inst);
+
+	struct OS_File_Completion completion = {
+		.context = inst->stash_context,
+		.size    = inst->stash_size,
+		.ok      = inst->stash_ok,
+	};
+	inst->stash_context = NULL;
+	while (completion.context != expected) {
+		if (completion.context != NULL) {
+			inst->stash_context = completion.context;
+			inst->stash_size    = completion.size;
+			inst->stash_ok      = completion.ok;
+		}
+		if (os_file_queue_wait(inst->queue, 1, &completion) == 0)
+			return (arr8){0};
+	}
+
+	inst->delivered++;
+	return (arr8){
+		.capacity = inst->chunk_size,
+		.count    = completion.ok ? (size_t)completion.size : 0,
+		.buffer   = expected,
+	};
+}
+
+// ---- ---- ---- ----
+// archive
+// ---- ---- ---- ----
+
+arr8 archive_pack(struct Memory_Arena * arena, u32 count, struct Archive_Source const * sources) {
+	// -- pack blobs and order entries by hash
+	// @note the heap, as `arena` might well be the scratch
+	struct Archive_Entry * entries = os_memory_heap(NULL, sizeof(*entries) * count);
+	arr8 * blobs = os_memory_heap(NULL, sizeof(*blobs) * count);
+	u32 names_size = 0;
+	for (u32 i = 0; i < count; i++) {
+		struct Archive_Source const * source = sources + i;
+		size_t const name_length = strlen(source->name);
+		AssertF(name_length <= 0xffff, "[base] archive name is too long \"%s\"\n", source->name);
+
+		struct Archive_Entry entry = {
+			.hash        = hash64_fnv1(source->name, name_length),
+			.size        = source->data.count,
+			.size_packed = source->data.count,
+			.name_offset = names_size,
+			.name_length = (u16)name_length,
+			.compression = ARCHIVE_COMPRESSION_NONE,
+		};
+		arr8 blob = source->data;
+		if (source->compress && source->data.count > 0 && source->data.count <= ARCHIVE_UNPACK_MAX) {
+			size_t const bound = lz4_get_bound(source->data.count);
+			u8 * packed = os_memory_heap(NULL, bound);
+			size_t const packed_size = lz4_compress(source->data.count, source->data.buffer, bound, packed);
+			if (packed_size > 0 && packed_size <= source->data.count - source->data.count / 8) {
+				entry.size_packed = packed_size;
+				entry.compression = ARCHIVE_COMPRESSION_LZ4;
+				blob = (arr8){.buffer = packed, .count = packed_size, .capacity = bound};
+			}
+			else
+				os_memory_heap(packed, 0);
+		}
+		names_size += (u32)name_length;
+
+		// @note insertion sort, archives are not that large
+		u32 at = i;
+		for (; at > 0 && entries[at - 1].hash > entry.hash; at--) {
+			entries[at] = entries[at - 1];
+			blobs[at] = blobs[at - 1];
+		}
+		AssertF(at == 0 || entries[at - 1].hash != entry.hash, "[base] archive hash collision \"%s\"\n", source->name);
+		entries[at] = entry;
+		blobs[at] = blob;
+	}
+
+	// -- lay out
+	size_t size = sizeof(struct Archive_Header) + sizeof(*entries) * count + names_size;
+	for (u32 i = 0; i < count; i++) {
+		size = align_size(size, ARCHIVE_ALIGNMENT);
+		entries[i].offset = size;
+		size += blobs[i].count + 1;
+	}
+
+	arr8 ret = {
+		.buffer   = memory_arena_push(arena, size, ARCHIVE_ALIGNMENT),
+		.count    = size,
+		.capacity = size,
+	};
+	mem_zero(ret.buffer, size);
+	*(struct Archive_Header *)ret.buffer = (struct Archive_Header){
+		.magic         = ARCHIVE_MAGIC,
+		.version       = ARCHIVE_VERSION,
+		.entries_count = count,
+		.names_size    = names_size,
+	};
+	mem_copy(entries, ret.buffer + sizeof(struct Archive_Header), sizeof(*entries) * count);
+	char * names = (char *)ret.buffer + sizeof(struct Archive_Header) + sizeof(*entries) * count;
+	for (u32 i = 0; i < count; i++) {
+		struct Archive_Source const * source = sources + i;
+		mem_copy(source->name, names, strlen(source->name));
+		names += strlen(source->name);
+	}
+	for (u32 i = 0; i < count; i++) {
+		mem_copy(blobs[i].buffer, ret.buffer + entries[i].offset, blobs[i].count);
+		if (entries[i].compression != ARCHIVE_COMPRESSION_NONE)
+			os_memory_heap(blobs[i].buffer, 0);
+	}
+
+	os_memory_heap(blobs, 0);
+	os_memory_heap(entries, 0);
+	return ret;
+}
+
+AttrFileLocal()
+bool archive_entry_is_valid(struct Archive_Header const * header, struct Archive_Entry const * entry, u64 table_size, u64 view_size) {
+	// @note each blob is followed by a zero within the view
+	bool const blob_fits = entry->offset >= table_size
+		&& entry->offset      <  view_size
+		&& entry->size_packed <  view_size - entry->offset;
+	bool const name_fits = (u64)entry->name_offset + entry->name_length <= header->names_size;
+	// @note a sequence token expands to at most 255 bytes per input byte
+	bool const lz4_fits = entry->size <= entry->size_packed * 255 + 16
+		&& entry->size <= ARCHIVE_UNPACK_MAX;
+	switch (entry->compression) {
+		case ARCHIVE_COMPRESSION_NONE: return blob_fits && name_fits && entry->size == entry->size_packed;
+		case ARCHIVE_COMPRESSION_LZ4:  return blob_fits && name_fits && lz4_fits;
+	}
+	return false;
+}
+
+struct Archive archive_init(char const * name) {
+	// @note entries are accessed at random, only the table is fetched upfront
+	struct Archive ret = {.view = base_file_map(name, false)};
+	struct Archive_Header const * header = (void *)ret.view.buffer;
+	u64 const table_size = (header != NULL && ret.view.count >= sizeof(*header))
+		? (u64)sizeof(*header) + (u64)sizeof(*ret.entries) * header->entries_count + header->names_size
+		: ~0ull;
+	bool valid = table_size <= ret.view.count
+		&& header->magic   == ARCHIVE_MAGIC
+		&& header->version == ARCHIVE_VERSION;
+
+	// @note lookups binary search by hash, reads trust the bounds
+	struct Archive_Entry const * entries = valid ? (void *)(header + 1) : NULL;
+	for (u32 i = 0; valid && i < header->entries_count; i++)
+		valid = archive_entry_is_valid(header, entries + i, table_size, ret.view.count)
+		     && (i == 0 || entries[i - 1].hash < entries[i].hash);
+
+	if (!valid) {
+		if (ret.view.buffer != NULL)
+			fmt_print("[base] archive \"%s\" is malformed\n", name);
+		base_file_unmap(&ret.view);
+		return ret;
+	}
+	ret.entries       = (void *)(header + 1);
+	ret.entries_count = header->entries_count;
+	ret.names         = (char const *)(ret.entries + ret.entries_count);
+	os_memory_prefetch(ret.view.buffer, (size_t)table_size);
+	return ret;
+}
+
+void archive_free(struct Archive * inst) {
+	base_file_unmap(&inst->view);
+	mem_zero(inst, sizeof(*inst));
+}
+
+struct Archive_Entry const * archive_find(struct Archive const * inst, str8 name) {
+	u64 const hash = hash64_fnv1(name.buffer, name.count);
+	u32 low = 0, high = inst->entries_count;
+	while (low < high) {
+		u32 const middle = low + (high - low) / 2;
+		if (inst->entries[middle].hash < hash)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	if (low >= inst->entries_count)
+		return NULL;
+	struct Archive_Entry const * ret = inst->entries + low;
+	bool const found = ret->hash == hash
+		&& ret->name_length == name.count
+		&& mem_equals(inst->names + ret->name_offset, name.buffer, name.count);
+	return found ? ret : NULL;
+}
+
+arr8 archive_read(struct Archive const * inst, struct Archive_Entry const * entry, struct Memory_Arena * arena) {
+	Assert(entry >= inst->entries && entry < inst->entries + inst->entries_count, "[base] archive entry is foreign\n");
+	u8 const * blob = inst->view.buffer + entry->offset;
+	switch (entry->compression) {
+		case ARCHIVE_COMPRESSION_NONE: return (arr8){
+			.buffer   = (u8 *)blob,
+			.count    = (size_t)entry->size,
+			.capacity = (size_t)entry->size + 1,
+		};
+
+		case ARCHIVE_COMPRESSION_LZ4: {
+			u64 const arena_position = memory_arena_get_position(arena);
+			arr8 ret = {
+				.buffer   = memory_arena_push(arena, (size_t)entry->size + 1, ARCHIVE_ALIGNMENT),
+				.capacity = (size_t)entry->size + 1,
+			};
+			ret.count = lz4_decompress((size_t)entry->size_packed, blob, (size_t)entry->size, ret.buffer);
+			if (ret.count != entry->size) {
+				fmt_print("[base] archive entry \"%.*s\" is malformed\n", (int)entry->name_length, inst->names + entry->name_offset);
+				memory_arena_set_position(arena, arena_position);
+				return (arr8){0};
+			}
+			ret.buffer[ret.count] = 0;
+			return ret;
+		}
+	}
+	AssertF(false, "[base] unknown archive compression %u\n", entry->compression);
+	return (arr8){0};
+}
+
+// ---- ---- ---- ----
+// virtual file system
+// ---- ---- ---- ----
+
+AttrFileLocal()
+struct VFS {
+	struct VFS_IInfo info;
+	struct Archive   archive;
+	u32 overrides_count;
+	u64 overrides[VFS_OVERRIDES_MAX];
+} fl_vfs;
+
+void vfs_init(struct VFS_IInfo info) {
+	AssertF(info.roots_count <= VFS_ROOTS_MAX, "[base] too many roots %u / %u\n", info.roots_count, VFS_ROOTS_MAX);
+	fl_vfs = (struct VFS){.info = info};
+	if (info.archive != NULL)
+		fl_vfs.archive = archive_init(info.archive);
+}
+
+void vfs_free(void) {
+	archive_free(&fl_vfs.archive);
+	mem_zero(&fl_vfs, sizeof(fl_vfs));
+}
+
+#define VFS_PATH_CAPACITY 260
+
+AttrFileLocal()
+struct Archive_Entry const * vfs_find(char const * name) {
+	str8 const key = {
+		.count  = strlen(name),
+		.buffer = (u8 *)name,
+	};
+	u64 const hash = hash64_fnv1(key.buffer, key.count);
+	for (u32 i = 0; i < fl_vfs.overrides_count; i++)
+		if (fl_vfs.overrides[i] == hash)
+			return NULL;
+	return archive_find(&fl_vfs.archive, key);
+}
+
+// @note candidates are the roots in order, then the name as is
+AttrFileLocal()
+bool vfs_get_path(char const * name, u32 index, char * buffer) {
+	if (index > fl_vfs.info.roots_count)
+		return false;
+	char const * root = (index < fl_vfs.info.roots_count) ? fl_vfs.info.roots[index] : "";
+	u32 const length = fmt_buffer_n(buffer, VFS_PATH_CAPACITY, "%s%s", root, name);
+	// @note a truncated path might name another file, an empty one names none
+	if (length >= VFS_PATH_CAPACITY)
+		buffer[0] = '\0';
+	return true;
+}
+
+// @note the first candidate that exists
+AttrFileLocal()
+bool vfs_find_loose(char const * name, char * buffer) {
+	for (u32 i = 0; vfs_get_path(name, i, buffer); i++) {
+		struct OS_File * file = os_file_init((struct OS_File_IInfo){.name = buffer});
+		if (file != NULL) {
+			os_file_free(file);
+			return true;
+		}
+	}
+	return false;
+}
+
+arr8 vfs_read(struct Memory_Arena * arena, char const * name) {
+	struct Archive_Entry const * entry = vfs_find(name);
+	if (entry != NULL)
+		return archive_read(&fl_vfs.archive, entry, arena);
+
+	char path[VFS_PATH_CAPACITY];
+	for (u32 i = 0; vfs_get_path(name, i, path); i++) {
+		arr8 const ret = base_file_read(arena, path);
+		if (ret.buffer != NULL)
+			return ret;
+	}
+	return (arr8){0};
+}
+
+void vfs_read_batch(struct Memory_Arena * arena, u32 count, char const * const * names, arr8 * out) {
+	// @note the heap, as `arena` might well be the scratch
+	char (* paths)[VFS_PATH_CAPACITY] = os_memory_heap(NULL, sizeof(*paths) * count);
+	char const ** loose_names = os_memory_heap(NULL, sizeof(*loose_names) * count);
+	arr8        * loose_out   = os_memory_heap(NULL, sizeof(*loose_out)   * count);
+	u32         * loose_index = os_memory_heap(NULL, sizeof(*loose_index) * count);
+
+	u32 loose_count = 0;
+	for (u32 i = 0; i < count; i++) {
+		out[i] = (arr8){0};
+		struct Archive_Entry const * entry = vfs_find(names[i]);
+		if (entry != NULL) {
+			out[i] = archive_read(&fl_vfs.archive, entry, arena);
+			continue;
+		}
+		if (vfs_find_loose(names[i], paths[loose_count])) {
+			loose_names[loose_count] = paths[loose_count];
+			loose_index[loose_count] = i;
+			loose_count++;
+		}
+	}
+
+	// @note loose files are in flight all at once
+	base_file_read_batch(arena, loose_count, loose_names, loose_out);
+	for (u32 i = 0; i < loose_count; i++)
+		out[loose_index[i]] = loose_out[i];
+
+	os_memory_heap(loose_index, 0);
+	os_memory_heap(loose_out,   0);
+	os_memory_heap(loose_names, 0);
+	os_memory_heap(paths,       0);
+}
+
+struct File_Stream vfs_stream(struct Memory_Arena * arena, char const * name) {
+	struct Archive_Entry const * entry = vfs_find(name);
+	if (entry != NULL) {
+		arr8 const view = archive_read(&fl_vfs.archive, entry, arena);
+		return view.buffer != NULL
+			? file_stream_init((struct File_Stream_IInfo){.view = view})
+			: (struct File_Stream){0};
+	}
+
+	char path[VFS_PATH_CAPACITY];
+	for (u32 i = 0; vfs_get_path(name, i, path); i++) {
+		struct File_Stream const ret = file_stream_init((struct File_Stream_IInfo){.name = path});
+		if (ret.file != NULL)
+			return ret;
+	}
+	return (struct File_Stream){0};
+}
+
+void vfs_prefetch(u32 count, char const * const * names) {
+	char path[VFS_PATH_CAPACITY];
+	for (u32 i = 0; i < count; i++) {
+		struct Archive_Entry const * entry = vfs_find(names[i]);
+		if (entry != NULL) {
+			os_memory_prefetch(fl_vfs.archive.view.buffer + entry->offset, (size_t)entry->size_packed);
+			continue;
+		}
+
+		struct OS_File * file = NULL;
+		for (u32 c = 0; file == NULL && vfs_get_path(names[i], c, path); c++)
+			file = os_file_init((struct OS_File_IInfo){.name = path});
+		if (file != NULL) {
+			os_file_prefetch(file, 0, os_file_get_size(file));
+			os_file_free(file);
+		}
+	}
+}
+
+u64 vfs_get_write_nanos(char const * name) {
+	if (vfs_find(name) != NULL)
+		return 0;
+
+	char path[VFS_PATH_CAPACITY];
+	for (u32 i = 0; vfs_get_path(name, i, path); i++) {
+		struct OS_File * file = os_file_init((struct OS_File_IInfo){.name = path});
+		if (file != NULL) {
+			u64 const ret = os_file_get_write_nanos(file);
+			os_file_free(file);
+			return ret;
+		}
+	}
+	return 0;
+}
+
+void vfs_invalidate(str8 name) {
+	// @note packed files stay served from the archive, unless there's a loose one to replace them
+	char cname[VFS_PATH_CAPACITY];
+	if (name.count >= VFS_PATH_CAPACITY)
+		return;
+	mem_copy(name.buffer, cname, name.count);
+	cname[name.count] = '\0';
+	char path[VFS_PATH_CAPACITY];
+	if (!vfs_find_loose(cname, path))
+		return;
+
+	u64 const hash = hash64_fnv1(name.buffer, name.count);
+	for (u32 i = 0; i < fl_vfs.overrides_count; i++)
+		if (fl_vfs.overrides[i] == hash)
+			return;
+	AssertF(fl_vfs.overrides_count < VFS_OVERRIDES_MAX, "[base] too many overrides %u\n", fl_vfs.overrides_count);
+	if (fl_vfs.overrides_count < VFS_OVERRIDES_MAX)
+		fl_vfs.overrides[fl_vfs.overrides_count++] = hash;
+}
+
+// ---- ---- ---- ----
+// asset cache
+// ---- ---- ---- ----
+
+struct Asset_Cache_Header {
+	u32 magic;
+	u32 padding;
+	u64 key;
+	u64 size;
+	u64 reserved;
+};
+
+AttrFileLocal()
+struct Asset_Cache {
+	char const * path;
+	u32 hits;
+	u32 misses;
+	u32 writes;
+	u64 bytes_read;
+} fl_asset_cache;
+
+#define ASSET_CACHE_PATH_CAPACITY 260
+
+AttrFileLocal()
+bool asset_cache_get_path(u64 key, char * buffer) {
+	u32 const length = fmt_buffer_n(buffer, ASSET_CACHE_PATH_CAPACITY, "%s%08x%08x.bin",
+		fl_asset_cache.path, (u32)(key >> 32), (u32)key
+	);
+	return length < ASSET_CACHE_PATH_CAPACITY;
+}
+
+void asset_cache_init(struct Asset_Cache_IInfo info) {
+	fl_asset_cache = (struct Asset_Cache){0};
+	if (info.path != NULL && os_directory_create(info.path))
+		fl_asset_cache.path = info.path;
+}
+
+void asset_cache_free(void) {
+	if (fl_asset_cache.path != NULL)
+		fmt_print("[base] asset cache: %u hits (%zu bytes), %u misses, %u writes\n",
+			fl_asset_cache.hits, (size_t)fl_asset_cache.bytes_read,
+			fl_asset_cache.misses, fl_asset_cache.writes
+		);
+	mem_zero(&fl_asset_cache, sizeof(fl_asset_cache));
+}
+
+u64 asset_cache_get_key(char const * loader, u32 version, char const * name, struct File_Stream * source) {
+	u64 source_hash = hash64_fnv1(NULL, 0);
+	for (arr8 chunk; (chunk = file_stream_next(source)).count > 0; /**/)
+		source_hash = hash64_fnv1_continue(source_hash, chunk.buffer, chunk.count);
+
+	u64 const parts[] = {
+		hash64_fnv1(loader, strlen(loader)),
+		version,
+		vfs_get_write_nanos(name),
+		source->size,
+		source_hash,
+	};
+	return hash64_fnv1(parts, sizeof(parts));
+}
+
+arr8 asset_cache_read(struct Memory_Arena * arena, u64 key) {
+	if (fl_asset_cache.path == NULL)
+		return (arr8){0};
+
+	char path[ASSET_CACHE_PATH_CAPACITY];
+	if (!asset_cache_get_path(key, path)) {
+		fl_asset_cache.misses++;
+		return (arr8){0};
+	}
+	u64 const arena_position = memory_arena_get_position(arena);
+	arr8 const file = base_file_read(arena, path);
+
+	struct Asset_Cache_Header header = {0};
+	if (file.count >= sizeof(header))
+		mem_copy(file.buffer, &header, sizeof(header));
+	// @note a stale or foreign file is as good as none
+	if (header.magic != ASSET_CACHE_MAGIC || header.key != key || header.size != file.count - sizeof(header)) {
+		fl_asset_cache.misses++;
+		memory_arena_set_position(arena, arena_position);
+		return (arr8){0};
+	}
+
+	fl_asset_cache.hits++;
+	fl_asset_cache.bytes_read += header.size;
+	return (arr8){
+		.capacity = (size_t)header.size,
+		.count    = (size_t)header.size,
+		.buffer   = file.buffer + sizeof(header),
+	};
+}
+
+void asset_cache_write(u64 key, arr8 data) {
+	if (fl_asset_cache.path == NULL)
+		return;
+
+	char path[ASSET_CACHE_PATH_CAPACITY];
+	if (!asset_cache_get_path(key, path))
+		return;
+	struct File_Writer writer = file_writer_init((struct File_Writer_IInfo){
+		.name   = path,
+		.atomic = true,
+	});
+	struct Asset_Cache_Header const header = {
+		.magic = ASSET_CACHE_MAGIC,
+		.key   = key,
+		.size  = data.count,
+	};
+	file_writer_write(&writer, sizeof(header), &header);
+	file_writer_write(&writer, data.count, data.buffer);
+	if (file_writer_free(&writer))
+		fl_asset_cache.writes++;
+}
+
+// ---- ---- ---- ----
+// formatting
+// ---- ---- ---- ----
+
+#define STB_SPRINTF_STATIC
+#define STB_SPRINTF_IMPLEMENTATION
+#include "_internal/warnings_push.h"
+# include <stb/stb_sprintf.h>
+#include "_internal/warnings_pop.h"
+
+struct Fmt_Print_Ctx {
+	char scratch[STB_SPRINTF_MIN];
+};
+
+AttrFileLocal()
+char * fmt_print_write(char const * input, void * user, int length) {
+	struct Fmt_Print_Ctx * ctx = user;
+	if (length > 0)
+		fwrite(input, sizeof(*input), (size_t)length, stdout);
+	return ctx->scratch;
+}
+
+uint32_t fmt_print(char * fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+
+	struct Fmt_Print_Ctx ctx;
+	int const written = stbsp_vsprintfcb(fmt_print_write, &ctx, ctx.scratch, fmt, args);
+
+	va_end(args);
+	return (uint32_t)written;
+}
+
+struct Fmt_Buffer_Ctx {
+	char scratch[STB_SPRINTF_MIN];
+	char * output;
+};
+
+AttrFileLocal()
+char * fmt_buffer_write(char const * input, void * user, int length) {
+	struct Fmt_Buffer_Ctx * ctx = user;
+	if (length > 0) {
+		mem_copy(ctx->scratch, ctx->output, (size_t)length);
+		ctx->output += length;
+	}
+	return ctx->scratch;
+}
+
+AttrPrint(2, 3)
+uint32_t fmt_buffer(char * out_buffer, char * fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+
+	struct Fmt_Buffer_Ctx ctx = {.output = out_buffer};
+	int const written = stbsp_vsprintfcb(fmt_buffer_write, &ctx, ctx.scratch, fmt, args);
+
+	va_end(args);
+	return (uint32_t)written;
+}
+
+struct Fmt_Buffer_N_Ctx {
+	char scratch[STB_SPRINTF_MIN];
+	char * output;
+	size_t capacity;
+};
+
+AttrFileLocal()
+char * fmt_buffer_n_write(char const * input, void * user, int length) {
+	struct Fmt_Buffer_N_Ctx * ctx = user;
+	size_t const size = min_size((size_t)length, ctx->capacity);
+	if (size > 0 && input != ctx->output)
+		mem_copy(input, ctx->output, size);
+	ctx->output += size;
+	ctx->capacity -= size;
+	// @note write directly into the output while it has enough room
+	return ctx->capacity >= STB_SPRINTF_MIN ? ctx->output : ctx->scratch;
+}
+
+uint32_t fmt_buffer_n(char * out_buffer, size_t capacity, char * fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+
+	// @note the last byte is reserved for the terminator
+	struct Fmt_Buffer_N_Ctx ctx = {.output = out_buffer, .capacity = (capacity > 0) ? capacity - 1 : 0};
+	int const written = stbsp_vsprintfcb(fmt_buffer_n_write, &ctx, fmt_buffer_n_write(NULL, &ctx, 0), fmt, args);
+	if (capacity > 0)
+		*ctx.output = '\0';
+
+	va_end(args);
+	return (uint32_t)written;
+}
+
+struct Fmt_Arena_Ctx {
+	struct Memory_Arena * arena;
+	str8 output;
+};
+
+AttrFileLocal()
+char * fmt_arena_reserve(struct Fmt_Arena_Ctx * ctx) {
+	str8 * output = &ctx->output;
+	u8 * spare = memory_arena_push(ctx->arena, STB_SPRINTF_MIN, sizeof(u8));
+	if (output->buffer == NULL || spare != output->buffer + output->count) {
+		// @note either the string is not at the top or the arena has chained
+		// a new block; move the string up, so it can grow contiguously
+		memory_arena_pop(ctx->arena, STB_SPRINTF_MIN);
+		u8 * buffer = memory_arena_push(ctx->arena, output->count + STB_SPRINTF_MIN, sizeof(u8));
+		if (output->count > 0)
+			mem_copy(output->buffer, buffer, output->count);
+		output->buffer = buffer;
+		spare = buffer + output->count;
+	}
+	return (char *)spare;
+}
+
+AttrFileLocal()
+char * fmt_arena_write(char const * input, void * user, int length) {
+	struct Fmt_Arena_Ctx * ctx = user;
+	// @note `input` is the spare chunk at the arena top, keep only the written part
+	memory_arena_pop(ctx->arena, STB_SPRINTF_MIN - (size_t)length);
+	ctx->output.count += (size_t)length;
+	return fmt_arena_reserve(ctx);
+}
+
+AttrFileLocal()
+uint32_t fmt_arena_va(struct Memory_Arena * arena, str8 * inst, char * fmt, va_list args) {
+	struct Fmt_Arena_Ctx ctx = {.arena = arena, .output = *inst};
+	int const written = stbsp_vsprintfcb(fmt_arena_write, &ctx, fmt_arena_reserve(&ctx), fmt, args);
+	memory_arena_pop(arena, STB_SPRINTF_MIN);
+	*inst = ctx.output;
+	return (uint32_t)written;
+}
+
+uint32_t fmt_arena(struct Memory_Arena * arena, str8 * inst, char * fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	uint32_t const written = fmt_arena_va(arena, inst, fmt, args);
+	va_end(args);
+	return written;
+}
+
+str8 str8_fmt(struct Memory_Arena * arena, char * fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	str8 ret = {0};
+	fmt_arena_va(arena, &ret, fmt, args);
+	va_end(args);
+	return ret;
+}
+
+// ---- ---- ---- ----
+// images
+// ---- ---- ---- ----
+
+#define STBI_NO_STDIO
+#define STBI_ONLY_PNG
+
+#define STBI_MALLOC(size)           os_memory_heap(NULL,    size)
+#define STBI_REALLOC(pointer, size) os_memory_heap(pointer, size)
+#define STBI_FREE(pointer)          os_memory_heap(pointer, 0)
+
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+
+#include "_internal/warnings_push.h"
+# include <stb/stb_image.h>
+#include "_internal/warnings_pop.h"
+
+struct Resource_Image resource_image_init(arr8 const bytes) {
+	stbi_set_flip_vertically_on_load(1);
+	int const channels_override = STBI_rgb_alpha;
+
+	int size_x, size_y, channels;
+	stbi_uc * image = stbi_load_from_memory(bytes.buffer, (int)bytes.count, &size_x, &size_y, &channels, channels_override);
+
+	return (struct Resource_Image){
+		.scalar_size = sizeof(stbi_uc),
+		.size        = {(u32)size_x, (u32)size_y},
+		.channels    = (u8)(channels_override ? channels_override : channels),
+		.buffer      = image,
+	};
+}
+
+struct Resource_Image_Stream {
+	struct File_Stream * stream;
+	arr8   chunk;
+	size_t position;
+};
 
-svec4 svec4_add(svec4 l, svec4 r) { return (svec4){l.x + r.x, l.y + r.y, l.z + r.z, l.w + r.w}; }
-svec4 svec4_sub(svec4 l, svec4 r) { return (svec4){l.x - r.x, l.y - r.y, l.z - r.z, l.w - r.w}; }
-svec4 svec4_mul(svec4 l, svec4 r) { return (svec4){l.x * r.x, l.y * r.y, l.z * r.z, l.w * r.w}; }
-svec4 svec4_div(svec4 l, svec4 r) { return (svec4){l.x / r.x, l.y / r.y, l.z / r.z, l.w / r.w}; }
-s32   svec4_dot(svec4 l, svec4 r) { return l.x * r.x + l.y * r.y + l.z * r.z + l.w * r.w; }
-svec4 svec4_muls(svec4 l, s32 r) { return (svec4){l.x * r, l.y * r, l.z * r, l.w * r}; }
-svec4 svec4_divs(svec4 l, s32 r) { return (svec4){l.x / r, l.y / r, l.z / r, l.w / r}; }
+AttrFileLocal()
+bool resource_image_stream_refill(struct Resource_Image_Stream * inst) {
+	if (inst->position < inst->chunk.count)
+		return true;
+	inst->chunk = file_stream_next(inst->stream);
+	inst->position = 0;
+	return inst->chunk.count > 0;
+}
 
-s32   svec2_crs(svec2 l, svec2 r) { return l.x * r.y - l.y * r.x; }
-svec3 svec3_crs(svec3 l, svec3 r) { return (svec3){
-	l.y * r.z - l.z * r.y,
-	l.z * r.x - l.x * r.z,
-	l.x * r.y - l.y * r.x,
-}; }
+AttrFileLocal()
+int resource_image_stream_read(void * user, char * data, int size) {
+	struct Resource_Image_Stream * inst = user;
+	int ret = 0;
+	while (ret < size && resource_image_stream_refill(inst)) {
+		size_t const count = min_size(inst->chunk.count - inst->position, (size_t)(size - ret));
+		mem_copy(inst->chunk.buffer + inst->position, data + ret, count);
+		inst->position += count;
+		ret += (int)count;
+	}
+	return ret;
+}
 
-// ---- ---- ---- ----
-// functions: u32 math, vector
-// ---- ---- ---- ----
+AttrFileLocal()
+void resource_image_stream_skip(void * user, int size) {
+	struct Resource_Image_Stream * inst = user;
+	size_t remaining = (size_t)max_s32(size, 0);
+	while (remaining > 0 && resource_image_stream_refill(inst)) {
+		size_t const count = min_size(inst->chunk.count - inst->position, remaining);
+		inst->position += count;
+		remaining -= count;
+	}
+}
 
-uvec2 uvec2_add(uvec2 l, uvec2 r) { return (uvec2){l.x + r.x, l.y + r.y}; }
-uvec2 uvec2_sub(uvec2 l, uvec2 r) { return (uvec2){l.x - r.x, l.y - r.y}; }
-uvec2 uvec2_mul(uvec2 l, uvec2 r) { return (uvec2){l.x * r.x, l.y * r.y}; }
-uvec2 uvec2_div(uvec2 l, uvec2 r) { return (uvec2){l.x / r.x, l.y / r.y}; }
-u32   uvec2_dot(uvec2 l, uvec2 r) { return l.x * r.x + l.y * r.y; }
-uvec2 uvec2_muls(uvec2 l, u32 r) { return (uvec2){l.x * r, l.y * r}; }
-uvec2 uvec2_divs(uvec2 l, u32 r) { return (uvec2){l.x / r, l.y / r}; }
+AttrFileLocal()
+int resource_image_stream_eof(void * user) {
+	struct Resource_Image_Stream * inst = user;
+	return !resource_image_stream_refill(inst);
+}
 
-uvec3 uvec3_add(uvec3 l, uvec3 r) { return (uvec3){l.x + r.x, l.y + r.y, l.z + r.z}; }
-uvec3 uvec3_sub(uvec3 l, uvec3 r) { return (uvec3){l.x - r.x, l.y - r.y, l.z - r.z}; }
-uvec3 uvec3_mul(uvec3 l, uvec3 r) { return (uvec3){l.x * r.x, l.y * r.y, l.z * r.z}; }
-uvec3 uvec3_div(uvec3 l, uvec3 r) { return (uvec3){l.x / r.x, l.y / r.y, l.z / r.z}; }
-u32   uvec3_dot(uvec3 l, uvec3 r) { return l.x * r.x + l.y * r.y + l.z * r.z; }
-uvec3 uvec3_muls(uvec3 l, u32 r) { return (uvec3){l.x * r, l.y * r, l.z * r}; }
-uvec3 uvec3_divs(uvec3 l, u32 r) { return (uvec3){l.x / r, l.y / r, l.z / r}; }
+struct Resource_Image resource_image_init_stream(struct File_Stream * stream) {
+	stbi_set_flip_vertically_on_load(1);
+	int const channels_override = STBI_rgb_alpha;
 
-uvec4 uvec4_add(uvec4 l, uvec4 r) { return (uvec4){l.x + r.x, l.y + r.y, l.z + r.z, l.w + r.w}; }
-uvec4 uvec4_sub(uvec4 l, uvec4 r) { return (uvec4){l.x - r.x, l.y - r.y, l.z - r.z, l.w - r.w}; }
-uvec4 uvec4_mul(uvec4 l, uvec4 r) { return (uvec4){l.x * r.x, l.y * r.y, l.z * r.z, l.w * r.w}; }
-uvec4 uvec4_div(uvec4 l, uvec4 r) { return (uvec4){l.x / r.x, l.y / r.y, l.z / r.z, l.w / r.w}; }
-u32   uvec4_dot(uvec4 l, uvec4 r) { return l.x * r.x + l.y * r.y + l.z * r.z + l.w * r.w; }
-uvec4 uvec4_muls(uvec4 l, u32 r) { return (uvec4){l.x * r, l.y * r, l.z * r, l.w * r}; }
-uvec4 uvec4_divs(uvec4 l, u32 r) { return (uvec4){l.x / r, l.y / r, l.z / r, l.w / r}; }
+	// @note the decoder pulls chunks as it goes, while the stream reads ahead
+	struct Resource_Image_Stream context = {.stream = stream};
+	stbi_io_callbacks const callbacks = {
+		.read = resource_image_stream_read,
+		.skip = resource_image_stream_skip,
+		.eof  = resource_image_stream_eof,
+	};
+
+	int size_x, size_y, channels;
+	stbi_uc * image = stbi_load_from_callbacks(&callbacks, &context, &size_x, &size_y, &channels, channels_override);
+
+	return (struct Resource_Image){
+		.scalar_size = sizeof(stbi_uc),
+		.size        = {(u32)size_x, (u32)size_y},
+		.channels    = (u8)(channels_override ? channels_override : channels),
+		.buffer      = image,
+	};
+}
+
+void resource_image_free(struct Resource_Image * inst) {
+	STBI_FREE(inst->buffer);
+	mem_zero(inst, sizeof(*inst));
+}
 
 // ---- ---- ---- ----
-// constants
+// models
 // ---- ---- ---- ----
 
-AttrGlobal() bits32 const bits_min32  = (bits32){.as_u = 0x00000001u};
-AttrGlobal() bits32 const bits_seq32  = (bits32){.as_u = 0x4b800000u}; // 2^24
-AttrGlobal() bits32 const bits_lim32  = (bits32){.as_u = 0x7f7fffffu}; // 2^127 * [1 .. 2)
-AttrGlobal() bits32 const bits_inf32  = (bits32){.as_u = 0x7f800000u}; // 2^128
-AttrGlobal() bits32 const bits_qnan32 = (bits32){.as_u = 0x7fc00000u}; // 2^128 * (1 .. 2)
-AttrGlobal() bits32 const bits_snan32 = (bits32){.as_u = 0x7fa00000u}; // 2^128 * (1 .. 2)
+#define RESOURCE_MODEL_CHUNK_MIN   (64 * 1024)
+#define RESOURCE_MODEL_BLOCK_SIZE  (16 * 1024)
 
-AttrGlobal() bits64 const bits_min64  = (bits64){.as_u = 0x0000000000000001ull};
-AttrGlobal() bits64 const bits_seq64  = (bits64){.as_u = 0x4340000000000000ull}; // 2^53
-AttrGlobal() bits64 const bits_lim64  = (bits64){.as_u = 0x7fefffffffffffffull}; // 2^1023 * [1 .. 2)
-AttrGlobal() bits64 const bits_inf64  = (bits64){.as_u = 0x7ff0000000000000ull}; // 2^1024
-AttrGlobal() bits64 const bits_qnan64 = (bits64){.as_u = 0x7ff8000000000000ull}; // 2^1024 * (1 .. 2)
-AttrGlobal() bits64 const bits_snan64 = (bits64){.as_u = 0x7ff4000000000000ull}; // 2^1024 * (1 .. 2)
+enum Resource_Model_Stream_Kind {
+	RESOURCE_MODEL_STREAM_POSITIONS,
+	RESOURCE_MODEL_STREAM_TEXTURES,
+	RESOURCE_MODEL_STREAM_NORMALS,
+	RESOURCE_MODEL_STREAM_CORNERS,
+	RESOURCE_MODEL_STREAM_FIXUPS, // @note corner fields holding relative indices
+	RESOURCE_MODEL_STREAM_COUNT,
+};
 
-// ground truth, 20 digits after the decimal searator                              6.28318530717958647693
-AttrGlobal() bits32 const bits_tau32 = (bits32){.as_u = 0x40c90fdbu};           // 6.2831854f
-AttrGlobal() bits64 const bits_tau64 = (bits64){.as_u = 0x401921fb54442d18ull}; // 6.283185307179586
+// @note blocks keep a stream going when the arena continues elsewhere
+struct Resource_Model_Block {
+	struct Resource_Model_Block * next;
+	u32 count;
+};
 
-// ground truth, 20 digits after the decimal searator                             3.14159265358979323846
-AttrGlobal() bits32 const bits_pi32 = (bits32){.as_u = 0x40490fdbu};           // 3.1415927f
-AttrGlobal() bits64 const bits_pi64 = (bits64){.as_u = 0x400921fb54442d18ull}; // 3.141592653589793
+struct Resource_Model_Stream {
+	struct Resource_Model_Block * head, * tail;
+	u32 count;
+	u32 block_capacity;
+	u32 element_size;
+};
 
-// ground truth, 20 digits after the decimal searator                             2.71828182845904523536
-AttrGlobal() bits32 const bits_e32  = (bits32){.as_u = 0x402df855u};           // 2.7182819f
-AttrGlobal() bits64 const bits_e64  = (bits64){.as_u = 0x4005bf0a8b145769ull}; // 2.718281828459045
+struct Resource_Model_Job {
+	str8 text;
+	struct Memory_Arena * arena;
+	struct Resource_Model_Stream streams[RESOURCE_MODEL_STREAM_COUNT];
+};
 
-AttrGlobal() vec2 const vec2_0  = (vec2){0, 0};
-AttrGlobal() vec2 const vec2_1  = (vec2){1, 1};
-AttrGlobal() vec2 const vec2_x1 = (vec2){1, 0};
-AttrGlobal() vec2 const vec2_y1 = (vec2){0, 1};
+AttrFileLocal()
+void * resource_model_job_push(struct Resource_Model_Job * job, enum Resource_Model_Stream_Kind kind) {
+	struct Resource_Model_Stream * stream = job->streams + kind;
+	struct Resource_Model_Block * block = stream->tail;
+	if (block == NULL || block->count == stream->block_capacity) {
+		block = memory_arena_push(job->arena, sizeof(*block) + RESOURCE_MODEL_BLOCK_SIZE, AlignOf(struct Resource_Model_Block));
+		*block = (struct Resource_Model_Block){0};
+		if (stream->tail != NULL) stream->tail->next = block;
+		else                      stream->head       = block;
+		stream->tail = block;
+	}
+	stream->count++;
+	return (u8 *)(block + 1) + stream->element_size * block->count++;
+}
 
-AttrGlobal() vec3 const vec3_0  = (vec3){0, 0, 0};
-AttrGlobal() vec3 const vec3_1  = (vec3){1, 1, 1};
-AttrGlobal() vec3 const vec3_x1 = (vec3){1, 0, 0};
-AttrGlobal() vec3 const vec3_y1 = (vec3){0, 1, 0};
-AttrGlobal() vec3 const vec3_z1 = (vec3){0, 0, 1};
+// @note absent values are zeros
+AttrFileLocal()
+void resource_model_parse_floats(str8 line, u32 count, f32 * out) {
+	for (u32 i = 0; i < count; i++) {
+		line = str8_skip_space(line);
+		if (!str8_parse_f32(&line, out + i)) out[i] = 0;
+	}
+}
 
-AttrGlobal() vec4 const vec4_0  = (vec4){0, 0, 0, 0};
-AttrGlobal() vec4 const vec4_1  = (vec4){1, 1, 1, 1};
-AttrGlobal() vec4 const vec4_x1 = (vec4){1, 0, 0, 0};
-AttrGlobal() vec4 const vec4_y1 = (vec4){0, 1, 0, 0};
-AttrGlobal() vec4 const vec4_z1 = (vec4){0, 0, 1, 0};
-AttrGlobal() vec4 const vec4_w1 = (vec4){0, 0, 0, 1};
+// @note `v`, `v/t`, `v//n` or `v/t/n`
+AttrFileLocal()
+bool resource_model_parse_triple(str8 * line, s64 * out) {
+	out[0] = out[1] = out[2] = 0;
+	if (!str8_parse_s64(line, out + 0))
+		return false;
+	if (line->count > 0 && line->buffer[0] == '/') {
+		str8_parse_advance(line, 1);
+		str8_parse_s64(line, out + 1);
+		if (line->count > 0 && line->buffer[0] == '/') {
+			str8_parse_advance(line, 1);
+			str8_parse_s64(line, out + 2);
+		}
+	}
+	return true;
+}
 
-AttrGlobal() quat const quat_i = (quat){0, 0, 0, 1};
+// @note negative values index back from the chunk's count, which the merge rebases
+AttrFileLocal()
+s32 resource_model_resolve(struct Resource_Model_Job const * job, enum Resource_Model_Stream_Kind kind, s64 value, bool * relative) {
+	*relative = value < 0;
+	if (value > 0)
+		return value <= INT32_MAX ? (s32)(value - 1) : -1;
+	if (value < 0)
+		return value >= INT32_MIN ? (s32)((s64)job->streams[kind].count + value) : -1;
+	return -1;
+}
 
-AttrGlobal() mat2 const mat2_i = (mat2){
-	{1, 0},
-	{0, 1},
-};
+AttrFileLocal()
+void resource_model_push_corner(struct Resource_Model_Job * job, struct RMCorner corner, u32 relative) {
+	u32 const offset = job->streams[RESOURCE_MODEL_STREAM_CORNERS].count * 3;
+	*(struct RMCorner *)resource_model_job_push(job, RESOURCE_MODEL_STREAM_CORNERS) = corner;
+	for (u32 i = 0; i < 3; i++)
+		if (relative & (1u << i))
+			*(u32 *)resource_model_job_push(job, RESOURCE_MODEL_STREAM_FIXUPS) = offset + i;
+}
 
-AttrGlobal() mat3 const mat3_i = (mat3){
-	{1, 0, 0},
-	{0, 1, 0},
-	{0, 0, 1},
-};
+AttrFileLocal()
+void resource_model_parse_face(struct Resource_Model_Job * job, str8 line) {
+	// @note fans polygons out of the first corner, as tinyobj does
+	struct RMCorner first = {0}, previous = {0};
+	u32 first_relative = 0, previous_relative = 0;
+	for (u32 count = 0; /**/; count++) {
+		s64 triple[3];
+		line = str8_skip_space(line);
+		if (!resource_model_parse_triple(&line, triple))
+			break;
+
+		bool relative[3];
+		struct RMCorner const corner = {
+			.position = resource_model_resolve(job, RESOURCE_MODEL_STREAM_POSITIONS, triple[0], relative + 0),
+			.texture  = resource_model_resolve(job, RESOURCE_MODEL_STREAM_TEXTURES,  triple[1], relative + 1),
+			.normal   = resource_model_resolve(job, RESOURCE_MODEL_STREAM_NORMALS,   triple[2], relative + 2),
+		};
+		u32 const corner_relative = (u32)relative[0] | ((u32)relative[1] << 1) | ((u32)relative[2] << 2);
 
-AttrGlobal() mat4 const mat4_i = (mat4){
-	{1, 0, 0, 0},
-	{0, 1, 0, 0},
-	{0, 0, 1, 0},
-	{0, 0, 0, 1},
-};
+		if (count >= 2) {
+			resource_model_push_corner(job, first,    first_relative);
+			resource_model_push_corner(job, previous, previous_relative);
+			resource_model_push_corner(job, corner,   corner_relative);
+		}
+		if (count == 0) {
+			first = corner;
+			first_relative = corner_relative;
+		}
+		previous = corner;
+		previous_relative = corner_relative;
+	}
+}
 
-// ---- ---- ---- ----
-// memory
-// ---- ---- ---- ----
+AttrFileLocal()
+void resource_model_parse_job(void * context) {
+	struct Resource_Model_Job * job = context;
+	for (str8 cursor = job->text; cursor.count > 0; /**/) {
+		str8 line = str8_skip_space(str8_next_line(&cursor));
+		if (line.count < 2)
+			continue;
 
-struct Memory_Arena {
-	struct Memory_Arena_IInfo info;
-	size_t reserved, commited, base, offset;
-	struct Memory_Arena * prev, * curr;
-	// @todo pad and protect the boundary
-};
+		u8 const * it = line.buffer;
+		if (it[0] == 'v' && str8_is_space(it[1])) {
+			str8_parse_advance(&line, 2);
+			resource_model_parse_floats(line, 3, resource_model_job_push(job, RESOURCE_MODEL_STREAM_POSITIONS));
+		}
+		else if (it[0] == 'v' && it[1] == 't' && line.count > 2 && str8_is_space(it[2])) {
+			str8_parse_advance(&line, 3);
+			resource_model_parse_floats(line, 2, resource_model_job_push(job, RESOURCE_MODEL_STREAM_TEXTURES));
+		}
+		else if (it[0] == 'v' && it[1] == 'n' && line.count > 2 && str8_is_space(it[2])) {
+			str8_parse_advance(&line, 3);
+			resource_model_parse_floats(line, 3, resource_model_job_push(job, RESOURCE_MODEL_STREAM_NORMALS));
+		}
+		else if (it[0] == 'f' && str8_is_space(it[1])) {
+			str8_parse_advance(&line, 2);
+			resource_model_parse_face(job, line);
+		}
+	}
+}
 
-struct Memory_Arena * arena_init(struct Memory_Arena_IInfo info) {
-	Assert(g_os_info.page_size > 0, "[base] call `os_init` first\n");
-	size_t const maximum = SIZE_MAX - (sizeof(struct Memory_Arena) + g_os_info.page_size - 1);
+AttrFileLocal()
+void resource_model_stream_copy(struct Resource_Model_Stream const * stream, void * target) {
+	u8 * it = target;
+	for (struct Resource_Model_Block const * block = stream->head; block != NULL; block = block->next) {
+		size_t const size = (size_t)stream->element_size * block->count;
+		mem_copy(block + 1, it, size);
+		it += size;
+	}
+}
 
-	Assert(info.reserve <= maximum, "[base] trying to reserve too much\n");
-	Assert(info.commit <= info.reserve, "[base] trying to commit too much\n");
+struct Resource_Model * resource_model_init(char const * name) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	u64 const scratch_position = memory_arena_get_position(scratch);
 
-	size_t const reserve = align_size(sizeof(struct Memory_Arena) + info.reserve, g_os_info.page_size);
-	size_t const commit = align_size(sizeof(struct Memory_Arena) + info.commit, g_os_info.page_size);
-	struct Memory_Arena * ret = os_memory_reserve(reserve);
-	if (ret == NULL)
-		os_exit(1);
-	os_memory_commit(ret, commit);
-	*ret = (struct Memory_Arena){
-		.info = info,
-		.reserved = reserve,
-		.commited = commit,
-		.offset = sizeof(struct Memory_Arena),
-		//
-		.curr = ret,
+	arr8 const file_bytes = vfs_read(scratch, name);
+	struct Resource_Model * ret = resource_model_init_obj(file_bytes);
+
+	memory_arena_set_position(scratch, scratch_position);
+	return ret;
+}
+
+struct Resource_Model * resource_model_init_obj(arr8 const file) {
+	AttrFuncLocal() u32 const element_sizes[RESOURCE_MODEL_STREAM_COUNT] = {
+		[RESOURCE_MODEL_STREAM_POSITIONS] = sizeof(vec3),
+		[RESOURCE_MODEL_STREAM_TEXTURES]  = sizeof(vec2),
+		[RESOURCE_MODEL_STREAM_NORMALS]   = sizeof(vec3),
+		[RESOURCE_MODEL_STREAM_CORNERS]   = sizeof(struct RMCorner),
+		[RESOURCE_MODEL_STREAM_FIXUPS]    = sizeof(u32),
+	};
+
+	// -- split the text at line boundaries
+	u32 const workers_limit = workers_get_count();
+	u32 const workers = (u32)clamp_size(file.count / RESOURCE_MODEL_CHUNK_MIN, 1, workers_limit);
+
+	struct Resource_Model_Job jobs[WORKERS_MAX];
+	size_t begin = 0;
+	for (u32 w = 0; w < workers; w++) {
+		size_t end = file.count;
+		if (w + 1 < workers) {
+			str8 const rest = {
+				.count  = file.count  - begin,
+				.buffer = file.buffer + begin,
+			};
+			size_t const split = max_size(file.count / workers * (w + 1), begin) - begin;
+			str8 const tail = {.count = rest.count - split, .buffer = rest.buffer + split};
+			end = begin + split + min_size(str8_find_byte(tail, '\n') + 1, tail.count);
+		}
+
+		jobs[w] = (struct Resource_Model_Job){
+			.text = {.count = end - begin, .buffer = file.buffer + begin},
+			// @note per worker, so that threads never share an allocator
+			.arena = arena_init((struct Memory_Arena_IInfo){
+				.reserve = MB(64),
+				.commit = KB(64),
+			}),
+		};
+		for (u32 s = 0; s < RESOURCE_MODEL_STREAM_COUNT; s++)
+			jobs[w].streams[s] = (struct Resource_Model_Stream){
+				.block_capacity = RESOURCE_MODEL_BLOCK_SIZE / element_sizes[s],
+				.element_size = element_sizes[s],
+			};
+		begin = end;
+	}
+
+	// -- parse chunks in parallel
+	workers_run(resource_model_parse_job, jobs, sizeof(*jobs), workers);
+
+	// -- merge streams, rebasing relative indices by the attributes of preceding chunks
+	u32 totals[RESOURCE_MODEL_STREAM_COUNT] = {0};
+	for (u32 w = 0; w < workers; w++)
+		for (u32 s = 0; s < RESOURCE_MODEL_STREAM_COUNT; s++)
+			totals[s] += jobs[w].streams[s].count;
+
+	struct Resource_Model * ret = os_memory_heap(NULL, sizeof(*ret));
+	*ret = (struct Resource_Model){
+		.positions_count = totals[RESOURCE_MODEL_STREAM_POSITIONS],
+		.textures_count  = totals[RESOURCE_MODEL_STREAM_TEXTURES],
+		.normals_count   = totals[RESOURCE_MODEL_STREAM_NORMALS],
+		.corners_count   = totals[RESOURCE_MODEL_STREAM_CORNERS],
 	};
+	ret->positions = os_memory_heap(NULL, sizeof(*ret->positions) * max_u32(ret->positions_count, 1));
+	ret->textures  = os_memory_heap(NULL, sizeof(*ret->textures)  * max_u32(ret->textures_count,  1));
+	ret->normals   = os_memory_heap(NULL, sizeof(*ret->normals)   * max_u32(ret->normals_count,   1));
+	ret->corners   = os_memory_heap(NULL, sizeof(*ret->corners)   * max_u32(ret->corners_count,   1));
+
+	u32 offsets[RESOURCE_MODEL_STREAM_COUNT] = {0};
+	for (u32 w = 0; w < workers; w++) {
+		struct Resource_Model_Stream const * streams = jobs[w].streams;
+		resource_model_stream_copy(streams + RESOURCE_MODEL_STREAM_POSITIONS, ret->positions + offsets[RESOURCE_MODEL_STREAM_POSITIONS]);
+		resource_model_stream_copy(streams + RESOURCE_MODEL_STREAM_TEXTURES,  ret->textures  + offsets[RESOURCE_MODEL_STREAM_TEXTURES]);
+		resource_model_stream_copy(streams + RESOURCE_MODEL_STREAM_NORMALS,   ret->normals   + offsets[RESOURCE_MODEL_STREAM_NORMALS]);
+		resource_model_stream_copy(streams + RESOURCE_MODEL_STREAM_CORNERS,   ret->corners   + offsets[RESOURCE_MODEL_STREAM_CORNERS]);
+
+		struct RMCorner * corners = ret->corners + offsets[RESOURCE_MODEL_STREAM_CORNERS];
+		for (struct Resource_Model_Block const * block = streams[RESOURCE_MODEL_STREAM_FIXUPS].head; block != NULL; block = block->next) {
+			u32 const * fixups = (u32 const *)(block + 1);
+			for (u32 i = 0; i < block->count; i++) {
+				struct RMCorner * corner = corners + fixups[i] / 3;
+				switch (fixups[i] % 3) {
+					case 0: corner->position += (s32)offsets[RESOURCE_MODEL_STREAM_POSITIONS]; break;
+					case 1: corner->texture  += (s32)offsets[RESOURCE_MODEL_STREAM_TEXTURES];  break;
+					case 2: corner->normal   += (s32)offsets[RESOURCE_MODEL_STREAM_NORMALS];   break;
+				}
+			}
+		}
+
+		for (u32 s = 0; s < RESOURCE_MODEL_STREAM_COUNT; s++)
+			offsets[s] += streams[s].count;
+		memory_arena_free(jobs[w].arena);
+	}
+
 	return ret;
 }
 
-void memory_arena_free(struct Memory_Arena * arena) {
-	struct Memory_Arena * curr = arena->curr;
-	for (struct Memory_Arena * prev = NULL; curr != NULL; curr = prev) {
-		prev = curr->prev;
-		os_memory_release(curr, curr->reserved);
+void resource_model_free(struct Resource_Model * inst) {
+	os_memory_heap(inst->positions, 0);
+	os_memory_heap(inst->textures,  0);
+	os_memory_heap(inst->normals,   0);
+	os_memory_heap(inst->corners,   0);
+	mem_zero(inst, sizeof(*inst));
+	os_memory_heap(inst, 0);
+}
+
+AttrFileLocal()
+u32 resource_model_hash_corner(void const * opaque) {
+	return hash32_fnv1(opaque, sizeof(struct RMCorner));
+}
+
+// @note indices out of range, relative ones included, read as absent
+AttrFileLocal()
+struct RMVertex resource_model_corner_to_vertex(struct Resource_Model const * inst, struct RMCorner corner) {
+	struct RMVertex vertex = {0};
+	if (corner.position >= 0 && (u32)corner.position < inst->positions_count)
+		vertex.position = inst->positions[corner.position];
+	if (corner.texture >= 0 && (u32)corner.texture < inst->textures_count)
+		vertex.texture = inst->textures[corner.texture];
+	if (corner.normal >= 0 && (u32)corner.normal < inst->normals_count)
+		vertex.normal = inst->normals[corner.normal];
+	return vertex;
+}
+
+/*
+@note parallel deduplication keeps the serial order, vertices go by their first corner:
+- hash: corners are assigned to partitions by the hash prefix, counted per range
+- scatter: corners are grouped by partition, ascending within each
+- unique: each partition deduplicates on its own, marking first occurrences
+- count: first occurrences are counted per range
+- emit: first occurrences get vertices and global indices in corner order
+- remap: the rest of corners take the indices of their first occurrences
+ranges are equal slices of corners, partitions are worker-owned sets of keys
+*/
+
+#define RESOURCE_MODEL_DEDUP_THREADING_MIN 65536
+
+enum Resource_Model_Dedup_Phase {
+	RESOURCE_MODEL_DEDUP_PHASE_HASH,
+	RESOURCE_MODEL_DEDUP_PHASE_SCATTER,
+	RESOURCE_MODEL_DEDUP_PHASE_UNIQUE,
+	RESOURCE_MODEL_DEDUP_PHASE_COUNT,
+	RESOURCE_MODEL_DEDUP_PHASE_EMIT,
+	RESOURCE_MODEL_DEDUP_PHASE_REMAP,
+};
+
+struct Resource_Model_Dedup {
+	struct Resource_Model const * model;
+	enum Resource_Model_Dedup_Phase phase;
+	u32 workers;
+	// per corner
+	u8  * partitions;
+	u8  * marks;  // @note first occurrences
+	u32 * locals; // @note indices within partitions
+	u32 * order;  // @note corners grouped by partition
+	u32 * firsts; // @note first occurrences per partition, laid out as `order`
+	// per range and partition
+	u32 * cursors;
+	u32 partition_offsets[WORKERS_MAX + 1];
+	u32 uniques_counts[WORKERS_MAX];
+	u32 range_offsets[WORKERS_MAX + 1];
+	// output
+	struct RMVertex * vertices;
+	u32 * indices;
+};
+
+struct Resource_Model_Dedup_Job {
+	struct Resource_Model_Dedup * dedup;
+	u32 index;
+};
+
+AttrFileLocal()
+void resource_model_dedup_job(void * context) {
+	struct Resource_Model_Dedup_Job const * job = context;
+	struct Resource_Model_Dedup * dedup = job->dedup;
+	u32 const w = job->index;
+	u32 const range_begin = (u32)((u64)dedup->model->corners_count *  w      / dedup->workers);
+	u32 const range_end   = (u32)((u64)dedup->model->corners_count * (w + 1) / dedup->workers);
+	u32 const partition_begin = dedup->partition_offsets[w];
+	u32 const partition_end   = dedup->partition_offsets[w + 1];
+	u32 * cursors = dedup->cursors + w * dedup->workers;
+
+	switch (dedup->phase) {
+		case RESOURCE_MODEL_DEDUP_PHASE_HASH: {
+			for (u32 c = range_begin; c < range_end; c++) {
+				u32 const hash = resource_model_hash_corner(dedup->model->corners + c);
+				u8 const partition = (u8)(((u64)hash * dedup->workers) >> 32);
+				dedup->partitions[c] = partition;
+				cursors[partition]++;
+			}
+		} break;
+
+		case RESOURCE_MODEL_DEDUP_PHASE_SCATTER: {
+			for (u32 c = range_begin; c < range_end; c++)
+				dedup->order[cursors[dedup->partitions[c]]++] = c;
+		} break;
+
+		case RESOURCE_MODEL_DEDUP_PHASE_UNIQUE: {
+			struct Memory_Arena * scratch = thread_ctx_get_scratch();
+			u64 const scratch_position = memory_arena_get_position(scratch);
+
+			// @note twice the capacity keeps probing short even if every corner is unique
+			struct Hash_Map corner_to_local = hash_map_init(&resource_model_hash_corner, sizeof(struct RMCorner), sizeof(u32));
+			hash_map_arena(&corner_to_local, scratch, max_u32(partition_end - partition_begin, 1) * 2);
+
+			u32 uniques_count = 0;
+			for (u32 i = partition_begin; i < partition_end; i++) {
+				u32 const c = dedup->order[i];
+				struct RMCorner const * corner = dedup->model->corners + c;
+				u32 const * existing = hash_map_get(&corner_to_local, corner);
+				if (existing == NULL) {
+					hash_map_set(&corner_to_local, corner, &uniques_count);
+					dedup->firsts[partition_begin + uniques_count] = c;
+					dedup->marks[c] = 1;
+					dedup->locals[c] = uniques_count++;
+				}
+				else dedup->locals[c] = *existing;
+			}
+			dedup->uniques_counts[w] = uniques_count;
+
+			memory_arena_set_position(scratch, scratch_position);
+		} break;
+
+		case RESOURCE_MODEL_DEDUP_PHASE_COUNT: {
+			u32 count = 0;
+			for (u32 c = range_begin; c < range_end; c++)
+				count += dedup->marks[c];
+			dedup->range_offsets[w + 1] = count;
+		} break;
+
+		case RESOURCE_MODEL_DEDUP_PHASE_EMIT: {
+			u32 index = dedup->range_offsets[w];
+			for (u32 c = range_begin; c < range_end; c++) {
+				if (dedup->marks[c] == 0) continue;
+				dedup->vertices[index] = resource_model_corner_to_vertex(dedup->model, dedup->model->corners[c]);
+				dedup->indices[c] = index++;
+			}
+		} break;
+
+		case RESOURCE_MODEL_DEDUP_PHASE_REMAP: {
+			// @note first occurrences hold their global indices already
+			u32 const * firsts = dedup->firsts + partition_begin;
+			for (u32 i = partition_begin; i < partition_end; i++) {
+				u32 const c = dedup->order[i];
+				dedup->indices[c] = dedup->indices[firsts[dedup->locals[c]]];
+			}
+		} break;
 	}
 }
 
-size_t memory_arena_get_position(struct Memory_Arena const * arena) {
-	struct Memory_Arena const * curr = arena->curr;
-	return curr->base + curr->offset;
+AttrFileLocal()
+void resource_model_dedup_run(struct Resource_Model_Dedup * dedup, enum Resource_Model_Dedup_Phase phase) {
+	dedup->phase = phase;
+	struct Resource_Model_Dedup_Job jobs[WORKERS_MAX];
+	for (u32 w = 0; w < dedup->workers; w++)
+		jobs[w] = (struct Resource_Model_Dedup_Job){.dedup = dedup, .index = w};
+	workers_run(resource_model_dedup_job, jobs, sizeof(*jobs), dedup->workers);
 }
 
-void memory_arena_set_position(struct Memory_Arena * arena, size_t position) {
-	struct Memory_Arena * curr = arena->curr;
+AttrFileLocal()
+u32 resource_model_dedup_parallel(struct Resource_Model const * inst, u32 workers, struct RMVertex * vertices, u32 * indices) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	u64 const scratch_position = memory_arena_get_position(scratch);
 
-	Assert(position <= memory_arena_get_position(arena), "[base] overflow\n");
-	Assert(position >= sizeof(struct Memory_Arena), "[base] underflow\n");
-	for (struct Memory_Arena * it = NULL; curr->base >= position; curr = it) {
-		it = curr->prev;
-		os_memory_release(curr, curr->reserved);
+	u32 const count = inst->corners_count;
+	struct Resource_Model_Dedup dedup = {
+		.model      = inst,
+		.workers    = workers,
+		.partitions = MemoryArenaPushArray(scratch, u8,  count),
+		.marks      = MemoryArenaPushArray(scratch, u8,  count),
+		.locals     = MemoryArenaPushArray(scratch, u32, count),
+		.order      = MemoryArenaPushArray(scratch, u32, count),
+		.firsts     = MemoryArenaPushArray(scratch, u32, count),
+		.cursors    = MemoryArenaPushArray(scratch, u32, workers * workers),
+		.vertices   = vertices,
+		.indices    = indices,
+	};
+	mem_zero(dedup.marks,   sizeof(*dedup.marks)   * count);
+	mem_zero(dedup.cursors, sizeof(*dedup.cursors) * workers * workers);
+
+	resource_model_dedup_run(&dedup, RESOURCE_MODEL_DEDUP_PHASE_HASH);
+
+	// -- partitions go one after another, ranges within each keep their order
+	u32 offset = 0;
+	for (u32 p = 0; p < workers; p++) {
+		dedup.partition_offsets[p] = offset;
+		for (u32 w = 0; w < workers; w++) {
+			u32 const partition_count = dedup.cursors[w * workers + p];
+			dedup.cursors[w * workers + p] = offset;
+			offset += partition_count;
+		}
 	}
+	dedup.partition_offsets[workers] = offset;
+
+	resource_model_dedup_run(&dedup, RESOURCE_MODEL_DEDUP_PHASE_SCATTER);
+	resource_model_dedup_run(&dedup, RESOURCE_MODEL_DEDUP_PHASE_UNIQUE);
+	resource_model_dedup_run(&dedup, RESOURCE_MODEL_DEDUP_PHASE_COUNT);
+
+	dedup.range_offsets[0] = 0;
+	for (u32 w = 0; w < workers; w++)
+		dedup.range_offsets[w + 1] += dedup.range_offsets[w];
 
-	curr->offset = position - curr->base;
-	arena->curr = curr;
-}
+	resource_model_dedup_run(&dedup, RESOURCE_MODEL_DEDUP_PHASE_EMIT);
+	resource_model_dedup_run(&dedup, RESOURCE_MODEL_DEDUP_PHASE_REMAP);
 
-void * memory_arena_push(struct Memory_Arena * arena, size_t size, size_t align) {
-	Assert(size > 0, "[base] size should be positive\n");
-	Assert(align > 0, "[base] alignment should be positive\n");
-	struct Memory_Arena * curr = arena->curr;
+	memory_arena_set_position(scratch, scratch_position);
+	return dedup.range_offsets[workers];
+}
 
-	if (curr->offset + size > curr->reserved) {
-		curr = arena_init((struct Memory_Arena_IInfo){
-			.reserve = max_size(curr->info.reserve, sizeof(struct Memory_Arena) + size),
-			.commit = max_size(curr->info.commit, sizeof(struct Memory_Arena) + size),
-		});
-		curr->base = memory_arena_get_position(arena);
-		curr->prev = arena;
-		arena->curr = curr;
+void resource_model_dump_vertices(struct Resource_Model * inst, struct Memory_Arena * scratch,
+	struct RMVertex ** out_vertices, u32 * out_vertices_count,
+	void           ** out_indices,  u32 * out_indices_count, u32 * out_index_size
+) {
+	u32 const indices_count        = inst->corners_count;
+	if (indices_count == 0) {
+		*out_vertices = NULL; *out_vertices_count = 0;
+		*out_indices  = NULL; *out_indices_count  = 0;
+		*out_index_size = sizeof(u16);
+		return;
 	}
 
-	curr->offset = align_size(curr->offset, align);
-	void * memory = (u8 *)curr + curr->offset;
+	struct RMVertex * vertices = MemoryArenaPushArray(scratch, struct RMVertex, indices_count);
+	u32                 * indices  = MemoryArenaPushArray(scratch, u32,                 indices_count);
+	*out_vertices = vertices; *out_indices  = indices;
 
-	curr->offset += size;
-	if (curr->commited < curr->offset) {
-		curr->commited = align_size(curr->offset, g_os_info.page_size);
-		os_memory_commit(curr, curr->commited);
+	u32 const workers = workers_get_count();
+	u32 unique_vertices_count = 0;
+	if (workers > 1 && indices_count >= RESOURCE_MODEL_DEDUP_THREADING_MIN)
+		unique_vertices_count = resource_model_dedup_parallel(inst, workers, vertices, indices);
+	else {
+		struct Hash_Map corner_to_index = hash_map_init(&resource_model_hash_corner, sizeof(struct RMCorner), sizeof(u32));
+		hash_map_arena(&corner_to_index, scratch, indices_count);
+
+		for (u32 i = 0; i < indices_count; i++) {
+			struct RMCorner const corner = inst->corners[i];
+			u32 index = unique_vertices_count;
+			u32 const * existing = hash_map_get(&corner_to_index, &corner);
+			if (existing == NULL) {
+				hash_map_set(&corner_to_index, &corner, &index);
+				*vertices++ = resource_model_corner_to_vertex(inst, corner);
+				unique_vertices_count++;
+			}
+			else index = *existing;
+			indices[i] = index;
+		}
 	}
 
-	return memory;
+	// @note narrowing in place is safe, as each write lands behind its read
+	u32 const index_size = (unique_vertices_count <= RMINDEX16_VERTICES_MAX) ? sizeof(u16) : sizeof(u32);
+	if (index_size == sizeof(u16)) {
+		u16 * narrow = (u16 *)(void *)indices;
+		for (u32 i = 0; i < indices_count; i++)
+			narrow[i] = (u16)indices[i];
+	}
+
+	*out_vertices_count = unique_vertices_count;
+	*out_indices_count = indices_count;
+	*out_index_size = index_size;
 }
 
-void memory_arena_pop(struct Memory_Arena * arena, size_t size) {
-	size_t const position = memory_arena_get_position(arena);
-	memory_arena_set_position(arena, position - size);
+void resource_model_pack_vertices(u32 count, struct RMVertex const * source, struct RMVertex_Packed * target,
+	vec3 * out_offset, vec3 * out_scale
+) {
+	aabb3 const bounds = aabb3_from_points(count, &source->position, sizeof(*source));
+	vec3 const min = bounds.min;
+	vec3 const scale = vec3_sub(bounds.max, bounds.min);
+	vec3 const reverse = {
+		scale.x > 0 ? 1 / scale.x : 0,
+		scale.y > 0 ? 1 / scale.y : 0,
+		scale.z > 0 ? 1 / scale.z : 0,
+	};
+
+	for (u32 i = 0; i < count; i++) {
+		struct RMVertex const * it = source + i;
+		vec3 const position = vec3_mul(vec3_sub(it->position, min), reverse);
+		vec2 const normal = octahedral_encode(it->normal);
+		target[i] = (struct RMVertex_Packed){
+			.position = {
+				unorm16_from_f32(position.x),
+				unorm16_from_f32(position.y),
+				unorm16_from_f32(position.z),
+				0,
+			},
+			.texture = {f16_from_f32(it->texture.x), f16_from_f32(it->texture.y)},
+			.normal  = {snorm16_from_f32(normal.x),  snorm16_from_f32(normal.y)},
+		};
+	}
+
+	*out_offset = min;
+	*out_scale  = scale;
 }
 
 // ---- ---- ---- ----
-// thread context
+// transform hierarchy
 // ---- ---- ---- ----
 
-AttrFileLocal() AttrThreadLocal()
-struct Thread_Ctx {
-	struct Memory_Arena * scratch;
-} ftl_thread_ctx;
-
-void thread_ctx_init(void) {
-	ftl_thread_ctx.scratch = arena_init((struct Memory_Arena_IInfo){
-		.reserve = MB(64),
-		.commit = KB(64),
-	});
-}
+#define TRANSFORM_HIERARCHY_THREADING_MIN 8192
 
-void thread_ctx_free(void) {
-	memory_arena_free(ftl_thread_ctx.scratch);
-	mem_zero(&ftl_thread_ctx, sizeof(ftl_thread_ctx));
+struct Transform_Hierarchy transform_hierarchy_init(void) {
+	return (struct Transform_Hierarchy){.partition_dirty = true};
 }
 
-struct Memory_Arena * thread_ctx_get_scratch(void) {
-	return ftl_thread_ctx.scratch;
+void transform_hierarchy_free(struct Transform_Hierarchy * inst) {
+	os_memory_heap(inst->parents,   0);
+	os_memory_heap(inst->offsets,   0);
+	os_memory_heap(inst->rotations, 0);
+	os_memory_heap(inst->scales,    0);
+	os_memory_heap(inst->worlds,    0);
+	os_memory_heap(inst->dirty,     0);
+	os_memory_heap(inst->partition, 0);
+	mem_zero(inst, sizeof(*inst));
 }
 
-// ---- ---- ---- ----
-// file utilities
-// ---- ---- ---- ----
-
-arr8 base_file_read(struct Memory_Arena * arena, char const * name) {
-	arr8 ret = {0};
-	struct OS_File * file = os_file_init((struct OS_File_IInfo){
-		.name = name,
-	});
-	if (file != NULL) {
-		u64 const required = os_file_get_size(file);
-		ret.capacity = min_u64(required + 1, ~ret.capacity);
-		AssertF(required <= ret.capacity, "[base] file \"%s\" is too large %llu / %zu\n", name, required, ret.capacity);
-		ret.buffer = MemoryArenaPushArray(arena, u8, ret.capacity);
-		ret.count = os_file_read(file, 0, ret.capacity, ret.buffer);
-		if (ret.count < ret.capacity)
-			ret.buffer[ret.count] = 0;
-		os_file_free(file);
+u32 transform_hierarchy_push(struct Transform_Hierarchy * inst, u32 parent, vec3 offset, quat rotation, vec3 scale) {
+	AssertF(parent == TRANSFORM_ROOT || parent < inst->count, "[base] transform parent %u is out of bounds %u\n", parent, inst->count);
+	if (inst->count >= inst->capacity) {
+		inst->capacity = inst->capacity > 0 ? inst->capacity * 2 : 64;
+		inst->parents   = os_memory_heap(inst->parents,   sizeof(*inst->parents)   * inst->capacity);
+		inst->offsets   = os_memory_heap(inst->offsets,   sizeof(*inst->offsets)   * inst->capacity);
+		inst->rotations = os_memory_heap(inst->rotations, sizeof(*inst->rotations) * inst->capacity);
+		inst->scales    = os_memory_heap(inst->scales,    sizeof(*inst->scales)    * inst->capacity);
+		inst->worlds    = os_memory_heap(inst->worlds,    sizeof(*inst->worlds)    * inst->capacity);
+		inst->dirty     = os_memory_heap(inst->dirty,     sizeof(*inst->dirty)     * inst->capacity);
+		inst->partition = os_memory_heap(inst->partition, sizeof(*inst->partition) * inst->capacity);
 	}
-	return ret;
-}
 
-// ---- ---- ---- ----
-// formatting
-// ---- ---- ---- ----
-
-#define STB_SPRINTF_STATIC
-#define STB_SPRINTF_IMPLEMENTATION
-#include "_internal/warnings_push.h"
-# include <stb/stb_sprintf.h>
-#include "_internal/warnings_pop.h"
+	u32 const index = inst->count++;
+	inst->parents[index]   = parent;
+	inst->offsets[index]   = offset;
+	inst->rotations[index] = rotation;
+	inst->scales[index]    = scale;
+	inst->worlds[index]    = mat4_i;
+	inst->dirty[index]     = true;
+	inst->dirty_min = min_u32(inst->dirty_min, index);
+	inst->partition_dirty = true;
+	return index;
+}
 
-struct Fmt_Print_Ctx {
-	char scratch[STB_SPRINTF_MIN];
-};
+void transform_hierarchy_set(struct Transform_Hierarchy * inst, u32 index, vec3 offset, quat rotation, vec3 scale) {
+	AssertF(index < inst->count, "[base] transform index %u is out of bounds %u\n", index, inst->count);
+	inst->offsets[index]   = offset;
+	inst->rotations[index] = rotation;
+	inst->scales[index]    = scale;
+	inst->dirty[index]     = true;
+	inst->dirty_min = min_u32(inst->dirty_min, index);
+}
 
 AttrFileLocal()
-char * fmt_print_write(char const * input, void * user, int length) {
-	struct Fmt_Print_Ctx * ctx = user;
-	if (length > 0)
-		fwrite(input, sizeof(*input), (size_t)length, stdout);
-	return ctx->scratch;
+void transform_hierarchy_resolve(struct Transform_Hierarchy * inst, u32 index) {
+	// @note a parent has already been resolved this pass, dirtiness flows down
+	u32 const parent = inst->parents[index];
+	if (parent != TRANSFORM_ROOT)
+		inst->dirty[index] |= inst->dirty[parent];
+	if (!inst->dirty[index])
+		return;
+
+	mat4 const local = mat4_transformation(inst->offsets[index], inst->rotations[index], inst->scales[index]);
+	inst->worlds[index] = (parent != TRANSFORM_ROOT)
+		? mat4_mul_mat(inst->worlds[parent], local)
+		: local;
 }
 
-uint32_t fmt_print(char * fmt, ...) {
-	va_list args;
-	va_start(args, fmt);
+AttrFileLocal()
+void transform_hierarchy_partition(struct Transform_Hierarchy * inst, u32 workers) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	u64 const scratch_position = memory_arena_get_position(scratch);
 
-	struct Fmt_Print_Ctx ctx;
-	int const written = stbsp_vsprintfcb(fmt_print_write, &ctx, ctx.scratch, fmt, args);
+	// @note root trees are independent, so each worker owns whole ones and
+	// walks its nodes in storage order without any synchronization;
+	// a single huge tree won't be split
+	u32 * roots = MemoryArenaPushArray(scratch, u32, inst->count);
+	u32 * sizes = MemoryArenaPushArray(scratch, u32, inst->count);
+	for (u32 i = 0; i < inst->count; i++) {
+		u32 const parent = inst->parents[i];
+		roots[i] = (parent != TRANSFORM_ROOT) ? roots[parent] : i;
+		sizes[i] = 0;
+		sizes[roots[i]]++;
+	}
 
-	va_end(args);
-	return (uint32_t)written;
+	// -- greedy balance: each tree goes to the least loaded worker
+	u32 loads[WORKERS_MAX] = {0};
+	for (u32 i = 0; i < inst->count; i++) {
+		if (inst->parents[i] != TRANSFORM_ROOT) continue;
+		u32 target = 0;
+		for (u32 w = 1; w < workers; w++)
+			if (loads[w] < loads[target]) target = w;
+		loads[target] += sizes[i];
+		sizes[i] = target; // @note reused as the tree's worker
+	}
+
+	// -- stable counting sort keeps parents before children
+	inst->partition_offsets[0] = 0;
+	for (u32 w = 0; w < workers; w++)
+		inst->partition_offsets[w + 1] = inst->partition_offsets[w] + loads[w];
+	for (u32 w = 0; w < workers; w++)
+		loads[w] = inst->partition_offsets[w];
+	for (u32 i = 0; i < inst->count; i++)
+		inst->partition[loads[sizes[roots[i]]]++] = i;
+
+	inst->partition_workers = workers;
+	inst->partition_dirty = false;
+	memory_arena_set_position(scratch, scratch_position);
 }
 
-struct Fmt_Buffer_Ctx {
-	char scratch[STB_SPRINTF_MIN];
-	char * output;
+struct Transform_Hierarchy_Job {
+	struct Transform_Hierarchy * hierarchy;
+	u32 const * indices;
+	u32 count;
 };
 
 AttrFileLocal()
-char * fmt_buffer_write(char const * input, void * user, int length) {
-	struct Fmt_Buffer_Ctx * ctx = user;
-	if (length > 0) {
-		mem_copy(ctx->scratch, ctx->output, (size_t)length);
-		ctx->output += length;
+void transform_hierarchy_job(void * context) {
+	struct Transform_Hierarchy_Job const * job = context;
+	u32 const dirty_min = job->hierarchy->dirty_min;
+	for (u32 i = 0; i < job->count; i++) {
+		u32 const index = job->indices[i];
+		if (index >= dirty_min)
+			transform_hierarchy_resolve(job->hierarchy, index);
 	}
-	return ctx->scratch;
 }
 
-AttrPrint(2, 3)
-uint32_t fmt_buffer(char * out_buffer, char * fmt, ...) {
-	va_list args;
-	va_start(args, fmt);
-
-	struct Fmt_Buffer_Ctx ctx = {.output = out_buffer};
-	int const written = stbsp_vsprintfcb(fmt_buffer_write, &ctx, ctx.scratch, fmt, args);
+void transform_hierarchy_update(struct Transform_Hierarchy * inst) {
+	if (inst->dirty_min >= inst->count)
+		return;
+
+	u32 const workers = workers_get_count();
+	if (workers > 1 && inst->count - inst->dirty_min >= TRANSFORM_HIERARCHY_THREADING_MIN) {
+		if (inst->partition_dirty || inst->partition_workers != workers)
+			transform_hierarchy_partition(inst, workers);
+
+		struct Transform_Hierarchy_Job jobs[WORKERS_MAX];
+		for (u32 w = 0; w < workers; w++)
+			jobs[w] = (struct Transform_Hierarchy_Job){
+				.hierarchy = inst,
+				.indices = inst->partition + inst->partition_offsets[w],
+				.count = inst->partition_offsets[w + 1] - inst->partition_offsets[w],
+			};
+		workers_run(transform_hierarchy_job, jobs, sizeof(*jobs), workers);
+	}
+	else {
+		for (u32 i = inst->dirty_min; i < inst->count; i++)
+			transform_hierarchy_resolve(inst, i);
+	}
 
-	va_end(args);
-	return (uint32_t)written;
+	mem_zero(inst->dirty + inst->dirty_min, sizeof(*inst->dirty) * (inst->count - inst->dirty_min));
+	inst->dirty_min = inst->count;
 }
 
 // ---- ---- ---- ----
-// images
+// bounding volume hierarchy
 // ---- ---- ---- ----
 
-#define STBI_NO_STDIO
-#define STBI_ONLY_PNG
+#define BVH_BINS          16
+#define BVH_LEAF_MAX      8
+#define BVH_LEAF_GROUP    8
+#define BVH_DEPTH_MAX     48
+#define BVH_STACK         64
+#define BVH_THREADING_MIN 16384
 
-#define STBI_MALLOC(size)           os_memory_heap(NULL,    size)
-#define STBI_REALLOC(pointer, size) os_memory_heap(pointer, size)
-#define STBI_FREE(pointer)          os_memory_heap(pointer, 0)
+AttrFileLocal()
+aabb3 bvh_merge(aabb3 l, aabb3 r) {
+	return (aabb3){
+		.min = {min_f32(l.min.x, r.min.x), min_f32(l.min.y, r.min.y), min_f32(l.min.z, r.min.z)},
+		.max = {max_f32(l.max.x, r.max.x), max_f32(l.max.y, r.max.y), max_f32(l.max.z, r.max.z)},
+	};
+}
 
-#define STB_IMAGE_STATIC
-#define STB_IMAGE_IMPLEMENTATION
+AttrFileLocal()
+f32 bvh_half_area(aabb3 value) {
+	vec3 const size = vec3_sub(value.max, value.min);
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
 
-#include "_internal/warnings_push.h"
-# include <stb/stb_image.h>
-#include "_internal/warnings_pop.h"
+struct BVH_Builder {
+	aabb3 const * bounds;
+	vec3  const * centroids;
+	u32         * refs;
+	struct BVH_Node * nodes;
+	u32 nodes_count, nodes_capacity;
+	// -- threading, subtrees up to `job_limit` triangles are deferred
+	u32 job_limit;
+	struct BVH_Job * jobs;
+	u32 jobs_count, jobs_capacity;
+};
 
-struct Resource_Image resource_image_init(arr8 const bytes) {
-	stbi_set_flip_vertically_on_load(1);
-	int const channels_override = STBI_rgb_alpha;
+struct BVH_Job {
+	struct BVH_Builder builder;
+	u32 node, begin, end, depth;
+};
 
-	int size_x, size_y, channels;
-	stbi_uc * image = stbi_load_from_memory(bytes.buffer, (int)bytes.count, &size_x, &size_y, &channels, channels_override);
+AttrFileLocal()
+u32 bvh_builder_push(struct BVH_Builder * builder, u32 count) {
+	if (builder->nodes_count + count > builder->nodes_capacity) {
+		builder->nodes_capacity = max_u32(builder->nodes_capacity * 2, builder->nodes_count + count);
+		builder->nodes_capacity = max_u32(builder->nodes_capacity, 64);
+		builder->nodes = os_memory_heap(builder->nodes, sizeof(*builder->nodes) * builder->nodes_capacity);
+	}
+	u32 const ret = builder->nodes_count;
+	builder->nodes_count += count;
+	return ret;
+}
 
-	return (struct Resource_Image){
-		.scalar_size = sizeof(stbi_uc),
-		.size        = {(u32)size_x, (u32)size_y},
-		.channels    = (u8)(channels_override ? channels_override : channels),
-		.buffer      = image,
-	};
+AttrFileLocal()
+f32 bvh_cost(u32 count) {
+	// @note leaves are tested `BVH_LEAF_GROUP` triangles at a time, as wide as the widest vector
+	return (f32)((count + BVH_LEAF_GROUP - 1) / BVH_LEAF_GROUP);
 }
 
-void resource_image_free(struct Resource_Image * inst) {
-	STBI_FREE(inst->buffer);
-	mem_zero(inst, sizeof(*inst));
+AttrFileLocal()
+u32 bvh_bin(f32 value, f32 min, f32 scale) {
+	u32 const ret = (u32)((value - min) * scale);
+	return min_u32(ret, BVH_BINS - 1);
 }
 
-// ---- ---- ---- ----
-// models
-// ---- ---- ---- ----
+AttrFileLocal()
+u32 bvh_split(struct BVH_Builder * builder, u32 begin, u32 end, aabb3 bounds, aabb3 centroid_bounds) {
+	// @note binned SAH with an intersection cost of 1 and a traversal cost of 1;
+	// returns the partition point, `end` stands for a leaf
+	u32 const count = end - begin;
+	f32 const leaf_cost = bvh_cost(count) * bvh_half_area(bounds);
+
+	f32 best_cost = INF32;
+	u32 best_axis = 0, best_bin = 0;
+	f32 best_scale = 0;
+	for (u32 axis = 0; axis < 3; axis++) {
+		f32 const min    = (&centroid_bounds.min.x)[axis];
+		f32 const extent = (&centroid_bounds.max.x)[axis] - min;
+		if (!(extent > 0)) continue;
+		f32 const scale = (f32)BVH_BINS / extent;
+
+		aabb3 bins[BVH_BINS]; u32 counts[BVH_BINS] = {0};
+		for (u32 i = begin; i < end; i++) {
+			u32 const ref = builder->refs[i];
+			u32 const bin = bvh_bin((&builder->centroids[ref].x)[axis], min, scale);
+			bins[bin] = counts[bin] > 0 ? bvh_merge(bins[bin], builder->bounds[ref]) : builder->bounds[ref];
+			counts[bin]++;
+		}
 
-#define TINYOBJ_MALLOC(size)           os_memory_heap(NULL,    size)
-#define TINYOBJ_REALLOC(pointer, size) os_memory_heap(pointer, size)
-#define TINYOBJ_CALLOC(number, size)   os_memory_heap(NULL,    number * size)
-#define TINYOBJ_FREE(pointer)          os_memory_heap(pointer, 0)
+		// -- sweep from the right, then evaluate splits from the left
+		f32 right_costs[BVH_BINS];
+		aabb3 accumulated = {0}; u32 accumulated_count = 0;
+		for (u32 bin = BVH_BINS - 1; bin > 0; bin--) {
+			if (counts[bin] > 0) {
+				accumulated = accumulated_count > 0 ? bvh_merge(accumulated, bins[bin]) : bins[bin];
+				accumulated_count += counts[bin];
+			}
+			right_costs[bin] = accumulated_count > 0 ? bvh_cost(accumulated_count) * bvh_half_area(accumulated) : -1;
+		}
 
-#define TINYOBJ_LOADER_C_IMPLEMENTATION
+		accumulated_count = 0;
+		for (u32 bin = 0; bin + 1 < BVH_BINS; bin++) {
+			if (counts[bin] > 0) {
+				accumulated = accumulated_count > 0 ? bvh_merge(accumulated, bins[bin]) : bins[bin];
+				accumulated_count += counts[bin];
+			}
+			if (accumulated_count == 0 || right_costs[bin + 1] < 0) continue;
+			f32 const cost = bvh_half_area(bounds) + bvh_cost(accumulated_count) * bvh_half_area(accumulated) + right_costs[bin + 1];
+			if (cost < best_cost) {
+				best_cost = cost;
+				best_axis = axis; best_bin = bin; best_scale = scale;
+			}
+		}
+	}
 
-#include "_internal/warnings_push.h"
-# include <tinyobj_loader_c.h>
-#include "_internal/warnings_pop.h"
+	if (best_cost == INF32) {
+		// @note all centroids coincide, any order is as good
+		return count > BVH_LEAF_MAX ? begin + count / 2 : end;
+	}
+	if (best_cost >= leaf_cost && count <= BVH_LEAF_MAX)
+		return end;
+
+	f32 const min = (&centroid_bounds.min.x)[best_axis];
+	u32 left = begin, right = end;
+	while (left < right) {
+		u32 const ref = builder->refs[left];
+		if (bvh_bin((&builder->centroids[ref].x)[best_axis], min, best_scale) <= best_bin) { left++; continue; }
+		builder->refs[left] = builder->refs[--right];
+		builder->refs[right] = ref;
+	}
+	return left;
+}
+
+AttrFileLocal()
+void bvh_build(struct BVH_Builder * builder, u32 index, u32 begin, u32 end, u32 depth) {
+	// @note `builder->nodes` might move, so nodes are addressed by index
+	aabb3 bounds = builder->bounds[builder->refs[begin]];
+	vec3 const first = builder->centroids[builder->refs[begin]];
+	aabb3 centroid_bounds = {first, first};
+	for (u32 i = begin + 1; i < end; i++) {
+		u32 const ref = builder->refs[i];
+		bounds = bvh_merge(bounds, builder->bounds[ref]);
+		centroid_bounds = bvh_merge(centroid_bounds, (aabb3){builder->centroids[ref], builder->centroids[ref]});
+	}
+	builder->nodes[index] = (struct BVH_Node){.bounds = bounds, .offset = begin, .count = end - begin};
+
+	if (end - begin <= builder->job_limit) {
+		if (builder->jobs_count >= builder->jobs_capacity) {
+			builder->jobs_capacity = max_u32(builder->jobs_capacity * 2, 64);
+			builder->jobs = os_memory_heap(builder->jobs, sizeof(*builder->jobs) * builder->jobs_capacity);
+		}
+		builder->jobs[builder->jobs_count++] = (struct BVH_Job){
+			.builder = {
+				.bounds    = builder->bounds,
+				.centroids = builder->centroids,
+				.refs      = builder->refs,
+			},
+			.node = index, .begin = begin, .end = end, .depth = depth,
+		};
+		return;
+	}
+
+	if (end - begin <= 1 || depth >= BVH_DEPTH_MAX) return;
+	u32 const split = bvh_split(builder, begin, end, bounds, centroid_bounds);
+	if (split == end) return;
 
-struct Resource_Model {
-	tinyobj_attrib_t     attrib;
-	tinyobj_shape_t    * shapes;    size_t shapes_num;
-	tinyobj_material_t * materials; size_t materials_num;
-	int status;
+	u32 const child = bvh_builder_push(builder, 2);
+	builder->nodes[index].offset = child;
+	builder->nodes[index].count  = 0;
+	bvh_build(builder, child + 0, begin, split, depth + 1);
+	bvh_build(builder, child + 1, split, end,   depth + 1);
+}
+
+struct BVH_Worker {
+	struct BVH_Job * jobs;
+	u32 * indices;
+	u32 count;
 };
 
 AttrFileLocal()
-u32 resource_model_hash_tovi(void const * opaque) {
-	return hash32_fnv1(opaque, sizeof(tinyobj_vertex_index_t));
+void bvh_worker(void * context) {
+	struct BVH_Worker const * worker = context;
+	for (u32 i = 0; i < worker->count; i++) {
+		struct BVH_Job * job = worker->jobs + worker->indices[i];
+		bvh_builder_push(&job->builder, 1);
+		bvh_build(&job->builder, 0, job->begin, job->end, job->depth);
+	}
 }
 
 AttrFileLocal()
-struct RMVertex resource_model_tovi_to_vertex(struct Resource_Model * inst, tinyobj_vertex_index_t tovi) {
-	struct RMVertex vertex = {0};
-	if (tovi.v_idx >= 0)
-		vertex.position = (vec3){
-			.x = inst->attrib.vertices[3 * tovi.v_idx + 0],
-			.y = inst->attrib.vertices[3 * tovi.v_idx + 1],
-			.z = inst->attrib.vertices[3 * tovi.v_idx + 2],
-		};
-	if (tovi.vt_idx >= 0)
-		vertex.texture = (vec2){
-			.x = inst->attrib.texcoords[2 * tovi.vt_idx + 0],
-			.y = inst->attrib.texcoords[2 * tovi.vt_idx + 1],
-		};
-	if (tovi.vn_idx >= 0)
-		vertex.normal = (vec3){
-			.x = inst->attrib.normals[3 * tovi.vn_idx + 0],
-			.y = inst->attrib.normals[3 * tovi.vn_idx + 1],
-			.z = inst->attrib.normals[3 * tovi.vn_idx + 2],
-		};
-	return vertex;
+void bvh_build_jobs(struct BVH_Builder * builder, u32 workers) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	u64 const scratch_position = memory_arena_get_position(scratch);
+
+	// -- greedy balance by triangles count
+	u32 loads[WORKERS_MAX] = {0}, counts[WORKERS_MAX] = {0};
+	u32 * owners  = MemoryArenaPushArray(scratch, u32, builder->jobs_count);
+	u32 * indices = MemoryArenaPushArray(scratch, u32, builder->jobs_count);
+	for (u32 i = 0; i < builder->jobs_count; i++) {
+		u32 target = 0;
+		for (u32 w = 1; w < workers; w++)
+			if (loads[w] < loads[target]) target = w;
+		loads[target] += builder->jobs[i].end - builder->jobs[i].begin;
+		counts[target]++;
+		owners[i] = target;
+	}
+
+	struct BVH_Worker contexts[WORKERS_MAX];
+	for (u32 w = 0, offset = 0; w < workers; offset += counts[w], w++)
+		contexts[w] = (struct BVH_Worker){.jobs = builder->jobs, .indices = indices + offset};
+	for (u32 i = 0; i < builder->jobs_count; i++) {
+		struct BVH_Worker * it = contexts + owners[i];
+		it->indices[it->count++] = i;
+	}
+
+	workers_run(bvh_worker, contexts, sizeof(*contexts), workers);
+
+	// -- stitch subtrees: a job's root replaces its placeholder,
+	// the rest are appended with child indices rebased, so siblings stay adjacent
+	for (u32 i = 0; i < builder->jobs_count; i++) {
+		struct BVH_Job * job = builder->jobs + i;
+		u32 const base = bvh_builder_push(builder, job->builder.nodes_count - 1) - 1;
+		for (u32 n = 0; n < job->builder.nodes_count; n++) {
+			struct BVH_Node it = job->builder.nodes[n];
+			if (it.count == 0) it.offset += base;
+			builder->nodes[n > 0 ? base + n : job->node] = it;
+		}
+		os_memory_heap(job->builder.nodes, 0);
+	}
+
+	memory_arena_set_position(scratch, scratch_position);
 }
 
 AttrFileLocal()
-void model_init_read_file(void *ctx, const char *filename, int is_mtl, const char *obj_filename, char **buf, size_t *len) {
-	struct Memory_Arena * scratch = ctx;
-	arr8 const file_bytes = base_file_read(scratch, filename);
-	*buf = (void *)file_bytes.buffer;
-	*len = file_bytes.count;
+vec3 bvh_get_position(struct BVH_IInfo info, u32 corner) {
+	u32 const index = (info.index_size == sizeof(u32))
+		? ((u32 const *)info.indices)[corner]
+		: ((u16 const *)info.indices)[corner];
+	return *(vec3 const *)(void const *)((u8 const *)info.positions + info.stride * index);
 }
 
-struct Resource_Model * resource_model_init(char const * name) {
+struct BVH bvh_init(struct BVH_IInfo info) {
 	struct Memory_Arena * scratch = thread_ctx_get_scratch();
 	u64 const scratch_position = memory_arena_get_position(scratch);
 
-	struct Resource_Model * file_parsed = os_memory_heap(NULL, sizeof(*file_parsed));
-	file_parsed->status = tinyobj_parse_obj(&file_parsed->attrib,
-		&file_parsed->shapes, &file_parsed->shapes_num,
-		&file_parsed->materials, &file_parsed->materials_num,
-		name, model_init_read_file, scratch,
-		TINYOBJ_FLAG_TRIANGULATE
-	);
+	u32 const count = info.indices_count / 3;
+	if (count == 0) return (struct BVH){0};
+
+	// -- per triangle inputs
+	aabb3 * bounds    = MemoryArenaPushArray(scratch, aabb3, count);
+	vec3  * centroids = MemoryArenaPushArray(scratch, vec3,  count);
+	u32   * refs      = MemoryArenaPushArray(scratch, u32,   count);
+	for (u32 i = 0; i < count; i++) {
+		vec3 const a = bvh_get_position(info, i * 3 + 0);
+		vec3 const b = bvh_get_position(info, i * 3 + 1);
+		vec3 const c = bvh_get_position(info, i * 3 + 2);
+		bounds[i] = bvh_merge(bvh_merge((aabb3){a, a}, (aabb3){b, b}), (aabb3){c, c});
+		centroids[i] = vec3_muls(vec3_add(bounds[i].min, bounds[i].max), 0.5f);
+		refs[i] = i;
+	}
+
+	// -- build the top serially, then independent subtrees in parallel
+	u32 const workers = workers_get_count();
+	struct BVH_Builder builder = {
+		.bounds    = bounds,
+		.centroids = centroids,
+		.refs      = refs,
+		.job_limit = (workers > 1 && count >= BVH_THREADING_MIN) ? count / (workers * 4) : 0,
+	};
+	bvh_builder_push(&builder, 1);
+	bvh_build(&builder, 0, 0, count, 0);
+	if (builder.jobs_count > 0)
+		bvh_build_jobs(&builder, workers);
+	os_memory_heap(builder.jobs, 0);
+
+	// -- triangles in leaf order as a structure of arrays,
+	// padded so that vector loads never leave the allocation
+	u32 const stride = (u32)align_size(count + 8, 8);
+	struct BVH ret = {
+		.nodes = os_memory_heap(builder.nodes, sizeof(*builder.nodes) * builder.nodes_count),
+		.nodes_count = builder.nodes_count,
+		.triangles_count = count,
+		.triangles_stride = stride,
+		.triangles = os_memory_heap(NULL, sizeof(*ret.triangles) * count),
+		.data = os_memory_heap(NULL, sizeof(*ret.data) * stride * 9),
+	};
+	mem_zero(ret.data, sizeof(*ret.data) * stride * 9);
+	for (u32 i = 0; i < count; i++) {
+		u32 const ref = refs[i];
+		vec3 const a = bvh_get_position(info, ref * 3 + 0);
+		vec3 const b = bvh_get_position(info, ref * 3 + 1);
+		vec3 const c = bvh_get_position(info, ref * 3 + 2);
+		vec3 const e1 = vec3_sub(b, a), e2 = vec3_sub(c, a);
+		ret.triangles[i] = ref;
+		ret.data[stride * 0 + i] = a.x;  ret.data[stride * 1 + i] = a.y;  ret.data[stride * 2 + i] = a.z;
+		ret.data[stride * 3 + i] = e1.x; ret.data[stride * 4 + i] = e1.y; ret.data[stride * 5 + i] = e1.z;
+		ret.data[stride * 6 + i] = e2.x; ret.data[stride * 7 + i] = e2.y; ret.data[stride * 8 + i] = e2.z;
+	}
 
 	memory_arena_set_position(scratch, scratch_position);
-	return file_parsed;
+	return ret;
 }
 
-void resource_model_free(struct Resource_Model * inst) {
-	tinyobj_attrib_free(&inst->attrib);
-	if (inst->shapes)
-		tinyobj_shapes_free(inst->shapes, inst->shapes_num);
-	if (inst->materials)
-		tinyobj_materials_free(inst->materials, inst->materials_num);
+void bvh_free(struct BVH * inst) {
+	os_memory_heap(inst->nodes,     0);
+	os_memory_heap(inst->triangles, 0);
+	os_memory_heap(inst->data,      0);
 	mem_zero(inst, sizeof(*inst));
-	os_memory_heap(inst, 0);
 }
 
-void resource_model_dump_vertices(struct Resource_Model * inst, struct Memory_Arena * scratch,
-	struct RMVertex ** out_vertices, u32 * out_vertices_count,
-	u16            ** out_indices,  u16 * out_indices_count
-) {
-	u32 const indices_count        = inst->attrib.num_faces;
-	struct RMVertex * vertices = MemoryArenaPushArray(scratch, struct RMVertex, indices_count);
-	u16                 * indices  = MemoryArenaPushArray(scratch, u16,                 indices_count);
-	*out_vertices = vertices; *out_indices  = indices;
+struct BVH_Ray {
+	vec3 origin, reverse;
+#if SIMD_F32X4
+	f32x4 origin4, reverse4;
+#endif
+};
+
+AttrFileLocal()
+f32 bvh_ray_reverse(f32 value) {
+	// @note keeps slabs finite, so that `0 * inf` never produces a NaN
+	f32 const limit = 1e-30f;
+	if (value > -limit && value < limit) value = value < 0 ? -limit : limit;
+	return 1 / value;
+}
+
+AttrFileLocal()
+f32 bvh_ray_box(struct BVH_Ray const * ray, aabb3 const * box, f32 max_distance) {
+	// @note slab test, returns the entry distance or `INF32` for a miss
+#if SIMD_F32X4
+	// @note lane 3 reads whatever follows, but is never reduced
+	f32x4 const t1 = f32x4_mul(f32x4_sub(f32x4_load(&box->min.x), ray->origin4), ray->reverse4);
+	f32x4 const t2 = f32x4_mul(f32x4_sub(f32x4_load(&box->max.x), ray->origin4), ray->reverse4);
+	f32x4 const lo = f32x4_min(t1, t2), hi = f32x4_max(t1, t2);
+	f32 const t_near = f32x4_first(f32x4_max(f32x4_max(lo, f32x4_swizzle(lo, 1, 1, 1, 1)), f32x4_swizzle(lo, 2, 2, 2, 2)));
+	f32 const t_far  = f32x4_first(f32x4_min(f32x4_min(hi, f32x4_swizzle(hi, 1, 1, 1, 1)), f32x4_swizzle(hi, 2, 2, 2, 2)));
+#else
+	f32 t_near = -INF32, t_far = INF32;
+	for (u32 axis = 0; axis < 3; axis++) {
+		f32 const t1 = ((&box->min.x)[axis] - (&ray->origin.x)[axis]) * (&ray->reverse.x)[axis];
+		f32 const t2 = ((&box->max.x)[axis] - (&ray->origin.x)[axis]) * (&ray->reverse.x)[axis];
+		t_near = max_f32(t_near, min_f32(t1, t2));
+		t_far  = min_f32(t_far,  max_f32(t1, t2));
+	}
+#endif
+	f32 const entry = max_f32(t_near, 0);
+	return (entry <= t_far && entry < max_distance) ? entry : INF32;
+}
+
+AttrFileLocal()
+bool bvh_leaf(struct BVH const * inst, ray3 ray, struct BVH_Node node, bool any, struct BVH_Hit * hit) {
+	// @note Möller-Trumbore, double-sided; degenerate triangles produce
+	// infinities or NaNs, which fail the comparisons below
+	bool ret = false;
+	f32 const * data = inst->data + node.offset;
+	u32 const stride = inst->triangles_stride;
+	u32 i = 0;
+#if F32XW_WIDTH > 0
+	f32xw const dx = f32xw_splat(ray.direction.x), dy = f32xw_splat(ray.direction.y), dz = f32xw_splat(ray.direction.z);
+	f32xw const ox = f32xw_splat(ray.origin.x),    oy = f32xw_splat(ray.origin.y),    oz = f32xw_splat(ray.origin.z);
+	f32xw const zero = f32xw_splat(0), one = f32xw_splat(1);
+	for (; i < node.count; i += F32XW_WIDTH) {
+		f32 const * it = data + i;
+		f32xw const e1x = f32xw_load(it + stride * 3), e1y = f32xw_load(it + stride * 4), e1z = f32xw_load(it + stride * 5);
+		f32xw const e2x = f32xw_load(it + stride * 6), e2y = f32xw_load(it + stride * 7), e2z = f32xw_load(it + stride * 8);
+		f32xw const px = f32xw_sub(f32xw_mul(dy, e2z), f32xw_mul(dz, e2y));
+		f32xw const py = f32xw_sub(f32xw_mul(dz, e2x), f32xw_mul(dx, e2z));
+		f32xw const pz = f32xw_sub(f32xw_mul(dx, e2y), f32xw_mul(dy, e2x));
+		f32xw const det = f32xw_add(f32xw_add(f32xw_mul(e1x, px), f32xw_mul(e1y, py)), f32xw_mul(e1z, pz));
+		f32xw const reverse = f32xw_div(one, det);
+		f32xw const tx = f32xw_sub(ox, f32xw_load(it + stride * 0));
+		f32xw const ty = f32xw_sub(oy, f32xw_load(it + stride * 1));
+		f32xw const tz = f32xw_sub(oz, f32xw_load(it + stride * 2));
+		f32xw const u = f32xw_mul(f32xw_add(f32xw_add(f32xw_mul(tx, px), f32xw_mul(ty, py)), f32xw_mul(tz, pz)), reverse);
+		f32xw const qx = f32xw_sub(f32xw_mul(ty, e1z), f32xw_mul(tz, e1y));
+		f32xw const qy = f32xw_sub(f32xw_mul(tz, e1x), f32xw_mul(tx, e1z));
+		f32xw const qz = f32xw_sub(f32xw_mul(tx, e1y), f32xw_mul(ty, e1x));
+		f32xw const v = f32xw_mul(f32xw_add(f32xw_add(f32xw_mul(dx, qx), f32xw_mul(dy, qy)), f32xw_mul(dz, qz)), reverse);
+		f32xw const t = f32xw_mul(f32xw_add(f32xw_add(f32xw_mul(e2x, qx), f32xw_mul(e2y, qy)), f32xw_mul(e2z, qz)), reverse);
+		f32xw const accepted = f32xw_and(
+			f32xw_and(f32xw_ge(u, zero), f32xw_ge(v, zero)),
+			f32xw_and(f32xw_ge(one, f32xw_add(u, v)), f32xw_and(f32xw_gt(t, zero), f32xw_gt(f32xw_splat(hit->distance), t)))
+		);
+		u32 mask = f32xw_mask(accepted);
+		if (node.count - i < F32XW_WIDTH) mask &= (1u << (node.count - i)) - 1;
+		if (mask == 0) continue;
+		if (any) return true;
+
+		f32 ts[F32XW_WIDTH], us[F32XW_WIDTH], vs[F32XW_WIDTH];
+		f32xw_store(ts, t); f32xw_store(us, u); f32xw_store(vs, v);
+		for (; mask != 0; mask &= mask - 1) {
+			u32 const lane = ctz_u32(mask);
+			if (!(ts[lane] < hit->distance)) continue;
+			*hit = (struct BVH_Hit){
+				.distance = ts[lane],
+				.triangle = inst->triangles[node.offset + i + lane],
+				.barycentric = {us[lane], vs[lane]},
+			};
+			ret = true;
+		}
+	}
+#endif
+	for (; i < node.count; i++) {
+		f32 const * it = data + i;
+		vec3 const e1 = {it[stride * 3], it[stride * 4], it[stride * 5]};
+		vec3 const e2 = {it[stride * 6], it[stride * 7], it[stride * 8]};
+		vec3 const d = ray.direction;
+		f32 const px = d.y * e2.z - d.z * e2.y;
+		f32 const py = d.z * e2.x - d.x * e2.z;
+		f32 const pz = d.x * e2.y - d.y * e2.x;
+		f32 const det = e1.x * px + e1.y * py + e1.z * pz;
+		f32 const reverse = 1 / det;
+		f32 const tx = ray.origin.x - it[stride * 0];
+		f32 const ty = ray.origin.y - it[stride * 1];
+		f32 const tz = ray.origin.z - it[stride * 2];
+		f32 const u = (tx * px + ty * py + tz * pz) * reverse;
+		f32 const qx = ty * e1.z - tz * e1.y;
+		f32 const qy = tz * e1.x - tx * e1.z;
+		f32 const qz = tx * e1.y - ty * e1.x;
+		f32 const v = (d.x * qx + d.y * qy + d.z * qz) * reverse;
+		f32 const t = (e2.x * qx + e2.y * qy + e2.z * qz) * reverse;
+		if (!(u >= 0 && v >= 0 && 1 >= u + v && t > 0 && hit->distance > t)) continue;
+		if (any) return true;
+		*hit = (struct BVH_Hit){
+			.distance = t,
+			.triangle = inst->triangles[node.offset + i],
+			.barycentric = {u, v},
+		};
+		ret = true;
+	}
+	return ret;
+}
+
+AttrFileLocal()
+bool bvh_trace(struct BVH const * inst, ray3 ray, f32 max_distance, bool any, struct BVH_Hit * out_hit) {
+	if (inst->nodes_count == 0) return false;
+
+	struct BVH_Ray const box_ray = {
+		.origin  = ray.origin,
+		.reverse = {
+			bvh_ray_reverse(ray.direction.x),
+			bvh_ray_reverse(ray.direction.y),
+			bvh_ray_reverse(ray.direction.z),
+		},
+#if SIMD_F32X4
+		.origin4  = f32x4_set(ray.origin.x, ray.origin.y, ray.origin.z, 0),
+		.reverse4 = f32x4_set(
+			bvh_ray_reverse(ray.direction.x),
+			bvh_ray_reverse(ray.direction.y),
+			bvh_ray_reverse(ray.direction.z),
+			0
+		),
+#endif
+	};
 
-	struct Hash_Map tovi_to_index = hash_map_init(&resource_model_hash_tovi, sizeof(tinyobj_vertex_index_t), sizeof(u16));
-	hash_map_arena(&tovi_to_index, scratch, indices_count);
-
-	u16 unique_vertices_count = 0;
-	for (u32 i = 0; i < indices_count; i++) {
-		tinyobj_vertex_index_t const tovi = inst->attrib.faces[i];
-		u16 index = unique_vertices_count;
-		u16 const * existing = hash_map_get(&tovi_to_index, &tovi);
-		if (existing == NULL) {
-			hash_map_set(&tovi_to_index, &tovi, &index);
-			*vertices++ = resource_model_tovi_to_vertex(inst, tovi);
-			unique_vertices_count++;
+	struct BVH_Hit hit = {.distance = max_distance};
+	bool ret = false;
+	if (bvh_ray_box(&box_ray, &inst->nodes[0].bounds, hit.distance) == INF32)
+		return false;
+
+	// @note children are visited front to back, the farther one waits on the stack
+	u32 stack[BVH_STACK]; f32 stack_distances[BVH_STACK]; u32 stack_count = 0;
+	for (u32 index = 0;;) {
+		struct BVH_Node const node = inst->nodes[index];
+		if (node.count > 0) {
+			if (bvh_leaf(inst, ray, node, any, &hit)) {
+				ret = true;
+				if (any) break;
+			}
+		}
+		else {
+			f32 const left  = bvh_ray_box(&box_ray, &inst->nodes[node.offset + 0].bounds, hit.distance);
+			f32 const right = bvh_ray_box(&box_ray, &inst->nodes[node.offset + 1].bounds, hit.distance);
+			u32 const first = (right < left) ? 1 : 0;
+			f32 const first_distance  = first ? right : left;
+			f32 const second_distance = first ? left  : right;
+			if (first_distance != INF32) {
+				if (second_distance != INF32) {
+					stack[stack_count] = node.offset + (first ^ 1);
+					stack_distances[stack_count] = second_distance;
+					stack_count++;
+				}
+				index = node.offset + first;
+				continue;
+			}
 		}
-		else index = *existing;
-		*indices++ = index;
+
+		// @note a closer hit might have been found since a node was stacked
+		while (stack_count > 0 && !(stack_distances[stack_count - 1] < hit.distance))
+			stack_count--;
+		if (stack_count == 0) break;
+		index = stack[--stack_count];
 	}
 
-	*out_vertices_count = unique_vertices_count;
-	*out_indices_count = (u16)indices_count;
+	if (ret && out_hit != NULL) *out_hit = hit;
+	return ret;
+}
+
+bool bvh_raycast(struct BVH const * inst, ray3 ray, f32 max_distance, struct BVH_Hit * out_hit) {
+	return bvh_trace(inst, ray, max_distance, false, out_hit);
+}
+
+bool bvh_occluded(struct BVH const * inst, ray3 ray, f32 max_distance) {
+	return bvh_trace(inst, ray, max_distance, true, NULL);
 }
@@ -25,6 +25,7 @@ enum Meta_Type {
 	META_TYPE_S32,
 	META_TYPE_S64,
 	// floating points
+	META_TYPE_F16,
 	META_TYPE_F32,
 	META_TYPE_F64,
 };
@@ -45,6 +46,7 @@ typedef int16_t  s16;
 typedef int32_t  s32;
 typedef int64_t  s64;
 
+typedef uint16_t f16; // @note storage only, convert for math
 typedef float    f32;
 typedef double   f64;
 
@@ -159,6 +161,12 @@ struct Vector4_F32 {
 	f32 x, y, z, w;
 };
 
+// @note a structure of arrays, `count` is tracked by the user
+typedef struct Vector3_F32_SoA vec3_soa;
+struct Vector3_F32_SoA {
+	f32 * x, * y, * z;
+};
+
 typedef struct Matrix2_F32 mat2;
 struct Matrix2_F32 {
 	vec2 x, y;
@@ -174,6 +182,22 @@ struct Matrix4_F32 {
 	vec4 x, y, z, w;
 };
 
+typedef struct AABB3_F32 aabb3;
+struct AABB3_F32 {
+	vec3 min, max;
+};
+
+typedef struct Sphere3_F32 sphere3;
+struct Sphere3_F32 {
+	vec3 center;
+	f32  radius;
+};
+
+typedef struct Ray3_F32 ray3;
+struct Ray3_F32 {
+	vec3 origin, direction;
+};
+
 // ---- ---- ---- ----
 // types: s32 math
 // ---- ---- ---- ----
@@ -230,6 +254,11 @@ size_t align_size(size_t value, size_t align);
 u64 mul_div_u64(u64 value, u64 mul, u64 div);
 size_t mul_div_size(size_t value, size_t mul, size_t div);
 
+u32 ctz_u32(u32 value); // @note `value` should be non-zero
+u32 ctz_u64(u64 value); // @note `value` should be non-zero
+u32 clz_u64(u64 value); // @note `value` should be non-zero
+u32 popcount_u64(u64 value);
+
 // ---- ---- ---- ----
 // functions: f32
 // ---- ---- ---- ----
@@ -241,6 +270,7 @@ f32 sin32(f32 value);
 f32 cos32(f32 value);
 f32 tan32(f32 value);
 f32 sqrt32(f32 value);
+f32 abs32(f32 value);
 
 f32 round32(f32 value);
 f32 trunc32(f32 value);
@@ -267,6 +297,43 @@ f32 eerp32_inverse(f32 v1, f32 v2, f32 value);
 f32 prev_f32(f32 value);
 f32 next_f32(f32 value);
 
+// ---- ---- ---- ----
+// functions: f32, fast
+// ---- ---- ---- ----
+
+/*
+@note polynomial approximations, trading accuracy for speed; maximum errors
+were measured against libm in f64, NaN and infinity are not handled
+- sin, cos: absolute error 1e-7 for `|value| <= 8192`, 1e-6 up to `2^16`
+- tan:      relative error 2.3e-7 for `|value| <= pi`, grows with `|value|` and near poles
+- exp2:     relative error 1e-7, `value` is clamped to `[-126 .. 127]`
+- log2:     absolute error 8.6e-8 over `[0.5 .. 2]`, relative error 7.6e-8 elsewhere,
+            positive normal `value` only
+- pow:      relative error 9.3e-7 for positive `base` and `|exp * log2(base)| <= 16`
+- eerp:     same as pow for `v2 / v1`, positive `v1` and `v2`
+batch variants go 4 or 8 lanes wide and match the scalar ones bit for bit
+*/
+
+f32 sin32_fast(f32 value);
+f32 cos32_fast(f32 value);
+f32 tan32_fast(f32 value);
+
+f32 exp2_32_fast(f32 value);
+f32 log2_32_fast(f32 value);
+
+f32 pow32_fast(f32 base, f32 exp);
+f32 eerp32_fast(f32 v1, f32 v2, f32 t);
+
+void sin32_fast_batch(size_t count, f32 const * source, f32 * target);
+void cos32_fast_batch(size_t count, f32 const * source, f32 * target);
+void tan32_fast_batch(size_t count, f32 const * source, f32 * target);
+
+void exp2_32_fast_batch(size_t count, f32 const * source, f32 * target);
+void log2_32_fast_batch(size_t count, f32 const * source, f32 * target);
+
+void pow32_fast_batch(size_t count, f32 const * base, f32 const * exp, f32 * target);
+void eerp32_fast_batch(size_t count, f32 const * v1, f32 const * v2, f32 const * t, f32 * target);
+
 // ---- ---- ---- ----
 // functions: f64
 // ---- ---- ---- ----
@@ -278,6 +345,7 @@ f64 sin64(f64 value);
 f64 cos64(f64 value);
 f64 tan64(f64 value);
 f64 sqrt64(f64 value);
+f64 abs64(f64 value);
 
 f64 round64(f64 value);
 f64 trunc64(f64 value);
@@ -304,6 +372,31 @@ f64 eerp64_inverse(f64 v1, f64 v2, f64 value);
 f64 prev_f64(f64 value);
 f64 next_f64(f64 value);
 
+// ---- ---- ---- ----
+// functions: f16
+// ---- ---- ---- ----
+
+// @note rounds to nearest even, keeps infinities and denormals, quiets NaNs
+f16 f16_from_f32(f32 value);
+f32 f32_from_f16(f16 value);
+
+void f16_from_f32_batch(size_t count, f32 const * source, f16 * target);
+void f32_from_f16_batch(size_t count, f16 const * source, f32 * target);
+
+// ---- ---- ---- ----
+// functions: packing
+// ---- ---- ---- ----
+
+// @note normalized integers clamp and round to nearest, decoding matches GPU formats
+s16 snorm16_from_f32(f32 value);
+f32 f32_from_snorm16(s16 value);
+u16 unorm16_from_f32(f32 value);
+f32 f32_from_unorm16(u16 value);
+
+// @note maps unit vectors onto the `[-1 .. 1]` square and back
+vec2 octahedral_encode(vec3 value);
+vec3 octahedral_decode(vec2 value);
+
 // ---- ---- ---- ----
 // functions: limit
 // ---- ---- ---- ----
@@ -365,9 +458,58 @@ u32 hash32_djb2(void const * value, size_t size);
 u32 hash32_xorshift(u32 value);
 
 u64 hash64_fnv1(void const * value, size_t size);
+u64 hash64_fnv1_continue(u64 hash, void const * value, size_t size); // @note chains pieces as if they were one
 u64 hash64_djb2(void const * value, size_t size);
 u64 hash64_xorshift(u64 value);
 
+// ---- ---- ---- ----
+// functions: compression
+// ---- ---- ---- ----
+
+// @note LZ4 block format; both return `0` when `capacity` is not enough
+// or the source is malformed
+size_t lz4_get_bound(size_t size);
+size_t lz4_compress(size_t size, u8 const * source, size_t capacity, u8 * target);
+size_t lz4_decompress(size_t size, u8 const * source, size_t capacity, u8 * target);
+
+// ---- ---- ---- ----
+// functions: random
+// ---- ---- ---- ----
+
+// @note `f32` results are uniform in `[0 .. 1)`, with 24 bits of precision
+
+// @note a single stream, batches produce the same sequence as `pcg32_next`
+struct PCG32 {
+	u64 state, increment;
+};
+
+struct PCG32 pcg32_init(u64 seed, u64 sequence);
+u32 pcg32_next(struct PCG32 * inst);
+f32 pcg32_next_f32(struct PCG32 * inst);
+void pcg32_fill_u32(struct PCG32 * inst, size_t count, u32 * target);
+void pcg32_fill_f32(struct PCG32 * inst, size_t count, f32 * target);
+
+struct Xoshiro256 {
+	u64 state[4];
+};
+
+struct Xoshiro256 xoshiro256_init(u64 seed);
+u64 xoshiro256_next(struct Xoshiro256 * inst);
+f32 xoshiro256_next_f32(struct Xoshiro256 * inst);
+// @note advances by 2^128 steps, for non-overlapping streams
+void xoshiro256_jump(struct Xoshiro256 * inst);
+
+// @note four streams side by side, each one a jump ahead of the previous;
+// a step yields low and high halves of each lane in order, 8 values in total
+struct Xoshiro256_X4 {
+	u64 state[4][4]; // @note `[word][lane]`
+};
+
+// @note takes the streams from `source`, which is jumped past them
+struct Xoshiro256_X4 xoshiro256_x4_init(struct Xoshiro256 * source);
+void xoshiro256_x4_fill_u32(struct Xoshiro256_X4 * inst, size_t count, u32 * target);
+void xoshiro256_x4_fill_f32(struct Xoshiro256_X4 * inst, size_t count, f32 * target);
+
 // ---- ---- ---- ----
 // functions: array
 // ---- ---- ---- ----
@@ -396,6 +538,35 @@ void str8_append(str8 * inst, str8 value);
 void str16_append(str16 * inst, str16 value);
 void str32_append(str32 * inst, str32 value);
 
+// @note searches return `inst.count` if nothing was found
+size_t str8_find_byte(str8 inst, u8 value);
+size_t str8_find_any(str8 inst, str8 set);
+
+str8 str8_skip_space(str8 inst);
+str8 str8_next_line(str8 * inst); // @note advances `inst` past the line and its terminator
+
+// @note sets a bit per each `\n`, `out_bits` should hold `(inst.count + 63) / 64` entries
+size_t str8_index_newlines(str8 inst, u64 * out_bits);
+
+// @note parsers consume a number from the start of `inst` and advance it, return `false`
+// and leave `inst` intact otherwise; floats are decimal only, correctly rounded
+bool str8_parse_u64(str8 * inst, u64 * out);
+bool str8_parse_s64(str8 * inst, s64 * out);
+bool str8_parse_f64(str8 * inst, f64 * out);
+bool str8_parse_f32(str8 * inst, f32 * out);
+
+// @note parses up to `count` triplets of whitespace-separated floats, returns how many were complete
+size_t str8_parse_vec3(str8 * inst, vec3 * out, size_t count);
+
+// @note transcoders validate input and return `{0}` on malformed sequences, surrogates
+// or code points beyond `U+10FFFF`; results are zero-terminated, `count` doesn't include it
+str16 str16_from_str8(struct Memory_Arena * arena, str8 value);
+str32 str32_from_str8(struct Memory_Arena * arena, str8 value);
+str8 str8_from_str16(struct Memory_Arena * arena, str16 value);
+str32 str32_from_str16(struct Memory_Arena * arena, str16 value);
+str8 str8_from_str32(struct Memory_Arena * arena, str32 value);
+str16 str16_from_str32(struct Memory_Arena * arena, str32 value);
+
 // ---- ---- ---- ----
 // functions: table
 // ---- ---- ---- ----
@@ -468,12 +639,77 @@ mat4 mat4_transformation(vec3 offset, quat rotation, vec3 scale);
 mat4 mat4_transformation_inverse(vec3 offset, quat rotation, vec3 scale);
 mat4 mat4_invert_transformation(mat4 transformation);
 
+// @note singular matrices invert into zeros; the affine variant assumes
+// the last row to be `{0, 0, 0, 1}`, but handles any scale and shear
+f32  mat4_determinant(mat4 value);
+mat4 mat4_inverse(mat4 value);
+mat4 mat4_inverse_affine(mat4 value);
+
 mat4 mat4_projection(
 	vec2 scale_xy, vec2 offset_xy, f32 ortho,
 	f32 view_near, f32 view_far,
 	f32 ndc_near,  f32 ndc_far
 );
 
+// ---- ---- ---- ----
+// functions: f32 math, batch
+// ---- ---- ---- ----
+
+// @note strides are in bytes, i.e. `sizeof(struct RMVertex)` for vertices or `sizeof(vec3)`
+// for packed arrays; `source` and `target` may alias exactly, transforming in place;
+// points are affine with `w == 1`, directions with `w == 0`, both match `mat4_mul_vec`
+
+void mat4_transform_points(mat4 m, size_t count, vec3 const * source, size_t source_stride, vec3 * target, size_t target_stride);
+void mat4_transform_directions(mat4 m, size_t count, vec3 const * source, size_t source_stride, vec3 * target, size_t target_stride);
+void mat4_transform_points_soa(mat4 m, size_t count, vec3_soa source, vec3_soa target);
+void mat4_transform_directions_soa(mat4 m, size_t count, vec3_soa source, vec3_soa target);
+
+// @note uses the inverse-transpose of `m` and renormalizes results
+void mat4_transform_normals(mat4 m, size_t count, vec3 const * source, size_t source_stride, vec3 * target, size_t target_stride);
+void mat4_transform_normals_soa(mat4 m, size_t count, vec3_soa source, vec3_soa target);
+
+// @note `target[i] = l * source[i]`
+void mat4_mul_mat_batch(mat4 l, size_t count, mat4 const * source, mat4 * target);
+
+void mat4_inverse_batch(size_t count, mat4 const * source, mat4 * target);
+void mat4_inverse_affine_batch(size_t count, mat4 const * source, mat4 * target);
+
+// ---- ---- ---- ----
+// functions: f32 math, bounds
+// ---- ---- ---- ----
+
+#define FRUSTUM_PLANES 6
+
+// @note strides are in bytes, as for the batch transforms
+aabb3   aabb3_from_points(size_t count, vec3 const * source, size_t stride);
+sphere3 sphere3_from_points(size_t count, vec3 const * source, size_t stride);
+aabb3   aabb3_transform(aabb3 value, mat4 m);
+
+// @note extracts normalized `FRUSTUM_PLANES` planes, `{normal, distance}` with normals pointing inside;
+// `value` is a full clip matrix, the same `ndc_near` and `ndc_far` as for `mat4_projection`
+void mat4_frustum_planes(mat4 value, f32 ndc_near, f32 ndc_far, vec4 * out_planes);
+
+// @note sets bit `i % 64` of `out_visible[i / 64]` for each visible volume,
+// `out_visible` should hold `(count + 63) / 64` entries
+void frustum_cull_aabb3(vec4 const * planes, size_t count, aabb3 const * source, u64 * out_visible);
+void frustum_cull_sphere3(vec4 const * planes, size_t count, sphere3 const * source, u64 * out_visible);
+
+// ---- ---- ---- ----
+// functions: noise
+// ---- ---- ---- ----
+
+// @note lattice noise in about `[-1 .. 1]`, coordinates should stay within `s32` range;
+// batches are bit-identical to the scalar versions
+f32 noise_value2(u32 seed, vec2 position);
+f32 noise_value3(u32 seed, vec3 position);
+f32 noise_gradient2(u32 seed, vec2 position);
+f32 noise_gradient3(u32 seed, vec3 position);
+
+void noise_value2_batch(u32 seed, size_t count, vec2 const * source, f32 * target);
+void noise_value3_batch(u32 seed, size_t count, vec3 const * source, f32 * target);
+void noise_gradient2_batch(u32 seed, size_t count, vec2 const * source, f32 * target);
+void noise_gradient3_batch(u32 seed, size_t count, vec3 const * source, f32 * target);
+
 // ---- ---- ---- ----
 // functions: s32 math, vector
 // ---- ---- ---- ----
@@ -722,12 +958,230 @@ void thread_ctx_free(void);
 
 struct Memory_Arena * thread_ctx_get_scratch(void);
 
+// ---- ---- ---- ----
+// workers
+// ---- ---- ---- ----
+
+#define WORKERS_MAX 16
+
+// @note spawns `processor_count - 1` threads, which sleep until there's work
+void workers_init(void);
+void workers_free(void);
+
+// @note includes the calling thread; 1 without `workers_init`
+u32 workers_get_count(void);
+
+// @note calls `function` for each of `count` contexts `stride` bytes apart,
+// the calling thread takes a share and returns once all of them are done;
+// not reentrant, jobs may not run other jobs
+void workers_run(void (* function)(void * context), void * contexts, size_t stride, u32 count);
+
 // ---- ---- ---- ----
 // file utilities
 // ---- ---- ---- ----
 
 struct Array_U8 base_file_read(struct Memory_Arena * arena, char const * name);
 
+// @note keeps all the reads in flight at once; missing files come out empty
+void base_file_read_batch(struct Memory_Arena * arena, u32 count, char const * const * names, struct Array_U8 * out);
+
+// @note a read-only view without copying, valid until `base_file_unmap`;
+// bytes past `count` up to the page end read as zeros, so text is terminated
+// unless its size is a multiple of the page size
+struct Array_U8 base_file_map(char const * name, bool read_ahead);
+void base_file_unmap(struct Array_U8 * inst);
+
+// @note writes through a temporary, so readers see either the old file or the new one
+bool base_file_write(char const * name, struct Array_U8 data);
+
+// ---- ---- ---- ----
+// file writer
+// ---- ---- ---- ----
+
+#define FILE_WRITER_BUFFER_SIZE (256 * 1024)
+
+struct File_Writer_IInfo {
+	char const * name;        // @note should outlive the writer
+	size_t       buffer_size; // @note `FILE_WRITER_BUFFER_SIZE` by default
+	bool         append;
+	bool         atomic;      // @note writes into "<name>.tmp" and replaces `name` at the end
+	bool         direct;      // @note bypasses the system cache, for bulk outputs
+};
+
+// @note accumulates small writes into whole buffers; `file` is `NULL` if
+// the file can't be created, then writes are ignored
+struct File_Writer {
+	struct OS_File * file;
+	char const * name;
+	char       * temporary;
+	u8   * buffer;
+	size_t count;
+	size_t capacity;
+	u64    offset;
+	bool   append;
+	bool   direct;
+	bool   failed;
+};
+
+struct File_Writer file_writer_init(struct File_Writer_IInfo info);
+
+// @note returns whether everything has been written and, for atomic writers, published
+bool file_writer_free(struct File_Writer * inst);
+
+void file_writer_write(struct File_Writer * inst, size_t size, void const * data);
+
+// ---- ---- ---- ----
+// file stream
+// ---- ---- ---- ----
+
+#define FILE_STREAM_CHUNK_SIZE (64 * 1024)
+
+struct File_Stream_IInfo {
+	char const *    name;
+	struct Array_U8 view;       // @note streams memory instead, say a mapped archive entry
+	size_t          chunk_size; // @note `FILE_STREAM_CHUNK_SIZE` by default
+};
+
+// @note delivers a file chunk by chunk, reading the next one while the current
+// is being consumed; views prefetch the next chunk instead; both `file` and `view`
+// are `NULL` for missing files
+struct File_Stream {
+	u8 const             * view;
+	struct OS_File       * file;
+	struct OS_File_Queue * queue;
+	u8   * buffer; // @note two chunks
+	size_t chunk_size;
+	u64    size;
+	u64    submitted;
+	u32    delivered;
+	// out of order completion
+	void * stash_context;
+	u64    stash_size;
+	bool   stash_ok;
+};
+
+struct File_Stream file_stream_init(struct File_Stream_IInfo info);
+void file_stream_free(struct File_Stream * inst);
+
+// @note a chunk stays valid until the following call; empty at the end
+struct Array_U8 file_stream_next(struct File_Stream * inst);
+
+// ---- ---- ---- ----
+// archive
+// ---- ---- ---- ----
+
+#define ARCHIVE_MAGIC      0x41504b55 // "UKPA"
+#define ARCHIVE_VERSION    1
+#define ARCHIVE_ALIGNMENT  64
+#define ARCHIVE_UNPACK_MAX 0x40000000 // @note compressed entries unpack into an arena
+
+enum Archive_Compression {
+	ARCHIVE_COMPRESSION_NONE,
+	ARCHIVE_COMPRESSION_LZ4,
+};
+
+// @note the header is followed by entries sorted by `hash`, then by names,
+// then by blobs; each blob is aligned and followed by a zero
+struct Archive_Header {
+	u32 magic;
+	u32 version;
+	u32 entries_count;
+	u32 names_size;
+};
+
+struct Archive_Entry {
+	u64 hash; // @note `hash64_fnv1` of the name
+	u64 offset;
+	u64 size;
+	u64 size_packed;
+	u32 name_offset;
+	u16 name_length;
+	u16 compression;
+};
+
+struct Archive_Source {
+	char const *    name;
+	struct Array_U8 data;
+	bool            compress; // @note stays raw unless it shrinks by an eighth
+};
+
+struct Archive {
+	struct Array_U8 view;
+	struct Archive_Entry const * entries;
+	u32          entries_count;
+	char const * names;
+};
+
+struct Array_U8 archive_pack(struct Memory_Arena * arena, u32 count, struct Archive_Source const * sources);
+
+// @note maps the file; empty for missing or malformed ones
+struct Archive archive_init(char const * name);
+void archive_free(struct Archive * inst);
+
+struct Archive_Entry const * archive_find(struct Archive const * inst, str8 name);
+
+// @note a slice of the view for raw entries, otherwise unpacked into `arena`; empty if it fails to unpack
+struct Array_U8 archive_read(struct Archive const * inst, struct Archive_Entry const * entry, struct Memory_Arena * arena);
+
+// ---- ---- ---- ----
+// virtual file system
+// ---- ---- ---- ----
+
+#define VFS_ROOTS_MAX     4
+#define VFS_OVERRIDES_MAX 64
+
+struct VFS_IInfo {
+	char const * archive;
+	u32          roots_count;
+	char const * roots[VFS_ROOTS_MAX]; // @note for loose files, searched in order
+};
+
+void vfs_init(struct VFS_IInfo info);
+void vfs_free(void);
+
+// @note looks up the archive, then the roots, then the name as is;
+// zero-terminated unless empty, packed data lives until `vfs_free`
+struct Array_U8 vfs_read(struct Memory_Arena * arena, char const * name);
+
+// @note same as `vfs_read` per name, but the loose files are read all at once; missing ones are empty
+void vfs_read_batch(struct Memory_Arena * arena, u32 count, char const * const * names, struct Array_U8 * out);
+
+// @note same lookup as `vfs_read`; packed entries are views of the archive, unless compressed,
+// then they are unpacked into `arena` first
+struct File_Stream vfs_stream(struct Memory_Arena * arena, char const * name);
+
+// @note asks the system to fetch the files in advance, so that later reads find them cached
+void vfs_prefetch(u32 count, char const * const * names);
+
+// @note serves the name from the roots from now on, as the loose file got newer than the packed one;
+//       does nothing if there's no loose file
+void vfs_invalidate(str8 name);
+
+// @note zero for packed and missing files
+u64 vfs_get_write_nanos(char const * name);
+
+// ---- ---- ---- ----
+// asset cache
+// ---- ---- ---- ----
+
+#define ASSET_CACHE_MAGIC 0x43414b55 // "UKAC"
+
+struct Asset_Cache_IInfo {
+	char const * path; // @note a directory, created on demand; `NULL` disables the cache
+};
+
+void asset_cache_init(struct Asset_Cache_IInfo info);
+void asset_cache_free(void); // @note logs hits and misses
+
+// @note keys processed data by the source contents, its write time and the loader,
+// so editing a source or bumping a `version` leaves older entries unreachable
+// consumes `source` to the end
+u64 asset_cache_get_key(char const * loader, u32 version, char const * name, struct File_Stream * source);
+
+// @note empty on a miss; entries are published atomically
+struct Array_U8 asset_cache_read(struct Memory_Arena * arena, u64 key);
+void asset_cache_write(u64 key, struct Array_U8 data);
+
 // ---- ---- ---- ----
 // formatting
 // ---- ---- ---- ----
@@ -738,6 +1192,18 @@ uint32_t fmt_print(char * fmt, ...);
 AttrPrint(2, 3)
 uint32_t fmt_buffer(char * out_buffer, char * fmt, ...);
 
+// @note zero-terminated unless `capacity` is zero; returns the full length,
+// so the output got truncated if it's `capacity` or more
+AttrPrint(3, 4)
+uint32_t fmt_buffer_n(char * out_buffer, size_t capacity, char * fmt, ...);
+
+// @note appends to `inst` in place if it ends at the arena top, otherwise moves it there first
+AttrPrint(3, 4)
+uint32_t fmt_arena(struct Memory_Arena * arena, str8 * inst, char * fmt, ...);
+
+AttrPrint(2, 3)
+str8 str8_fmt(struct Memory_Arena * arena, char * fmt, ...);
+
 // ---- ---- ---- ----
 // images
 // ---- ---- ---- ----
@@ -750,6 +1216,7 @@ struct Resource_Image {
 };
 
 struct Resource_Image resource_image_init(arr8 const file);
+struct Resource_Image resource_image_init_stream(struct File_Stream * stream);
 void resource_image_free(struct Resource_Image * inst);
 
 // ---- ---- ---- ----
@@ -762,15 +1229,128 @@ struct RMVertex {
 	vec3 normal;
 };
 
-struct Resource_Model;
+// @note `position` is UNORM16 within the mesh bounds, `w` is padding;
+// `texture` is half precision, `normal` is octahedral SNORM16
+struct RMVertex_Packed {
+	u16 position[4];
+	f16 texture[2];
+	s16 normal[2];
+};
+
+// @note zero-based attribute indices, `-1` if absent
+struct RMCorner {
+	s32 position;
+	s32 texture;
+	s32 normal;
+};
+
+// @note attributes as listed by the file; polygons are fanned into triangles, three corners each
+struct Resource_Model {
+	u32 positions_count; vec3 * positions;
+	u32 textures_count;  vec2 * textures;
+	u32 normals_count;   vec3 * normals;
+	u32 corners_count;   struct RMCorner * corners;
+};
+
 struct Resource_Model * resource_model_init(char const * name);
 void resource_model_free(struct Resource_Model * inst);
 
+// @note parses Wavefront OBJ text, large ones in parallel chunks; `v`, `vt`, `vn` and `f` are read,
+// other statements are skipped; negative indices are relative to the attributes preceding them
+struct Resource_Model * resource_model_init_obj(arr8 const file);
+
+#define RMINDEX16_VERTICES_MAX 0x10000
+
+// @note indices are `u16` while vertices fit them, `u32` otherwise; `out_index_size` is in bytes;
+// an empty model yields no vertices and no indices
 void resource_model_dump_vertices(struct Resource_Model * inst, struct Memory_Arena * scratch,
 	struct RMVertex ** out_vertices, u32 * out_vertices_count,
-	u16            ** out_indices,  u16 * out_indices_count
+	void           ** out_indices,  u32 * out_indices_count, u32 * out_index_size
+);
+
+// @note positions decode as `out_offset + position * out_scale`
+void resource_model_pack_vertices(u32 count, struct RMVertex const * source, struct RMVertex_Packed * target,
+	vec3 * out_offset, vec3 * out_scale
 );
 
+// ---- ---- ---- ----
+// transform hierarchy
+// ---- ---- ---- ----
+
+#define TRANSFORM_ROOT (~(u32)0)
+
+// @note locals are stored as a structure of arrays; a parent always precedes its children,
+// so world matrices are resolved in one linear pass; only dirty nodes and their subtrees
+// are recomputed, large hierarchies split root trees across `workers_run`
+struct Transform_Hierarchy {
+	u32 capacity, count;
+	u32  * parents;
+	vec3 * offsets;
+	quat * rotations;
+	vec3 * scales;
+	mat4 * worlds;
+	u8   * dirty;
+	u32 dirty_min;
+	// -- threading, rebuilt on topology changes
+	bool   partition_dirty;
+	u32    partition_workers;
+	u32    partition_offsets[WORKERS_MAX + 1];
+	u32  * partition;
+};
+
+struct Transform_Hierarchy transform_hierarchy_init(void);
+void transform_hierarchy_free(struct Transform_Hierarchy * inst);
+
+// @note `parent` is either `TRANSFORM_ROOT` or an existing index, returns the new node index
+u32 transform_hierarchy_push(struct Transform_Hierarchy * inst, u32 parent, vec3 offset, quat rotation, vec3 scale);
+void transform_hierarchy_set(struct Transform_Hierarchy * inst, u32 index, vec3 offset, quat rotation, vec3 scale);
+
+void transform_hierarchy_update(struct Transform_Hierarchy * inst);
+
+// ---- ---- ---- ----
+// bounding volume hierarchy
+// ---- ---- ---- ----
+
+struct BVH_IInfo {
+	vec3 const * positions;
+	size_t stride; // @note in bytes
+	u32 indices_count;
+	u32 index_size; // @note in bytes, `u16` or `u32`
+	void const * indices;
+};
+
+// @note children of a branch are adjacent, so a single `offset` addresses both
+struct BVH_Node {
+	aabb3 bounds;
+	u32 offset; // @note the first child for branches, the first triangle for leaves
+	u32 count;  // @note zero for branches
+};
+
+// @note a binned SAH tree over a triangle list in a flat node array; triangles are
+// reordered into leaves and kept as `{v0, v1 - v0, v2 - v0}` structure of arrays,
+// each one `triangles_stride` long; large meshes build subtrees in parallel
+struct BVH {
+	struct BVH_Node * nodes;
+	u32 nodes_count;
+	u32 triangles_count, triangles_stride;
+	u32 * triangles; // @note source triangle indices, in leaf order
+	f32 * data;
+};
+
+struct BVH_Hit {
+	f32  distance; // @note in `direction` units
+	u32  triangle;
+	vec2 barycentric;
+};
+
+struct BVH bvh_init(struct BVH_IInfo info);
+void bvh_free(struct BVH * inst);
+
+// @note closest hit within `max_distance`, triangles are double-sided
+bool bvh_raycast(struct BVH const * inst, ray3 ray, f32 max_distance, struct BVH_Hit * out_hit);
+// @note any hit within `max_distance`, for visibility queries
+bool bvh_occluded(struct BVH const * inst, ray3 ray, f32 max_distance);
+
 // ---- ---- ---- ----
 // debugging
 // ---- ---- ---- ----
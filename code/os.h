@@ -6,6 +6,7 @@
 AttrGlobal() AttrExternal()
 struct OS_Info {
 	size_t page_size;
+	u32    processor_count;
 } g_os_info;
 
 struct OS_IInfo {
@@ -38,9 +39,25 @@ void * os_vulkan_create_surface(void * instance, void const * allocator);
 // file
 // ---- ---- ---- ----
 
+enum OS_File_Mode {
+	OS_FILE_MODE_READ,   // @note existing files only
+	OS_FILE_MODE_WRITE,  // @note creates or truncates
+	OS_FILE_MODE_APPEND, // @note creates or keeps
+};
+
+enum OS_File_Access {
+	OS_FILE_ACCESS_NORMAL,
+	OS_FILE_ACCESS_SEQUENTIAL,
+	OS_FILE_ACCESS_RANDOM,
+};
+
 struct OS_File;
 struct OS_File_IInfo {
-	char const * name;
+	char const *        name;
+	enum OS_File_Mode   mode;
+	bool                async;  // @note required by `os_file_queue_submit`
+	bool                direct; // @note bypasses the system cache, offsets, sizes and buffers are `page_size`-aligned
+	enum OS_File_Access access; // @note a caching hint
 };
 
 struct OS_File * os_file_init(struct OS_File_IInfo info);
@@ -51,6 +68,94 @@ u64 os_file_get_write_nanos(struct OS_File const * inst);
 
 u64 os_file_read(struct OS_File const * inst, u64 offset_min, u64 offset_max, void * buffer);
 
+// @note asks the system to cache the range in advance
+void os_file_prefetch(struct OS_File const * inst, u64 offset, u64 size);
+
+u64 os_file_write(struct OS_File * inst, u64 offset, u64 size, void const * buffer);
+u64 os_file_append(struct OS_File * inst, u64 size, void const * buffer);
+
+void os_file_set_size(struct OS_File * inst, u64 size);
+void os_file_flush(struct OS_File * inst); // @note down to the storage
+
+// @note replaces `target` atomically, if present
+bool os_file_replace(char const * source, char const * target);
+bool os_file_delete(char const * name);
+
+// @note succeeds if the directory is present already
+bool os_directory_create(char const * name);
+
+// @note a read-only view of the whole file, `NULL` for empty ones; it outlives the file,
+// `read_ahead` asks the system to fetch the pages in advance
+void const * os_file_map(struct OS_File const * inst, bool read_ahead);
+void os_file_unmap(void const * buffer, u64 size);
+
+// ---- ---- ---- ----
+// file: queue
+// ---- ---- ---- ----
+
+struct OS_File_Queue;
+struct OS_File_Queue_IInfo {
+	u32 capacity; // @note reads in flight
+};
+
+struct OS_File_Request {
+	struct OS_File * file;
+	u64    offset;
+	u64    size;
+	void * buffer;
+	void * context;
+};
+
+struct OS_File_Completion {
+	void * context;
+	u64    size; // @note less than requested at the end of file
+	bool   ok;
+};
+
+// @note a file serves a single queue during its lifetime
+struct OS_File_Queue * os_file_queue_init(struct OS_File_Queue_IInfo info);
+void os_file_queue_free(struct OS_File_Queue * inst);
+
+u32 os_file_queue_get_pending(struct OS_File_Queue const * inst);
+
+// @note `false` when the queue is at capacity; the buffer should stay intact until completion
+bool os_file_queue_submit(struct OS_File_Queue * inst, struct OS_File_Request request);
+
+// @note `poll` returns immediately, `wait` blocks until at least one read completes,
+// unless nothing is pending
+u32 os_file_queue_poll(struct OS_File_Queue * inst, u32 capacity, struct OS_File_Completion * buffer);
+u32 os_file_queue_wait(struct OS_File_Queue * inst, u32 capacity, struct OS_File_Completion * buffer);
+
+// ---- ---- ---- ----
+// file: watch
+// ---- ---- ---- ----
+
+enum OS_Watch_Action {
+	OS_WATCH_ACTION_NONE, // @note events were lost, anything might have changed
+	OS_WATCH_ACTION_ADDED,
+	OS_WATCH_ACTION_REMOVED,
+	OS_WATCH_ACTION_MODIFIED,
+	OS_WATCH_ACTION_RENAMED_FROM,
+	OS_WATCH_ACTION_RENAMED_TO,
+};
+
+struct OS_Watch_Event {
+	enum OS_Watch_Action action;
+	str8 name; // @note relative to the directory, with `/` separators
+};
+
+struct OS_Watch;
+struct OS_Watch_IInfo {
+	char const * path; // @note a directory
+	bool         recursive;
+};
+
+struct OS_Watch * os_watch_init(struct OS_Watch_IInfo info);
+void os_watch_free(struct OS_Watch * inst);
+
+// @note returns immediately with the changes since the previous call, allocated from `arena`
+u32 os_watch_poll(struct OS_Watch * inst, struct Memory_Arena * arena, struct OS_Watch_Event ** out_events);
+
 // ---- ---- ---- ----
 // time
 // ---- ---- ---- ----
@@ -73,6 +178,9 @@ void   os_memory_release(void * ptr, size_t size);
 void   os_memory_commit(void * ptr, size_t size);
 void   os_memory_decommit(void * ptr, size_t size);
 
+// @note asks the system to page in a range, for example of a file view
+void   os_memory_prefetch(void const * ptr, size_t size);
+
 // ---- ---- ---- ----
 // shared library
 // ---- ---- ---- ----
@@ -96,4 +204,24 @@ void os_thread_free(struct OS_Thread * inst);
 
 void os_thread_join(struct OS_Thread * inst);
 
+// ---- ---- ---- ----
+// synchronization
+// ---- ---- ---- ----
+
+struct OS_Semaphore;
+struct OS_Semaphore_IInfo {
+	u32 count;
+	u32 limit;
+};
+
+struct OS_Semaphore * os_semaphore_init(struct OS_Semaphore_IInfo info);
+void os_semaphore_free(struct OS_Semaphore * inst);
+
+void os_semaphore_signal(struct OS_Semaphore * inst, u32 count);
+void os_semaphore_wait(struct OS_Semaphore * inst);
+
+// @note full barriers, return the new value
+s32 os_atomic_add(s32 volatile * target, s32 value);
+s32 os_atomic_set(s32 volatile * target, s32 value);
+
 #endif
@@ -2,6 +2,7 @@
 #include <Windows.h>
 // #include <Windowsx.h> // @note GET_X_LPARAM GET_Y_LPARAM
 #include <signal.h>
+#include <string.h>
 
 #include "base.h"
 #include "windows_resources.h"
@@ -141,6 +142,8 @@ struct OS {
 	// timer
 	LARGE_INTEGER timer_frequency;
 	LARGE_INTEGER timer_initial;
+	// file views start at multiples of it
+	DWORD allocation_granularity;
 	//
 	bool quit;
 	// move window
@@ -460,8 +463,10 @@ void os_init(struct OS_IInfo info) {
 	SYSTEM_INFO system_info;
 	GetSystemInfo(&system_info);
 	g_os_info = (struct OS_Info){
-		.page_size = system_info.dwPageSize,
+		.page_size       = system_info.dwPageSize,
+		.processor_count = system_info.dwNumberOfProcessors,
 	};
+	fl_os.allocation_granularity = system_info.dwAllocationGranularity;
 
 	str8 const processor_arch_text = os_to_string_for_processor_architecture(system_info.wProcessorArchitecture);
 	str8 const processor_type_text = os_to_string_for_processor_type(system_info.dwProcessorType);
@@ -587,10 +592,32 @@ bool os_exit(int code) {
 struct OS_File {
 	struct OS_File_IInfo info;
 	HANDLE handle;
+	HANDLE port; // @note of an `OS_File_Queue`
 };
 
 struct OS_File * os_file_init(struct OS_File_IInfo info) {
-	HANDLE const handle = CreateFileA(info.name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	// @note names are UTF-8, while "wide" Windows API is UTF-16
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+	str16 const name = str16_from_str8(scratch, (str8){
+		.count = strlen(info.name),
+		.buffer = (u8 *)info.name,
+	});
+	DWORD const flags = FILE_ATTRIBUTE_NORMAL
+		| (info.async  ? FILE_FLAG_OVERLAPPED    : 0)
+		| (info.direct ? FILE_FLAG_NO_BUFFERING  : 0)
+		| (info.access == OS_FILE_ACCESS_SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : 0)
+		| (info.access == OS_FILE_ACCESS_RANDOM     ? FILE_FLAG_RANDOM_ACCESS   : 0);
+	DWORD access = GENERIC_READ, creation = OPEN_EXISTING;
+	switch (info.mode) {
+		case OS_FILE_MODE_READ:   access = GENERIC_READ;  creation = OPEN_EXISTING; break;
+		case OS_FILE_MODE_WRITE:  access = GENERIC_WRITE; creation = CREATE_ALWAYS; break;
+		case OS_FILE_MODE_APPEND: access = GENERIC_WRITE; creation = OPEN_ALWAYS;   break;
+	}
+	HANDLE const handle = name.buffer != NULL
+		? CreateFileW((wchar_t const *)name.buffer, access, FILE_SHARE_READ, NULL, creation, flags, NULL)
+		: INVALID_HANDLE_VALUE;
+	memory_arena_set_position(scratch, scratch_position);
 	if (handle == INVALID_HANDLE_VALUE)
 		return NULL;
 	struct OS_File * ret = os_memory_heap(NULL, sizeof(*ret));
@@ -598,7 +625,7 @@ struct OS_File * os_file_init(struct OS_File_IInfo info) {
 	ret->handle = handle;
 	return ret;
 	// @info win32 file open
-	// https://learn.microsoft.com/windows/win32/api/fileapi/nf-fileapi-createfilea
+	// https://learn.microsoft.com/windows/win32/api/fileapi/nf-fileapi-createfilew
 }
 
 void os_file_free(struct OS_File * inst) {
@@ -638,19 +665,27 @@ u64 os_file_get_write_nanos(struct OS_File const * inst) {
 
 u64 os_file_read(struct OS_File const * inst, u64 offset_min, u64 offset_max, void * buffer) {
 	AttrFuncLocal() u64 const chunk_limit = ~(DWORD)0;
+	// @note an async file waits on its own event, the low bit of which
+	// keeps the completion away from the queue port
+	HANDLE const event = inst->info.async ? CreateEventW(NULL, TRUE, FALSE, NULL) : NULL;
+	Assert(event != NULL || !inst->info.async, "[OS] `CreateEventW` failed\n");
 	u64 ret = 0;
 	for (u64 offset = offset_min; offset < offset_max; (void)0) {
 		OVERLAPPED overlapped_offset = {
 			.Offset     = (offset & 0x00000000ffffffffull),
 			.OffsetHigh = (offset & 0xffffffff00000000ull) >> 32,
+			.hEvent     = event != NULL ? (HANDLE)((ULONG_PTR)event | 1) : NULL,
 		};
-		DWORD received_size;
+		DWORD received_size = 0;
 		DWORD const requested_size = (DWORD)min_u64(offset_max - offset, chunk_limit);
 
-		// @note for synchronous reads only (without `FILE_FLAG_OVERLAPPED` flag)
-		// otherwise if `ok == FALSE` and `GetLastError() == ERROR_IO_PENDING`
-		// overlapped offset should be kept intact until the response
-		BOOL const ok = ReadFile(inst->handle, (u8*)buffer + ret, requested_size, &received_size, &overlapped_offset);
+		// @note overlapped offset should be kept intact until the response
+		BOOL ok = ReadFile(inst->handle, (u8*)buffer + ret, requested_size, &received_size, &overlapped_offset);
+		if (ok == FALSE && GetLastError() == ERROR_IO_PENDING)
+			ok = GetOverlappedResult(inst->handle, &overlapped_offset, &received_size, TRUE);
+		if (ok == FALSE && GetLastError() == ERROR_HANDLE_EOF) {
+			ok = TRUE; received_size = 0;
+		}
 		Assert(ok == TRUE, "[OS] `ReadFile` failed\n");
 
 		offset += received_size;
@@ -658,9 +693,451 @@ u64 os_file_read(struct OS_File const * inst, u64 offset_min, u64 offset_max, vo
 		if (received_size < requested_size)
 			break;
 	}
+	if (event != NULL) {
+		BOOL const ok = CloseHandle(event);
+		Assert(ok == TRUE, "[OS] `CloseHandle` failed\n");
+	}
 	return ret;
 	// @info win32 file read
 	// https://learn.microsoft.com/windows/win32/api/fileapi/nf-fileapi-readfile
+	// https://learn.microsoft.com/windows/win32/api/ioapiset/nf-ioapiset-getoverlappedresult
+}
+
+void os_file_prefetch(struct OS_File const * inst, u64 offset, u64 size) {
+	u64 const file_size = os_file_get_size(inst);
+	if (offset >= file_size || size == 0)
+		return;
+	size = min_u64(size, file_size - offset);
+
+	// @note a transient view brings the pages into the system cache
+	// and leaves them there after it's gone
+	u64 const base = offset - offset % fl_os.allocation_granularity;
+	SIZE_T const view_size = (SIZE_T)(offset - base + size);
+	HANDLE const mapping = CreateFileMappingW(inst->handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+		return;
+	void * view = MapViewOfFile(mapping, FILE_MAP_READ,
+		(DWORD)((base & 0xffffffff00000000ull) >> 32),
+		(DWORD)((base & 0x00000000ffffffffull)),
+		view_size
+	);
+	if (view != NULL) {
+		os_memory_prefetch(view, view_size);
+		BOOL const ok = UnmapViewOfFile(view);
+		Assert(ok == TRUE, "[OS] `UnmapViewOfFile` failed\n");
+	}
+	BOOL const ok = CloseHandle(mapping);
+	Assert(ok == TRUE, "[OS] `CloseHandle` failed\n");
+}
+
+AttrFileLocal()
+u64 os_file_write_at(struct OS_File * inst, u64 offset, bool at_end, u64 size, void const * buffer) {
+	AttrFuncLocal() u64 const chunk_limit = ~(DWORD)0 & ~(u64)0xffff; // @note keeps `direct` chunks aligned
+	AssertF(!inst->info.direct || (offset % g_os_info.page_size == 0 && size % g_os_info.page_size == 0
+		&& (size_t)buffer % g_os_info.page_size == 0), "[OS] unaligned direct write %llu / %llu\n", offset, size);
+	// @note an async file waits on its own event, the low bit of which
+	// keeps the completion away from the queue port
+	HANDLE const event = inst->info.async ? CreateEventW(NULL, TRUE, FALSE, NULL) : NULL;
+	Assert(event != NULL || !inst->info.async, "[OS] `CreateEventW` failed\n");
+	u64 ret = 0;
+	while (ret < size) {
+		u64 const position = offset + ret;
+		// @note all ones write to the end of the file
+		OVERLAPPED overlapped_offset = {
+			.Offset     = at_end ? 0xffffffff : (DWORD)((position & 0x00000000ffffffffull)),
+			.OffsetHigh = at_end ? 0xffffffff : (DWORD)((position & 0xffffffff00000000ull) >> 32),
+			.hEvent     = event != NULL ? (HANDLE)((ULONG_PTR)event | 1) : NULL,
+		};
+		DWORD written_size = 0;
+		DWORD const requested_size = (DWORD)min_u64(size - ret, chunk_limit);
+
+		BOOL ok = WriteFile(inst->handle, (u8 const *)buffer + ret, requested_size, &written_size, &overlapped_offset);
+		if (ok == FALSE && GetLastError() == ERROR_IO_PENDING)
+			ok = GetOverlappedResult(inst->handle, &overlapped_offset, &written_size, TRUE);
+		if (ok == FALSE || written_size == 0)
+			break;
+		ret += written_size;
+	}
+	if (event != NULL) {
+		BOOL const ok = CloseHandle(event);
+		Assert(ok == TRUE, "[OS] `CloseHandle` failed\n");
+	}
+	return ret;
+	// @info win32 file write
+	// https://learn.microsoft.com/windows/win32/api/fileapi/nf-fileapi-writefile
+	// https://learn.microsoft.com/windows/win32/fileio/file-buffering
+}
+
+u64 os_file_write(struct OS_File * inst, u64 offset, u64 size, void const * buffer) {
+	return os_file_write_at(inst, offset, false, size, buffer);
+}
+
+u64 os_file_append(struct OS_File * inst, u64 size, void const * buffer) {
+	return os_file_write_at(inst, 0, true, size, buffer);
+}
+
+void os_file_set_size(struct OS_File * inst, u64 size) {
+	FILE_END_OF_FILE_INFO info = {.EndOfFile.QuadPart = (LONGLONG)size};
+	BOOL const ok = SetFileInformationByHandle(inst->handle, FileEndOfFileInfo, &info, sizeof(info));
+	Assert(ok == TRUE, "[OS] `SetFileInformationByHandle` failed\n");
+	// @info win32 file size
+	// https://learn.microsoft.com/windows/win32/api/fileapi/nf-fileapi-setfileinformationbyhandle
+}
+
+void os_file_flush(struct OS_File * inst) {
+	BOOL const ok = FlushFileBuffers(inst->handle);
+	Assert(ok == TRUE, "[OS] `FlushFileBuffers` failed\n");
+	// @info win32 file flush
+	// https://learn.microsoft.com/windows/win32/api/fileapi/nf-fileapi-flushfilebuffers
+}
+
+bool os_file_replace(char const * source, char const * target) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+	str16 const source_name = str16_from_str8(scratch, (str8){.count = strlen(source), .buffer = (u8 *)source});
+	str16 const target_name = str16_from_str8(scratch, (str8){.count = strlen(target), .buffer = (u8 *)target});
+	BOOL const ok = source_name.buffer != NULL && target_name.buffer != NULL
+		&& MoveFileExW(
+			(wchar_t const *)source_name.buffer, (wchar_t const *)target_name.buffer,
+			MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH
+		);
+	memory_arena_set_position(scratch, scratch_position);
+	return ok == TRUE;
+	// @info win32 file move
+	// https://learn.microsoft.com/windows/win32/api/winbase/nf-winbase-movefileexw
+}
+
+bool os_file_delete(char const * name) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+	str16 const wide_name = str16_from_str8(scratch, (str8){.count = strlen(name), .buffer = (u8 *)name});
+	BOOL const ok = wide_name.buffer != NULL
+		&& DeleteFileW((wchar_t const *)wide_name.buffer);
+	memory_arena_set_position(scratch, scratch_position);
+	return ok == TRUE;
+	// @info win32 file delete
+	// https://learn.microsoft.com/windows/win32/api/fileapi/nf-fileapi-deletefilew
+}
+
+bool os_directory_create(char const * name) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+	str16 const wide_name = str16_from_str8(scratch, (str8){.count = strlen(name), .buffer = (u8 *)name});
+	BOOL const ok = wide_name.buffer != NULL
+		&& (CreateDirectoryW((wchar_t const *)wide_name.buffer, NULL) || GetLastError() == ERROR_ALREADY_EXISTS);
+	memory_arena_set_position(scratch, scratch_position);
+	return ok == TRUE;
+	// @info win32 directory create
+	// https://learn.microsoft.com/windows/win32/api/fileapi/nf-fileapi-createdirectoryw
+}
+
+void const * os_file_map(struct OS_File const * inst, bool read_ahead) {
+	u64 const size = os_file_get_size(inst);
+	if (size == 0)
+		return NULL;
+
+	HANDLE const mapping = CreateFileMappingW(inst->handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+		return NULL;
+	void * ret = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	// @note the view keeps the mapping object alive
+	BOOL const ok = CloseHandle(mapping);
+	Assert(ok == TRUE, "[OS] `CloseHandle` failed\n");
+
+	if (ret != NULL && read_ahead)
+		os_memory_prefetch(ret, (size_t)size);
+	return ret;
+	// @info win32 file mapping
+	// https://learn.microsoft.com/windows/win32/api/memoryapi/nf-memoryapi-createfilemappingw
+	// https://learn.microsoft.com/windows/win32/api/memoryapi/nf-memoryapi-mapviewoffile
+}
+
+void os_file_unmap(void const * buffer, u64 size) {
+	(void)size; // @note views are unmapped as a whole
+	BOOL const ok = UnmapViewOfFile(buffer);
+	Assert(ok == TRUE, "[OS] `UnmapViewOfFile` failed\n");
+	// @info win32 file unmapping
+	// https://learn.microsoft.com/windows/win32/api/memoryapi/nf-memoryapi-unmapviewoffile
+}
+
+// ---- ---- ---- ----
+// file: queue
+// ---- ---- ---- ----
+
+#define OS_STATUS_END_OF_FILE 0xc0000011 // @note `STATUS_END_OF_FILE` of <ntstatus.h>
+#define OS_FILE_QUEUE_BATCH 32
+
+struct OS_File_Slot {
+	OVERLAPPED overlapped; // @note first, completions point at it
+	void * context;
+	bool   failed;
+};
+
+struct OS_File_Queue {
+	struct OS_File_Queue_IInfo info;
+	HANDLE port;
+	u32 pending;
+	u32 free_count;
+	u32 * free;
+	struct OS_File_Slot * slots;
+};
+
+struct OS_File_Queue * os_file_queue_init(struct OS_File_Queue_IInfo info) {
+	Assert(info.capacity > 0, "[OS] queue capacity is zero\n");
+	HANDLE const port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+	Assert(port != NULL, "[OS] `CreateIoCompletionPort` failed\n");
+
+	struct OS_File_Queue * ret = os_memory_heap(NULL, sizeof(*ret)
+		+ sizeof(*ret->slots) * info.capacity
+		+ sizeof(*ret->free)  * info.capacity
+	);
+	*ret = (struct OS_File_Queue){
+		.info = info,
+		.port = port,
+		.free_count = info.capacity,
+	};
+	ret->slots = (void *)(ret + 1);
+	ret->free  = (void *)(ret->slots + info.capacity);
+	for (u32 i = 0; i < info.capacity; i++)
+		ret->free[i] = info.capacity - i - 1;
+	return ret;
+	// @info win32 completion ports
+	// https://learn.microsoft.com/windows/win32/fileio/i-o-completion-ports
+	// https://learn.microsoft.com/windows/win32/api/ioapiset/nf-ioapiset-createiocompletionport
+}
+
+void os_file_queue_free(struct OS_File_Queue * inst) {
+	struct OS_File_Completion discard[OS_FILE_QUEUE_BATCH];
+	while (inst->pending > 0)
+		os_file_queue_wait(inst, OS_FILE_QUEUE_BATCH, discard);
+	BOOL const ok = CloseHandle(inst->port);
+	Assert(ok == TRUE, "[OS] `CloseHandle` failed\n");
+	mem_zero(inst, sizeof(*inst));
+	os_memory_heap(inst, 0);
+}
+
+u32 os_file_queue_get_pending(struct OS_File_Queue const * inst) {
+	return inst->pending;
+}
+
+bool os_file_queue_submit(struct OS_File_Queue * inst, struct OS_File_Request request) {
+	if (inst->free_count == 0)
+		return false;
+
+	struct OS_File * file = request.file;
+	Assert(file->info.async, "[OS] file is not async\n");
+	AssertF(request.size <= ~(DWORD)0, "[OS] request is too large %llu\n", request.size);
+	if (file->port == NULL) {
+		file->port = CreateIoCompletionPort(file->handle, inst->port, 0, 0);
+		Assert(file->port == inst->port, "[OS] `CreateIoCompletionPort` failed\n");
+	}
+	Assert(file->port == inst->port, "[OS] file serves another queue\n");
+
+	struct OS_File_Slot * slot = inst->slots + inst->free[--inst->free_count];
+	*slot = (struct OS_File_Slot){
+		.overlapped = {
+			.Offset     = (request.offset & 0x00000000ffffffffull),
+			.OffsetHigh = (request.offset & 0xffffffff00000000ull) >> 32,
+		},
+		.context = request.context,
+	};
+	inst->pending++;
+
+	// @note a completion is queued even when the read finishes right away,
+	// but not when it fails to start
+	BOOL const ok = ReadFile(file->handle, request.buffer, (DWORD)request.size, NULL, &slot->overlapped);
+	DWORD const error = (ok == FALSE) ? GetLastError() : ERROR_SUCCESS;
+	if (error != ERROR_SUCCESS && error != ERROR_IO_PENDING) {
+		slot->failed = (error != ERROR_HANDLE_EOF);
+		slot->overlapped.Internal = 0;
+		BOOL const posted = PostQueuedCompletionStatus(inst->port, 0, 0, &slot->overlapped);
+		Assert(posted == TRUE, "[OS] `PostQueuedCompletionStatus` failed\n");
+	}
+	return true;
+	// @info win32 asynchronous file read
+	// https://learn.microsoft.com/windows/win32/fileio/synchronous-and-asynchronous-i-o
+	// https://learn.microsoft.com/windows/win32/api/ioapiset/nf-ioapiset-postqueuedcompletionstatus
+}
+
+AttrFileLocal()
+u32 os_file_queue_collect(struct OS_File_Queue * inst, u32 capacity, struct OS_File_Completion * buffer, DWORD timeout) {
+	u32 ret = 0;
+	while (ret < capacity && inst->pending > 0) {
+		OVERLAPPED_ENTRY entries[OS_FILE_QUEUE_BATCH];
+		ULONG const requested = min_u32(min_u32(capacity - ret, inst->pending), OS_FILE_QUEUE_BATCH);
+		ULONG received = 0;
+		if (!GetQueuedCompletionStatusEx(inst->port, entries, requested, &received, timeout, FALSE))
+			break; // @note `WAIT_TIMEOUT`
+		for (ULONG i = 0; i < received; i++) {
+			struct OS_File_Slot * slot = (void *)entries[i].lpOverlapped;
+			DWORD const status = (DWORD)slot->overlapped.Internal;
+			buffer[ret++] = (struct OS_File_Completion){
+				.context = slot->context,
+				.size    = entries[i].dwNumberOfBytesTransferred,
+				.ok      = !slot->failed && (status == 0 || status == OS_STATUS_END_OF_FILE),
+			};
+			inst->free[inst->free_count++] = (u32)(slot - inst->slots);
+			inst->pending--;
+		}
+		timeout = 0;
+	}
+	return ret;
+	// @info win32 completion dequeue
+	// https://learn.microsoft.com/windows/win32/api/ioapiset/nf-ioapiset-getqueuedcompletionstatusex
+}
+
+u32 os_file_queue_poll(struct OS_File_Queue * inst, u32 capacity, struct OS_File_Completion * buffer) {
+	return os_file_queue_collect(inst, capacity, buffer, 0);
+}
+
+u32 os_file_queue_wait(struct OS_File_Queue * inst, u32 capacity, struct OS_File_Completion * buffer) {
+	return os_file_queue_collect(inst, capacity, buffer, INFINITE);
+}
+
+// ---- ---- ---- ----
+// file: watch
+// ---- ---- ---- ----
+
+#define OS_WATCH_BUFFER_SIZE (64 * 1024) // @note the limit for network drives
+
+struct OS_Watch {
+	struct OS_Watch_IInfo info;
+	HANDLE     handle;
+	OVERLAPPED overlapped;
+	bool       active;
+	DWORD      buffer[OS_WATCH_BUFFER_SIZE / sizeof(DWORD)]; // @note DWORD-aligned
+};
+
+AttrFileLocal()
+bool os_watch_issue(struct OS_Watch * inst) {
+	DWORD const filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME
+		| FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+	inst->active = ReadDirectoryChangesW(
+		inst->handle, inst->buffer, sizeof(inst->buffer),
+		inst->info.recursive, filter, NULL, &inst->overlapped, NULL
+	);
+	return inst->active;
+	// @info win32 directory changes
+	// https://learn.microsoft.com/windows/win32/api/winbase/nf-winbase-readdirectorychangesw
+}
+
+AttrFileLocal()
+enum OS_Watch_Action os_watch_map_action(DWORD value) {
+	switch (value) {
+		case FILE_ACTION_ADDED:            return OS_WATCH_ACTION_ADDED;
+		case FILE_ACTION_REMOVED:          return OS_WATCH_ACTION_REMOVED;
+		case FILE_ACTION_MODIFIED:         return OS_WATCH_ACTION_MODIFIED;
+		case FILE_ACTION_RENAMED_OLD_NAME: return OS_WATCH_ACTION_RENAMED_FROM;
+		case FILE_ACTION_RENAMED_NEW_NAME: return OS_WATCH_ACTION_RENAMED_TO;
+		default: return OS_WATCH_ACTION_NONE;
+	}
+}
+
+struct OS_Watch * os_watch_init(struct OS_Watch_IInfo info) {
+	// @note names are UTF-8, while "wide" Windows API is UTF-16
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	size_t const scratch_position = memory_arena_get_position(scratch);
+	str16 const name = str16_from_str8(scratch, (str8){
+		.count = strlen(info.path),
+		.buffer = (u8 *)info.path,
+	});
+	HANDLE const handle = name.buffer != NULL
+		? CreateFileW(
+			(wchar_t const *)name.buffer, FILE_LIST_DIRECTORY,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+			FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL
+		)
+		: INVALID_HANDLE_VALUE;
+	memory_arena_set_position(scratch, scratch_position);
+	if (handle == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	HANDLE const event = CreateEventW(NULL, TRUE, FALSE, NULL);
+	Assert(event != NULL, "[OS] `CreateEventW` failed\n");
+
+	struct OS_Watch * ret = os_memory_heap(NULL, sizeof(*ret));
+	mem_zero(ret, sizeof(*ret));
+	ret->info = info;
+	ret->handle = handle;
+	ret->overlapped.hEvent = event;
+	if (!os_watch_issue(ret)) {
+		os_watch_free(ret);
+		return NULL;
+	}
+	return ret;
+	// @info win32 directory handle
+	// https://learn.microsoft.com/windows/win32/fileio/obtaining-a-handle-to-a-directory
+}
+
+void os_watch_free(struct OS_Watch * inst) {
+	if (inst->active) {
+		DWORD received;
+		CancelIoEx(inst->handle, &inst->overlapped);
+		GetOverlappedResult(inst->handle, &inst->overlapped, &received, TRUE);
+	}
+	BOOL const ok_event = CloseHandle(inst->overlapped.hEvent);
+	Assert(ok_event == TRUE, "[OS] `CloseHandle` failed\n");
+	BOOL const ok_handle = CloseHandle(inst->handle);
+	Assert(ok_handle == TRUE, "[OS] `CloseHandle` failed\n");
+	mem_zero(inst, sizeof(*inst));
+	os_memory_heap(inst, 0);
+	// @info win32 cancel
+	// https://learn.microsoft.com/windows/win32/fileio/cancelioex-func
+}
+
+u32 os_watch_poll(struct OS_Watch * inst, struct Memory_Arena * arena, struct OS_Watch_Event ** out_events) {
+	*out_events = NULL;
+	if (!inst->active)
+		return 0;
+
+	// @note zero bytes mean the buffer has overflown
+	DWORD received = 0;
+	if (!GetOverlappedResult(inst->handle, &inst->overlapped, &received, FALSE)) {
+		if (GetLastError() == ERROR_IO_INCOMPLETE)
+			return 0;
+		received = 0;
+	}
+
+	u32 ret = 0;
+	for (DWORD offset = 0; received > 0; (void)0) {
+		FILE_NOTIFY_INFORMATION const * it = (void *)((u8 *)inst->buffer + offset);
+		ret++;
+		if (it->NextEntryOffset == 0)
+			break;
+		offset += it->NextEntryOffset;
+	}
+
+	if (received == 0) {
+		*out_events = MemoryArenaPushArray(arena, struct OS_Watch_Event, 1);
+		(*out_events)[0] = (struct OS_Watch_Event){.action = OS_WATCH_ACTION_NONE};
+		ret = 1;
+	}
+	else {
+		*out_events = MemoryArenaPushArray(arena, struct OS_Watch_Event, ret);
+		DWORD offset = 0;
+		for (u32 i = 0; i < ret; i++) {
+			FILE_NOTIFY_INFORMATION const * it = (void *)((u8 *)inst->buffer + offset);
+			str8 const name = str8_from_str16(arena, (str16){
+				.count  = it->FileNameLength / sizeof(WCHAR),
+				.buffer = (u16 *)it->FileName,
+			});
+			for (size_t c = 0; c < name.count; c++)
+				if (name.buffer[c] == '\\')
+					name.buffer[c] = '/';
+			(*out_events)[i] = (struct OS_Watch_Event){
+				.action = os_watch_map_action(it->Action),
+				.name   = name,
+			};
+			offset += it->NextEntryOffset;
+		}
+	}
+
+	// @note a watched directory that went away stops the watch
+	os_watch_issue(inst);
+	return ret;
+	// @info win32 notify information
+	// https://learn.microsoft.com/windows/win32/api/winnt/ns-winnt-file_notify_information
 }
 
 // ---- ---- ---- ----
@@ -773,6 +1250,19 @@ void os_memory_decommit(void * ptr, size_t size) {
 	// https://learn.microsoft.com/windows/win32/api/memoryapi/nf-memoryapi-virtualfree
 }
 
+void os_memory_prefetch(void const * ptr, size_t size) {
+	if (ptr == NULL || size == 0)
+		return;
+	WIN32_MEMORY_RANGE_ENTRY range = {
+		.VirtualAddress = (void *)ptr,
+		.NumberOfBytes  = size,
+	};
+	// @note merely a hint, failures are fine
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	// @info win32 prefetch
+	// https://learn.microsoft.com/windows/win32/api/memoryapi/nf-memoryapi-prefetchvirtualmemory
+}
+
 // ---- ---- ---- ----
 // shared library
 // ---- ---- ---- ----
@@ -837,6 +1327,56 @@ void os_thread_join(struct OS_Thread * inst) {
 	WaitForSingleObject(inst->handle, INFINITE);
 }
 
+// ---- ---- ---- ----
+// synchronization
+// ---- ---- ---- ----
+
+struct OS_Semaphore {
+	HANDLE handle;
+};
+
+struct OS_Semaphore * os_semaphore_init(struct OS_Semaphore_IInfo info) {
+	struct OS_Semaphore * ret = os_memory_heap(NULL, sizeof(*ret));
+	ret->handle = CreateSemaphoreW(NULL, (LONG)info.count, (LONG)info.limit, NULL);
+	Assert(ret->handle != NULL, "[OS] `CreateSemaphoreW` failed\n");
+	return ret;
+	// @info win32 semaphores
+	// https://learn.microsoft.com/windows/win32/api/synchapi/nf-synchapi-createsemaphorew
+}
+
+void os_semaphore_free(struct OS_Semaphore * inst) {
+	BOOL const ok = CloseHandle(inst->handle);
+	Assert(ok == TRUE, "[OS] `CloseHandle` failed\n");
+	mem_zero(inst, sizeof(*inst));
+	os_memory_heap(inst, 0);
+}
+
+void os_semaphore_signal(struct OS_Semaphore * inst, u32 count) {
+	if (count == 0)
+		return;
+	BOOL const ok = ReleaseSemaphore(inst->handle, (LONG)count, NULL);
+	AssertF(ok == TRUE, "[OS] `ReleaseSemaphore(%u)` failed\n", count);
+	// @info win32 semaphores
+	// https://learn.microsoft.com/windows/win32/api/synchapi/nf-synchapi-releasesemaphore
+}
+
+void os_semaphore_wait(struct OS_Semaphore * inst) {
+	WaitForSingleObject(inst->handle, INFINITE);
+}
+
+s32 os_atomic_add(s32 volatile * target, s32 value) {
+	return (s32)InterlockedAdd((LONG volatile *)target, (LONG)value);
+	// @info win32 interlocked
+	// https://learn.microsoft.com/windows/win32/api/winnt/nf-winnt-interlockedadd
+}
+
+s32 os_atomic_set(s32 volatile * target, s32 value) {
+	InterlockedExchange((LONG volatile *)target, (LONG)value);
+	return value;
+	// @info win32 interlocked
+	// https://learn.microsoft.com/windows/win32/api/winnt/nf-winnt-interlockedexchange
+}
+
 // ---- ---- ---- ----
 // internal
 // ---- ---- ---- ----
@@ -9,6 +9,10 @@ void rhi_free(void);
 void rhi_tick(void);
 
 void rhi_notify_surface_resized(void);
+void rhi_notify_asset_changed(str8 name);
+
+// @note names of the VFS assets the renderer depends on
+u32 rhi_get_assets(char const * const ** out_names);
 
 mat4 rhi_mat4_projection(
 	vec2 scale_xy, vec2 offset_xy,
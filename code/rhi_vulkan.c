@@ -152,13 +152,14 @@ str8 rhi_to_string_for_queue_flags(struct Memory_Arena * arena, VkQueueFlags fla
 		VK_QUEUE_OPTICAL_FLOW_BIT_NV,
 	};
 
-	AttrFuncLocal() size_t const capacity = ArrayCount(bits) * 16;
-	str8 ret = {.buffer = MemoryArenaPushArray(arena, u8, capacity)};
+	str8 ret = {0};
 	for (uint32_t i = 0; i < ArrayCount(bits); i++) {
 		if (flags & (VkQueueFlags)bits[i]) {
-			if (ret.count > 0)
-				str8_append(&ret, separator);
-			str8_append(&ret, rhi_to_string_for_queue(bits[i]));
+			str8 const prefix = ret.count > 0 ? separator : (str8){0};
+			str8 const text = rhi_to_string_for_queue(bits[i]);
+			fmt_arena(arena, &ret, "%.*s%.*s",
+				(int)prefix.count, prefix.buffer,
+				(int)text.count, text.buffer);
 		}
 	}
 	return ret;
@@ -335,6 +336,12 @@ VkFormat rhi_map_primitive_format_to_vector_format(enum VkFormat primitive, size
 			case 4: return VK_FORMAT_R16G16B16A16_SNORM;
 		} break;
 		// floating points
+		case VK_FORMAT_R16_SFLOAT: switch (count) {
+			case 1: return VK_FORMAT_R16_SFLOAT;
+			case 2: return VK_FORMAT_R16G16_SFLOAT;
+			case 3: return VK_FORMAT_R16G16B16_SFLOAT;
+			case 4: return VK_FORMAT_R16G16B16A16_SFLOAT;
+		} break;
 		case VK_FORMAT_R32_SFLOAT: switch (count) {
 			case 1: return VK_FORMAT_R32_SFLOAT;
 			case 2: return VK_FORMAT_R32G32_SFLOAT;
@@ -669,9 +676,18 @@ struct RHI_User_Data { // user data
 		VkDeviceSize index_offset;
 		VkIndexType index_type;
 		uint32_t    index_count;
+		mat4        dequantization;
+		aabb3       bounds;
 	} model;
 	// texture
 	struct RHI_Texture texture;
+	// hot reload
+	struct RHI_Reload {
+		u64  nanos; // @note applied once the files settle
+		bool shader;
+		bool texture;
+		bool model;
+	} reload;
 } fl_rhi_ud;
 
 AttrFileLocal()
@@ -2086,12 +2102,13 @@ void rhi_sampler_destroy(VkSampler sampler) {
 // ---- ---- ---- ----
 
 AttrFileLocal()
-VkShaderModule rhi_shader_module_create(char const * name) {
-	struct Memory_Arena * scratch = thread_ctx_get_scratch();
-	u64 const scratch_position = memory_arena_get_position(scratch);
-
-	arr8 const source = base_file_read(scratch, name);
-	VkShaderModule ret;
+VkShaderModule rhi_shader_module_create(char const * name, arr8 source) {
+	// @note packed blobs are aligned, as `pCode` wants at least 4 bytes
+	VkShaderModule ret = VK_NULL_HANDLE;
+	if (source.count == 0 || source.count % sizeof(u32) != 0) {
+		fmt_print("[RHI] shader \"%s\" is missing or malformed\n", name);
+		return ret;
+	}
 	vkCreateShaderModule(
 		fl_rhi_context.logical.handle,
 		&(VkShaderModuleCreateInfo){
@@ -2102,13 +2119,29 @@ VkShaderModule rhi_shader_module_create(char const * name) {
 		&fl_rhi_allocator,
 		&ret
 	);
-
-	memory_arena_set_position(scratch, scratch_position);
 	return ret;
 }
 
 AttrFileLocal()
-void rhi_shader_init(void) {
+struct RHI_Shader rhi_shader_init(void) {
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	u64 const scratch_position = memory_arena_get_position(scratch);
+
+	// @note the stages are read at once
+	AttrFuncLocal() char const * const names[] = {"shader.vert.spv", "shader.frag.spv"};
+	arr8 sources[ArrayCount(names)];
+	vfs_read_batch(scratch, (u32)ArrayCount(names), names, sources);
+	VkShaderModule const vertex   = rhi_shader_module_create(names[0], sources[0]);
+	VkShaderModule const fragment = rhi_shader_module_create(names[1], sources[1]);
+	memory_arena_set_position(scratch, scratch_position);
+
+	struct RHI_Shader ret = {0};
+	if (vertex == VK_NULL_HANDLE || fragment == VK_NULL_HANDLE) {
+		vkDestroyShaderModule(fl_rhi_context.logical.handle, vertex,   &fl_rhi_allocator);
+		vkDestroyShaderModule(fl_rhi_context.logical.handle, fragment, &fl_rhi_allocator);
+		return ret;
+	}
+
 	// @todo it seems the brunt of it can be automated via reflection of sorts
 	// -- create descriptors
 	vkCreateDescriptorPool(
@@ -2131,7 +2164,7 @@ void rhi_shader_init(void) {
 			.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
 		},
 		&fl_rhi_allocator,
-		&fl_rhi_ud.shader.descriptor.pool
+		&ret.descriptor.pool
 	);
 
 	vkCreateDescriptorSetLayout(
@@ -2154,7 +2187,7 @@ void rhi_shader_init(void) {
 			},
 		},
 		&fl_rhi_allocator,
-		&fl_rhi_ud.shader.descriptor.layout
+		&ret.descriptor.layout
 	);
 
 	// -- create pipeline
@@ -2162,23 +2195,23 @@ void rhi_shader_init(void) {
 		fl_rhi_context.logical.handle,
 		&(VkPipelineLayoutCreateInfo){
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-			.setLayoutCount = 1, .pSetLayouts = &fl_rhi_ud.shader.descriptor.layout,
+			.setLayoutCount = 1, .pSetLayouts = &ret.descriptor.layout,
 		},
 		&fl_rhi_allocator,
-		&fl_rhi_ud.shader.layout
+		&ret.layout
 	);
 
 	VkPipelineShaderStageCreateInfo const shader_stages[] = {
 		{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
 			.stage = VK_SHADER_STAGE_VERTEX_BIT,
-			.module = rhi_shader_module_create("data/shader.vert.spv"),
+			.module = vertex,
 			.pName = "main",
 		},
 		{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
 			.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
-			.module = rhi_shader_module_create("data/shader.frag.spv"),
+			.module = fragment,
 			.pName = "main",
 		},
 	};
@@ -2191,12 +2224,12 @@ void rhi_shader_init(void) {
 		// VK_DYNAMIC_STATE_DEPTH_COMPARE_OP,
 	};
 
-	vkCreateGraphicsPipelines(
+	VkResult const pipeline_result = vkCreateGraphicsPipelines(
 		fl_rhi_context.logical.handle,
 		VK_NULL_HANDLE,
 		1, &(VkGraphicsPipelineCreateInfo){
 			.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-			.layout = fl_rhi_ud.shader.layout,
+			.layout = ret.layout,
 			.renderPass = fl_rhi_context.render_pass,
 			.subpass = 0,
 			// stages
@@ -2207,7 +2240,7 @@ void rhi_shader_init(void) {
 				// binding
 				.vertexBindingDescriptionCount = 1, .pVertexBindingDescriptions = &(VkVertexInputBindingDescription){
 					.binding = 0,
-					.stride = sizeof(struct RMVertex),
+					.stride = sizeof(struct RMVertex_Packed),
 					.inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
 				},
 				// attributes
@@ -2215,20 +2248,20 @@ void rhi_shader_init(void) {
 					{
 						.binding = 0,
 						.location = 0,
-						.format = rhi_map_primitive_format_to_vector_format(VK_FORMAT_R32_SFLOAT, FieldSize(struct RMVertex, position) / sizeof(f32)),
-						.offset = offsetof(struct RMVertex, position),
+						.format = rhi_map_primitive_format_to_vector_format(VK_FORMAT_R16_UNORM, FieldCount(struct RMVertex_Packed, position)),
+						.offset = offsetof(struct RMVertex_Packed, position),
 					},
 					{
 						.binding = 0,
 						.location = 1,
-						.format = rhi_map_primitive_format_to_vector_format(VK_FORMAT_R32_SFLOAT, FieldSize(struct RMVertex, texture) / sizeof(f32)),
-						.offset = offsetof(struct RMVertex, texture),
+						.format = rhi_map_primitive_format_to_vector_format(VK_FORMAT_R16_SFLOAT, FieldCount(struct RMVertex_Packed, texture)),
+						.offset = offsetof(struct RMVertex_Packed, texture),
 					},
 					{
 						.binding = 0,
 						.location = 2,
-						.format = rhi_map_primitive_format_to_vector_format(VK_FORMAT_R32_SFLOAT, FieldSize(struct RMVertex, normal) / sizeof(f32)),
-						.offset = offsetof(struct RMVertex, normal),
+						.format = rhi_map_primitive_format_to_vector_format(VK_FORMAT_R16_SNORM, FieldCount(struct RMVertex_Packed, normal)),
+						.offset = offsetof(struct RMVertex_Packed, normal),
 					},
 				},
 			},
@@ -2294,21 +2327,30 @@ void rhi_shader_init(void) {
 			},
 		},
 		&fl_rhi_allocator,
-		&fl_rhi_ud.shader.handle
+		&ret.handle
 	);
 
 	for (uint32_t i = 0, count = ArrayCount(shader_stages); i < count; i++)
 		vkDestroyShaderModule(fl_rhi_context.logical.handle, shader_stages[i].module, &fl_rhi_allocator);
+
+	if (pipeline_result != VK_SUCCESS) {
+		fmt_print("[RHI] shader pipeline failed\n");
+		vkDestroyPipelineLayout(fl_rhi_context.logical.handle, ret.layout, &fl_rhi_allocator);
+		vkDestroyDescriptorPool(fl_rhi_context.logical.handle, ret.descriptor.pool, &fl_rhi_allocator);
+		vkDestroyDescriptorSetLayout(fl_rhi_context.logical.handle, ret.descriptor.layout, &fl_rhi_allocator);
+		return (struct RHI_Shader){0};
+	}
+	return ret;
 }
 
 AttrFileLocal()
-void rhi_shader_free(void) {
-	vkDestroyPipeline(fl_rhi_context.logical.handle, fl_rhi_ud.shader.handle, &fl_rhi_allocator);
-	vkDestroyPipelineLayout(fl_rhi_context.logical.handle, fl_rhi_ud.shader.layout, &fl_rhi_allocator);
+void rhi_shader_free(struct RHI_Shader shader) {
+	vkDestroyPipeline(fl_rhi_context.logical.handle, shader.handle, &fl_rhi_allocator);
+	vkDestroyPipelineLayout(fl_rhi_context.logical.handle, shader.layout, &fl_rhi_allocator);
 
-	// vkResetDescriptorPool(fl_rhi_context.device.handle, fl_rhi_ud.shader.descriptor.pool, 0);
-	vkDestroyDescriptorPool(fl_rhi_context.logical.handle, fl_rhi_ud.shader.descriptor.pool, &fl_rhi_allocator);
-	vkDestroyDescriptorSetLayout(fl_rhi_context.logical.handle, fl_rhi_ud.shader.descriptor.layout, &fl_rhi_allocator);
+	// vkResetDescriptorPool(fl_rhi_context.device.handle, shader.descriptor.pool, 0);
+	vkDestroyDescriptorPool(fl_rhi_context.logical.handle, shader.descriptor.pool, &fl_rhi_allocator);
+	vkDestroyDescriptorSetLayout(fl_rhi_context.logical.handle, shader.descriptor.layout, &fl_rhi_allocator);
 }
 
 // ---- ---- ---- ----
@@ -2326,29 +2368,30 @@ AssertAlign(struct UData, view,       ALIGN_MAT4);
 AssertAlign(struct UData, projection, ALIGN_MAT4);
 
 AttrFileLocal()
-void rhi_material_init(void) {
+struct RHI_Material rhi_material_init(struct RHI_Shader shader, struct RHI_Texture texture) {
 	struct Memory_Arena * scratch = thread_ctx_get_scratch();
 	u64 const scratch_position = memory_arena_get_position(scratch);
+	struct RHI_Material ret = {0};
 
 	VkDescriptorSetLayout * set_layouts = MemoryArenaPushArray(scratch, VkDescriptorSetLayout, fl_rhi_swapchain.frames_count);
 	for (uint32_t i = 0; i < fl_rhi_swapchain.frames_count; i++)
-		set_layouts[i] = fl_rhi_ud.shader.descriptor.layout;
+		set_layouts[i] = shader.descriptor.layout;
 
-	fl_rhi_ud.material.handles = os_memory_heap(NULL, sizeof(*fl_rhi_ud.material.handles) * fl_rhi_swapchain.frames_count);
+	ret.handles = os_memory_heap(NULL, sizeof(*ret.handles) * fl_rhi_swapchain.frames_count);
 	vkAllocateDescriptorSets(
 		fl_rhi_context.logical.handle,
 		&(VkDescriptorSetAllocateInfo){
 			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-			.descriptorPool = fl_rhi_ud.shader.descriptor.pool,
+			.descriptorPool = shader.descriptor.pool,
 			.descriptorSetCount = fl_rhi_swapchain.frames_count, .pSetLayouts = set_layouts,
 		},
-		fl_rhi_ud.material.handles
+		ret.handles
 	);
 
 	size_t const uniform_buffer_align = fl_rhi_context.physical.properties.limits.minUniformBufferOffsetAlignment;
 	size_t const udata_entry_stride = align_size(sizeof(struct UData), uniform_buffer_align);
 	size_t const udata_total_size = udata_entry_stride * fl_rhi_swapchain.frames_count;
-	fl_rhi_ud.material.data = rhi_buffer_create(
+	ret.data = rhi_buffer_create(
 		udata_total_size,
 		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 		// can be mapped                      and memory copied "immediately"
@@ -2356,10 +2399,10 @@ void rhi_material_init(void) {
 	);
 
 	void * target;
-	vkMapMemory(fl_rhi_context.logical.handle, fl_rhi_ud.material.data.memory, 0, udata_total_size, 0, &target);
-	fl_rhi_ud.material.map = os_memory_heap(NULL, sizeof(*fl_rhi_ud.material.map) * fl_rhi_swapchain.frames_count);
+	vkMapMemory(fl_rhi_context.logical.handle, ret.data.memory, 0, udata_total_size, 0, &target);
+	ret.map = os_memory_heap(NULL, sizeof(*ret.map) * fl_rhi_swapchain.frames_count);
 	for (uint32_t i = 0; i < fl_rhi_swapchain.frames_count; i++)
-		fl_rhi_ud.material.map[i] = (u8 *)target + udata_entry_stride * i;
+		ret.map[i] = (u8 *)target + udata_entry_stride * i;
 
 	// @note see the corresponding shader for uniforms and stuff
 	// although CPU side needs to provide sizes or references
@@ -2369,23 +2412,23 @@ void rhi_material_init(void) {
 			2, (VkWriteDescriptorSet[]){
 				{
 					.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-					.dstSet = fl_rhi_ud.material.handles[i],
+					.dstSet = ret.handles[i],
 					.dstBinding = 0,
 					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
 					.descriptorCount = 1, .pBufferInfo = &(VkDescriptorBufferInfo){
-						.buffer = fl_rhi_ud.material.data.handle,
+						.buffer = ret.data.handle,
 						.offset = udata_entry_stride * i,
 						.range = sizeof(struct UData),
 					},
 				},
 				{
 					.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-					.dstSet = fl_rhi_ud.material.handles[i],
+					.dstSet = ret.handles[i],
 					.dstBinding = 1,
 					.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
 					.descriptorCount = 1, .pImageInfo = &(VkDescriptorImageInfo){
 						.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-						.imageView = fl_rhi_ud.texture.view,
+						.imageView = texture.view,
 						.sampler = fl_rhi_ud.sampler,
 					},
 				},
@@ -2395,39 +2438,118 @@ void rhi_material_init(void) {
 		);
 
 	memory_arena_set_position(scratch, scratch_position);
+	return ret;
 }
 
 AttrFileLocal()
-void rhi_material_free(void) {
-	vkUnmapMemory(fl_rhi_context.logical.handle, fl_rhi_ud.material.data.memory);
-	os_memory_heap(fl_rhi_ud.material.map, 0);
-	rhi_buffer_destroy(fl_rhi_ud.material.data);
+void rhi_material_free(struct RHI_Material material, struct RHI_Shader shader) {
+	vkUnmapMemory(fl_rhi_context.logical.handle, material.data.memory);
+	os_memory_heap(material.map, 0);
+	rhi_buffer_destroy(material.data);
 	// @note: make sure the pool was created with `VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT`
-	vkFreeDescriptorSets(fl_rhi_context.logical.handle, fl_rhi_ud.shader.descriptor.pool, fl_rhi_swapchain.frames_count, fl_rhi_ud.material.handles);
-	os_memory_heap(fl_rhi_ud.material.handles, 0);
+	vkFreeDescriptorSets(fl_rhi_context.logical.handle, shader.descriptor.pool, fl_rhi_swapchain.frames_count, material.handles);
+	os_memory_heap(material.handles, 0);
 }
 
 // ---- ---- ---- ----
 // model / USER DATA
 // ---- ---- ---- ----
 
+// @note bump on any change to the processing or the layout below
+#define RHI_MODEL_CACHE_VERSION 2
+
+// @note followed by packed vertices, then by indices
+struct RHI_Model_Cache {
+	vec3 position_offset;
+	vec3 position_scale;
+	u32  vertices_count;
+	u32  indices_count;
+	u32  index_size;
+};
+
 AttrFileLocal()
-void rhi_model_init(void) {
+arr8 rhi_model_process(struct Memory_Arena * scratch, char const * name) {
+	struct RMVertex * vertices; u32 vertices_count;
+	void           * indices;  u32 indices_count; u32 index_size;
+
+	struct Resource_Model * file_parsed = resource_model_init(name);
+	resource_model_dump_vertices(file_parsed, scratch, &vertices, &vertices_count, &indices, &indices_count, &index_size);
+	resource_model_free(file_parsed);
+	if (indices_count == 0)
+		return (arr8){0};
+
+	struct RHI_Model_Cache header = {
+		.vertices_count = vertices_count,
+		.indices_count  = indices_count,
+		.index_size     = index_size,
+	};
+	size_t const vertices_size = sizeof(struct RMVertex_Packed) * vertices_count;
+	size_t const indices_size  = (size_t)index_size * indices_count;
+	arr8 ret = {.count = sizeof(header) + vertices_size + indices_size};
+	ret.capacity = ret.count;
+	ret.buffer = MemoryArenaPushArray(scratch, u8, ret.capacity);
+
+	// @note quantized attributes halve vertex memory and fetch bandwidth,
+	// positions are decoded by the model matrix
+	struct RMVertex_Packed * vertices_packed = MemoryArenaPushArray(scratch, struct RMVertex_Packed, vertices_count);
+	resource_model_pack_vertices(vertices_count, vertices, vertices_packed, &header.position_offset, &header.position_scale);
+
+	mem_copy(&header,         ret.buffer,                                  sizeof(header));
+	mem_copy(vertices_packed, ret.buffer + sizeof(header),                 vertices_size);
+	mem_copy(indices,         ret.buffer + sizeof(header) + vertices_size, indices_size);
+	return ret;
+}
+
+AttrFileLocal()
+struct RHI_Model rhi_model_init(void) {
 	struct Memory_Arena * scratch = thread_ctx_get_scratch();
 	u64 const scratch_position = memory_arena_get_position(scratch);
 
-	struct RMVertex * vertices; u32 vertices_count;
-	u16            * indices;  u16 indices_count;
+	// @note a cache hit skips parsing, deduplication and packing altogether;
+	// the parser splits the whole text across workers, so only the key is streamed
+	char const * name = "viking_room.obj";
+	struct File_Stream source = vfs_stream(scratch, name);
+	u64 const cache_key = asset_cache_get_key("model", RHI_MODEL_CACHE_VERSION, name, &source);
+	file_stream_free(&source);
+	arr8 processed = asset_cache_read(scratch, cache_key);
+	if (processed.count < sizeof(struct RHI_Model_Cache)) {
+		processed = rhi_model_process(scratch, name);
+		if (processed.count > 0)
+			asset_cache_write(cache_key, processed);
+	}
 
-	struct Resource_Model * file_parsed = resource_model_init("../data/viking_room.obj"); // @todo fix path
-	resource_model_dump_vertices(file_parsed, scratch, &vertices, &vertices_count, &indices, &indices_count);
-	resource_model_free(file_parsed);
+	struct RHI_Model_Cache header = {0};
+	if (processed.count >= sizeof(header))
+		mem_copy(processed.buffer, &header, sizeof(header));
+	u8 const * vertices_packed = processed.buffer + sizeof(header);
+	u8 const * indices = vertices_packed + sizeof(struct RMVertex_Packed) * header.vertices_count;
+	u32 const vertices_count = header.vertices_count;
+	u32 const indices_count  = header.indices_count;
+	size_t const vertices_size = sizeof(struct RMVertex_Packed) * vertices_count;
+	size_t const indices_size  = (size_t)header.index_size * indices_count;
+	// @note `fullDrawIndexUint32` is optional, the guaranteed range is 24 bits
+	bool const valid = indices_count > 0
+		&& processed.count == sizeof(header) + vertices_size + indices_size
+		&& vertices_count - 1 <= fl_rhi_context.physical.properties.limits.maxDrawIndexedIndexValue;
+	if (!valid) {
+		fmt_print("[RHI] model \"%s\" is missing, malformed or too large\n", name);
+		memory_arena_set_position(scratch, scratch_position);
+		return (struct RHI_Model){0};
+	}
 
-	VkDeviceSize const total_size = sizeof(*vertices) * vertices_count + sizeof(*indices) * indices_count;
-	fl_rhi_ud.model.vertex_offset = 0;
-	fl_rhi_ud.model.index_offset  = sizeof(*vertices) * vertices_count;
-	fl_rhi_ud.model.index_count = indices_count;
-	fl_rhi_ud.model.index_type  = VK_INDEX_TYPE_UINT16;
+	// @note 16 bit indices halve index fetch, the wide ones are for models beyond that
+	VkDeviceSize const total_size = vertices_size + indices_size;
+	struct RHI_Model ret = {
+		.vertex_offset  = 0,
+		.index_offset   = vertices_size,
+		.index_count    = indices_count,
+		.index_type     = (header.index_size == sizeof(u32)) ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16,
+		.dequantization = mat4_transformation(header.position_offset, quat_i, header.position_scale),
+		.bounds = {
+			.min = header.position_offset,
+			.max = vec3_add(header.position_offset, header.position_scale),
+		},
+	};
 
 	// @todo might be better to use a common allocator for this
 	struct RHI_Buffer const staging_buffer = rhi_buffer_create(
@@ -2439,41 +2561,101 @@ void rhi_model_init(void) {
 
 	void * target;
 	vkMapMemory(fl_rhi_context.logical.handle, staging_buffer.memory, 0, total_size, 0, &target);
-	mem_copy(vertices, target, sizeof(*vertices) * vertices_count); target = (u8*)target + sizeof(*vertices) * vertices_count;
-	mem_copy(indices,  target, sizeof(*indices)  * indices_count);  target = (u8*)target + sizeof(*indices)  * indices_count;
+	mem_copy(vertices_packed, target, vertices_size); target = (u8*)target + vertices_size;
+	mem_copy(indices,         target, indices_size);  target = (u8*)target + indices_size;
 	vkUnmapMemory(fl_rhi_context.logical.handle, staging_buffer.memory);
 
-	fl_rhi_ud.model.data = rhi_buffer_create(
+	ret.data = rhi_buffer_create(
 		total_size,
 		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
 	);
 
-	rhi_buffer_copy(staging_buffer.handle, fl_rhi_ud.model.data.handle, total_size);
+	rhi_buffer_copy(staging_buffer.handle, ret.data.handle, total_size);
 
 	rhi_buffer_destroy(staging_buffer);
 
 	memory_arena_set_position(scratch, scratch_position);
+	return ret;
 }
 
 AttrFileLocal()
-void rhi_model_free(void) {
-	rhi_buffer_destroy(fl_rhi_ud.model.data);
+void rhi_model_free(struct RHI_Model model) {
+	rhi_buffer_destroy(model.data);
 }
 
 // ---- ---- ---- ----
 // texture / USER DATA
 // ---- ---- ---- ----
 
+// @note bump on any change to the decoding or the layout below
+#define RHI_TEXTURE_CACHE_VERSION 1
+
+// @note followed by pixels
+struct RHI_Texture_Cache {
+	uvec2 size;
+	u32   scalar_size;
+	u32   channels;
+};
+
+AttrFileLocal()
+arr8 rhi_texture_process(struct Memory_Arena * scratch, char const * name) {
+	struct File_Stream source = vfs_stream(scratch, name);
+	struct Resource_Image file_parsed = resource_image_init_stream(&source);
+	file_stream_free(&source);
+
+	struct RHI_Texture_Cache const header = {
+		.size        = file_parsed.size,
+		.scalar_size = (u32)file_parsed.scalar_size,
+		.channels    = file_parsed.channels,
+	};
+	size_t const pixels_size = file_parsed.buffer != NULL
+		? file_parsed.scalar_size * file_parsed.size.x * file_parsed.size.y * file_parsed.channels
+		: 0;
+	if (pixels_size == 0) {
+		resource_image_free(&file_parsed);
+		return (arr8){0};
+	}
+
+	arr8 ret = {.count = sizeof(header) + pixels_size};
+	ret.capacity = ret.count;
+	ret.buffer = MemoryArenaPushArray(scratch, u8, ret.capacity);
+	mem_copy(&header,            ret.buffer,                  sizeof(header));
+	mem_copy(file_parsed.buffer, ret.buffer + sizeof(header), pixels_size);
+
+	resource_image_free(&file_parsed);
+	return ret;
+}
+
 AttrFileLocal()
-void rhi_texture_init(void) {
+struct RHI_Texture rhi_texture_init(void) {
 	struct Memory_Arena * scratch = thread_ctx_get_scratch();
 	u64 const scratch_position = memory_arena_get_position(scratch);
 
-	arr8 const file_bytes = base_file_read(scratch, "../data/viking_room.png"); // @todo fix path
-	struct Resource_Image file_parsed = resource_image_init(file_bytes);
+	// @note a cache hit skips decoding; mipmaps are generated by the device either way;
+	// the key and the decoder both consume the source as it streams in
+	char const * name = "viking_room.png";
+	struct File_Stream source = vfs_stream(scratch, name);
+	u64 const cache_key = asset_cache_get_key("texture", RHI_TEXTURE_CACHE_VERSION, name, &source);
+	file_stream_free(&source);
+	arr8 processed = asset_cache_read(scratch, cache_key);
+	if (processed.count < sizeof(struct RHI_Texture_Cache)) {
+		processed = rhi_texture_process(scratch, name);
+		if (processed.count > 0)
+			asset_cache_write(cache_key, processed);
+	}
 
-	VkDeviceSize const total_size = file_parsed.scalar_size * file_parsed.size.x * file_parsed.size.y * file_parsed.channels;
+	struct RHI_Texture_Cache file_parsed = {0};
+	if (processed.count >= sizeof(file_parsed))
+		mem_copy(processed.buffer, &file_parsed, sizeof(file_parsed));
+	u8 const * pixels = processed.buffer + sizeof(file_parsed);
+
+	VkDeviceSize const total_size = (VkDeviceSize)file_parsed.scalar_size * file_parsed.size.x * file_parsed.size.y * file_parsed.channels;
+	if (total_size == 0 || processed.count != sizeof(file_parsed) + total_size) {
+		fmt_print("[RHI] texture \"%s\" is missing or malformed\n", name);
+		memory_arena_set_position(scratch, scratch_position);
+		return (struct RHI_Texture){0};
+	}
 	VkFormat const primitive = rhi_map_vector_format_to_primitive_format(fl_rhi_context.physical.surface_format.format);
 	VkFormat const format = rhi_map_primitive_format_to_vector_format(primitive, file_parsed.channels);
 
@@ -2487,36 +2669,89 @@ void rhi_texture_init(void) {
 
 	void * target;
 	vkMapMemory(fl_rhi_context.logical.handle, staging_buffer.memory, 0, total_size, 0, &target);
-	mem_copy(file_parsed.buffer, target, total_size);
+	mem_copy(pixels, target, total_size);
 	vkUnmapMemory(fl_rhi_context.logical.handle, staging_buffer.memory);
 
 	u32 const extra_mip_levels = (u32)log2_32((f32)max_u32(file_parsed.size.x, file_parsed.size.y));
-	fl_rhi_ud.texture = rhi_texture_create(
+	struct RHI_Texture const ret = rhi_texture_create(
 		file_parsed.size, format, extra_mip_levels, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_TILING_OPTIMAL,
 		VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
 		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
 	);
 
-	rhi_texture_transition(fl_rhi_ud.texture.handle, format, extra_mip_levels,
+	rhi_texture_transition(ret.handle, format, extra_mip_levels,
 		VK_IMAGE_LAYOUT_UNDEFINED,
 		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
 	);
-	rhi_texture_upload(fl_rhi_ud.texture.handle, staging_buffer.handle, file_parsed.size, format);
-	if (extra_mip_levels == 0 || !rhi_texture_generate_mipmaps(fl_rhi_ud.texture.handle, format, extra_mip_levels, file_parsed.size))
-		rhi_texture_transition(fl_rhi_ud.texture.handle, format, extra_mip_levels,
+	rhi_texture_upload(ret.handle, staging_buffer.handle, file_parsed.size, format);
+	if (extra_mip_levels == 0 || !rhi_texture_generate_mipmaps(ret.handle, format, extra_mip_levels, file_parsed.size))
+		rhi_texture_transition(ret.handle, format, extra_mip_levels,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
 		);
 
 	rhi_buffer_destroy(staging_buffer);
 
-	resource_image_free(&file_parsed);
 	memory_arena_set_position(scratch, scratch_position);
+	return ret;
 }
 
+// ---- ---- ---- ----
+// reload / USER DATA
+// ---- ---- ---- ----
+
+#define RHI_RELOAD_DELAY_SECONDS 0.25
+
+// @note everything the renderer loads from the VFS
 AttrFileLocal()
-void rhi_texture_free(void) {
-	rhi_texture_destroy(fl_rhi_ud.texture);
+char const * const fl_rhi_assets[] = {
+	"viking_room.obj", "viking_room.png",
+	"shader.vert.spv", "shader.frag.spv",
+};
+
+AttrFileLocal()
+bool rhi_reload_is_asset(str8 name, str8 asset) {
+	return name.count == asset.count && mem_equals(name.buffer, asset.buffer, asset.count);
+}
+
+AttrFileLocal()
+void rhi_reload_tick(void) {
+	struct RHI_Reload const reload = fl_rhi_ud.reload;
+	if (!reload.shader && !reload.texture && !reload.model)
+		return;
+	if (os_timer_get_nanos() < reload.nanos)
+		return;
+	fl_rhi_ud.reload = (struct RHI_Reload){0};
+
+	// @note new resources are built alongside the current ones, which stay on failure
+	struct RHI_Model   const model   = reload.model   ? rhi_model_init()   : (struct RHI_Model){0};
+	struct RHI_Texture const texture = reload.texture ? rhi_texture_init() : (struct RHI_Texture){0};
+	struct RHI_Shader  const shader  = reload.shader  ? rhi_shader_init()  : (struct RHI_Shader){0};
+	bool const model_ok   = model.data.handle != VK_NULL_HANDLE;
+	bool const texture_ok = texture.handle    != VK_NULL_HANDLE;
+	bool const shader_ok  = shader.handle     != VK_NULL_HANDLE;
+	if (!model_ok && !texture_ok && !shader_ok)
+		return;
+
+	// @note in-flight frames still use the current ones; reloads are rare enough to wait for
+	vkDeviceWaitIdle(fl_rhi_context.logical.handle);
+
+	// @note descriptor sets depend on both the shader and the texture
+	bool const material = shader_ok || texture_ok;
+	if (material) rhi_material_free(fl_rhi_ud.material, fl_rhi_ud.shader);
+	if (model_ok) {
+		rhi_model_free(fl_rhi_ud.model);
+		fl_rhi_ud.model = model;
+	}
+	if (texture_ok) {
+		rhi_texture_destroy(fl_rhi_ud.texture);
+		fl_rhi_ud.texture = texture;
+	}
+	if (shader_ok) {
+		rhi_shader_free(fl_rhi_ud.shader);
+		fl_rhi_ud.shader = shader;
+	}
+	if (material) fl_rhi_ud.material = rhi_material_init(fl_rhi_ud.shader, fl_rhi_ud.texture);
 }
 
 // ---- ---- ---- ----
@@ -2537,26 +2772,32 @@ void rhi_init(void) {
 	fl_rhi_swapchain = rhi_swapchain_init(surface, VK_NULL_HANDLE);
 
 	// -- user data
-	rhi_model_init();
+	// @note announced upfront, so that the system fetches them all at once
+	vfs_prefetch((u32)ArrayCount(fl_rhi_assets), fl_rhi_assets);
+
+	fl_rhi_ud.model = rhi_model_init();
 	fl_rhi_ud.sampler = rhi_sampler_create();
-	rhi_texture_init();
+	fl_rhi_ud.texture = rhi_texture_init();
+	Assert(fl_rhi_ud.model.data.handle != VK_NULL_HANDLE, "[RHI] failed to load the model\n");
+	Assert(fl_rhi_ud.texture.handle    != VK_NULL_HANDLE, "[RHI] failed to load the texture\n");
 
 	// -- user data: shader and material
-	rhi_shader_init();
-	rhi_material_init();
+	fl_rhi_ud.shader = rhi_shader_init();
+	Assert(fl_rhi_ud.shader.handle != VK_NULL_HANDLE, "[RHI] failed to load the shader\n");
+	fl_rhi_ud.material = rhi_material_init(fl_rhi_ud.shader, fl_rhi_ud.texture);
 }
 
 void rhi_free(void) {
 	vkDeviceWaitIdle(fl_rhi_context.logical.handle);
 
 	// -- user data: shader and material
-	rhi_material_free();
-	rhi_shader_free();
+	rhi_material_free(fl_rhi_ud.material, fl_rhi_ud.shader);
+	rhi_shader_free(fl_rhi_ud.shader);
 
 	// -- user data
-	rhi_texture_free();
+	rhi_texture_destroy(fl_rhi_ud.texture);
 	rhi_sampler_destroy(fl_rhi_ud.sampler);
-	rhi_model_free();
+	rhi_model_free(fl_rhi_ud.model);
 
 	// -- fixed
 	rhi_swapchain_free(fl_rhi_swapchain);
@@ -2579,6 +2820,8 @@ void rhi_tick(void) {
 	if (fl_rhi_swapchain.needs_update)
 		rhi_swapchain_recreate();
 
+	rhi_reload_tick();
+
 	if (fl_rhi_swapchain.handle == VK_NULL_HANDLE)
 		return;
 
@@ -2615,6 +2858,7 @@ void rhi_tick(void) {
 	struct RHI_Frame const presentable_frame = fl_rhi_swapchain.frames[presentable_index];
 
 	// -- upload uniforms
+	u64 model_visible;
 	{
 		f32 const fov = PI32 / 3;
 		vec2 const vp_scale = vec2_muls(
@@ -2624,12 +2868,18 @@ void rhi_tick(void) {
 		u64 const rotation_period = SecondsToNanos(10);
 		f32 const rotation_offset = TAU32 * (f32)(os_timer_get_nanos() % rotation_period) / (f32)rotation_period;
 		f32 const rotation = (PI32 / 10) * cos32(rotation_offset);
+		mat4 const model = mat4_transformation(vec3_0, quat_axis(vec3_y1, rotation), vec3_1);
 		struct UData const udata = {
-			.model = mat4_transformation(vec3_0, quat_axis(vec3_y1, rotation), vec3_1),
+			.model = mat4_mul_mat(model, fl_rhi_ud.model.dequantization),
 			.view = mat4_transformation_inverse((vec3){1.2f, 1.8f, -1.2f}, quat_rotation((vec3){PI32/4, -PI32/4, 0}), vec3_1),
 			.projection = rhi_mat4_projection(vp_scale, vec2_0, 0, 0.1f, INF32),
 		};
 		mem_copy(&udata, fl_rhi_ud.material.map[current_index], sizeof(udata));
+
+		// @note bounds are in the model space, prior to quantization
+		vec4 planes[FRUSTUM_PLANES];
+		mat4_frustum_planes(mat4_mul_mat(mat4_mul_mat(udata.projection, udata.view), model), 0, 1, planes);
+		frustum_cull_aabb3(planes, 1, &fl_rhi_ud.model.bounds, &model_visible);
 	}
 
 	// -- draw: begin
@@ -2683,7 +2933,9 @@ void rhi_tick(void) {
 	// -- choose and draw mesh
 	vkCmdBindVertexBuffers(current_frame.commands, 0, 1, &fl_rhi_ud.model.data.handle, &fl_rhi_ud.model.vertex_offset);
 	vkCmdBindIndexBuffer(current_frame.commands, fl_rhi_ud.model.data.handle, fl_rhi_ud.model.index_offset, fl_rhi_ud.model.index_type);
-	vkCmdDrawIndexed(current_frame.commands, fl_rhi_ud.model.index_count, 1, 0, 0, 0);
+	if (model_visible & 1) {
+		vkCmdDrawIndexed(current_frame.commands, fl_rhi_ud.model.index_count, 1, 0, 0, 0);
+	}
 
 	// -- draw: end
 	vkCmdEndRenderPass(current_frame.commands);
@@ -2724,6 +2976,24 @@ void rhi_notify_surface_resized(void) {
 	fl_rhi_swapchain.needs_update = true;
 }
 
+u32 rhi_get_assets(char const * const ** out_names) {
+	*out_names = fl_rhi_assets;
+	return (u32)ArrayCount(fl_rhi_assets);
+}
+
+void rhi_notify_asset_changed(str8 name) {
+	bool const shader  = rhi_reload_is_asset(name, str8_lit("shader.vert.spv")) || rhi_reload_is_asset(name, str8_lit("shader.frag.spv"));
+	bool const texture = rhi_reload_is_asset(name, str8_lit("viking_room.png"));
+	bool const model   = rhi_reload_is_asset(name, str8_lit("viking_room.obj"));
+	if (!shader && !texture && !model)
+		return;
+	// @note writers touch files a few times in a row
+	fl_rhi_ud.reload.nanos    = os_timer_get_nanos() + SecondsToNanos(RHI_RELOAD_DELAY_SECONDS);
+	fl_rhi_ud.reload.shader  |= shader;
+	fl_rhi_ud.reload.texture |= texture;
+	fl_rhi_ud.reload.model   |= model;
+}
+
 mat4 rhi_mat4_projection(
 	vec2 scale_xy, vec2 offset_xy, f32 ortho,
 	f32 view_near, f32 view_far
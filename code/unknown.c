@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include "os.h"
 #include "rhi.h"
 
@@ -6,6 +8,45 @@ void main_on_resize(void) {
 	rhi_notify_surface_resized();
 }
 
+AttrFileLocal()
+void main_on_watch(struct OS_Watch * watch) {
+	if (watch == NULL)
+		return;
+	struct Memory_Arena * scratch = thread_ctx_get_scratch();
+	u64 const scratch_position = memory_arena_get_position(scratch);
+
+	struct OS_Watch_Event * events;
+	u32 const events_count = os_watch_poll(watch, scratch, &events);
+	for (u32 i = 0; i < events_count; i++) {
+		switch (events[i].action) {
+			case OS_WATCH_ACTION_ADDED:
+			case OS_WATCH_ACTION_MODIFIED:
+			case OS_WATCH_ACTION_RENAMED_TO:
+				vfs_invalidate(events[i].name);
+				rhi_notify_asset_changed(events[i].name);
+				break;
+
+			// @note the events were lost, so any of the assets might have changed
+			case OS_WATCH_ACTION_NONE: {
+				char const * const * names;
+				u32 const names_count = rhi_get_assets(&names);
+				for (u32 n = 0; n < names_count; n++) {
+					str8 const name = {
+						.count  = strlen(names[n]),
+						.buffer = (u8 *)names[n],
+					};
+					vfs_invalidate(name);
+					rhi_notify_asset_changed(name);
+				}
+			} break;
+
+			default: break;
+		}
+	}
+
+	memory_arena_set_position(scratch, scratch_position);
+}
+
 int main(int argc, char * argv[]) {
 	fmt_print("[main] args:\n");
 	for (int i = 0; i < argc; i++) {
@@ -20,8 +61,25 @@ int main(int argc, char * argv[]) {
 		.on_resize = main_on_resize,
 	});
 	thread_ctx_init();
+	workers_init();
+	struct VFS_IInfo const vfs_info = {
+		.archive = "data.pack",
+		.roots_count = 2,
+		.roots = {"data/", "../data/"},
+	};
+	vfs_init(vfs_info);
+	asset_cache_init((struct Asset_Cache_IInfo){
+		.path = "cache/",
+	});
 	rhi_init();
 
+	// @note loose files reload as they change
+	struct OS_Watch * watches[VFS_ROOTS_MAX] = {0};
+	for (u32 i = 0; i < vfs_info.roots_count; i++)
+		watches[i] = os_watch_init((struct OS_Watch_IInfo){
+			.path = vfs_info.roots[i],
+		});
+
 	u64 const nanos_fixed_delta           = SecondsToNanos(1.0 / 50.0);
 	u64 const nanos_variable_delta_limit  = SecondsToNanos(1.0 / 20.0);
 	u64 const nanos_variable_delta_target = SecondsToNanos(1.0 / 60.0);
@@ -35,6 +93,8 @@ int main(int argc, char * argv[]) {
 
 		// -- poll events
 		os_tick();
+		for (u32 i = 0; i < vfs_info.roots_count; i++)
+			main_on_watch(watches[i]);
 
 		// -- fixed timestep
 		nanos_fixed_accumulator += nanos_variable_delta;
@@ -59,7 +119,14 @@ int main(int argc, char * argv[]) {
 		nanos_variable_delta = clamp_u64(nanos_frame_delta, 1, nanos_variable_delta_limit);
 	}
 
+	for (u32 i = 0; i < vfs_info.roots_count; i++)
+		if (watches[i] != NULL)
+			os_watch_free(watches[i]);
+
 	rhi_free();
+	asset_cache_free();
+	vfs_free();
+	workers_free();
 	thread_ctx_free();
 	os_free();
 
@@ -8,9 +8,10 @@
 #if BUILD_STAGE == BUILD_STAGE_VERTEX
 #pragma shader_stage(vertex)
 
-layout(location = 0) in vec3 in_position;
-layout(location = 1) in vec2 in_texture;
-layout(location = 2) in vec3 in_normal;
+// @note `RMVertex_Packed`: bounds are folded into `u_data.model`
+layout(location = 0) in vec4 in_position; // UNORM16
+layout(location = 1) in vec2 in_texture;  // f16
+layout(location = 2) in vec2 in_normal;   // octahedral SNORM16
 
 layout(location = 0) out vec2 fragment_texture;
 layout(location = 1) out vec3 fragment_normal;
@@ -33,11 +34,19 @@ layout(binding = 0) uniform UData {
 // 	vec2 scale;
 // } u_instance;
 
+vec3 octahedral_decode(vec2 value) {
+	vec3 ret = vec3(value, 1.0 - abs(value.x) - abs(value.y));
+	float fold = max(-ret.z, 0.0);
+	ret.x += ret.x >= 0.0 ? -fold : fold;
+	ret.y += ret.y >= 0.0 ? -fold : fold;
+	return normalize(ret);
+}
+
 void main() {
 	// gl_Position = u_global.camera * u_instance.model * vec4(in_position, 0.0, 1.0);
-	gl_Position = u_data.projection * u_data.view * u_data.model * vec4(in_position, 1.0);
+	gl_Position = u_data.projection * u_data.view * u_data.model * vec4(in_position.xyz, 1.0);
 	fragment_texture = in_texture;
-	fragment_normal = in_normal;
+	fragment_normal = octahedral_decode(in_normal);
 }
 #endif
 